@@ -6,12 +6,20 @@
  *    Tobit Flatscher (github.com/2b-t)
 */
 
+#include <algorithm>
 #include <cstdint>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <optional>
 #include <string>
 #include <sstream>
 #include <tuple>
+#include <vector>
 
 #include <pybind11/chrono.h>
+#include <pybind11/eval.h>
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
@@ -25,14 +33,34 @@
 #include "myactuator_rmd/actuator_state/motor_status_2.hpp"
 #include "myactuator_rmd/actuator_state/motor_status_3.hpp"
 #include "myactuator_rmd/can/exceptions.hpp"
+#include "myactuator_rmd/can/filter.hpp"
 #include "myactuator_rmd/can/frame.hpp"
 #include "myactuator_rmd/can/node.hpp"
+#include "myactuator_rmd/control/capture.hpp"
+#include "myactuator_rmd/control/compensation.hpp"
+#include "myactuator_rmd/control/compensation_calibration.hpp"
+#include "myactuator_rmd/control/gain_tuner.hpp"
+#include "myactuator_rmd/control/safety_limits.hpp"
+#include "myactuator_rmd/control/step_response.hpp"
+#include "myactuator_rmd/control/trajectory_interpolator.hpp"
+#include "myactuator_rmd/control/trajectory_streamer.hpp"
+#include "myactuator_rmd/driver/async_driver.hpp"
+#include "myactuator_rmd/driver/bus_io_thread.hpp"
 #include "myactuator_rmd/driver/can_driver.hpp"
+#include "myactuator_rmd/driver/channel_driver.hpp"
 #include "myactuator_rmd/driver/driver.hpp"
+#include "myactuator_rmd/driver/driver_statistics.hpp"
+#include "myactuator_rmd/driver/heartbeat_driver.hpp"
+#include "myactuator_rmd/driver/multi_bus_driver.hpp"
+#include "myactuator_rmd/driver/replay_driver.hpp"
 #include "myactuator_rmd/actuator_constants.hpp"
+#include "myactuator_rmd/actuator_group.hpp"
 #include "myactuator_rmd/actuator_interface.hpp"
+#include "myactuator_rmd/async_actuator_interface.hpp"
 #include "myactuator_rmd/exceptions.hpp"
+#include "myactuator_rmd/fleet.hpp"
 #include "myactuator_rmd/io.hpp"
+#include "myactuator_rmd/thread_affinity.hpp"
 
 #include "myactuator_rmd/actuator_state/gain_type.hpp"
 
@@ -63,57 +91,682 @@ namespace myactuator_rmd {
       return;
     }
 
+
+    // Contiguous single-precision arrays are accessed without copying, other inputs are converted
+    using FloatArray = pybind11::array_t<float, pybind11::array::c_style | pybind11::array::forcecast>;
+    using OutputArray = pybind11::array_t<float, pybind11::array::c_style>;
+
+    /**\fn checkSize
+     * \brief
+     *    Helper function for checking that an array holds exactly one element per actuator of a group
+     * 
+     * \param[in] array
+     *    The array to be checked
+     * \param[in] group
+     *    The actuator group the array should correspond to
+     * \param[in] name
+     *    The name of the argument used in the error message
+    */
+    inline void checkSize(pybind11::array const& array, myactuator_rmd::ActuatorGroup const& group, std::string const& name) {
+      if ((array.ndim() != 1) || (static_cast<std::size_t>(array.size()) != group.size())) {
+        throw pybind11::value_error("Argument '" + name + "' has to be a one-dimensional array with one element per actuator (" +
+                                    std::to_string(group.size()) + ")");
+      }
+      return;
+    }
+
+
+    /**\fn toTrajectory
+     * \brief
+     *    Helper function for converting NumPy arrays of shape (samples, actuators) to a sampled trajectory
+     * 
+     * \param[in] position
+     *    The desired positions for every sample and actuator
+     * \param[in] velocity
+     *    The desired velocities for every sample and actuator, zero if not given
+     * \param[in] torque
+     *    The feedforward torques for every sample and actuator, zero if not given
+     * \param[in] kp
+     *    The position gain for every actuator, zero if not given
+     * \param[in] kd
+     *    The velocity gain for every actuator, zero if not given
+     * \param[in] max_speed
+     *    The maximum speed of position set-points for every actuator, 500 dps if not given
+     * \return
+     *    The sampled trajectory
+    */
+    inline myactuator_rmd::SampledTrajectory toTrajectory(FloatArray const& position, std::optional<FloatArray> const& velocity,
+                                                          std::optional<FloatArray> const& torque, std::optional<FloatArray> const& kp,
+                                                          std::optional<FloatArray> const& kd, std::optional<FloatArray> const& max_speed) {
+      if (position.ndim() != 2) {
+        throw pybind11::value_error("Argument 'position' has to be a two-dimensional array of shape (samples, actuators)");
+      }
+      auto const num_samples {static_cast<std::size_t>(position.shape(0))};
+      auto const num_actuators {static_cast<std::size_t>(position.shape(1))};
+      myactuator_rmd::SampledTrajectory trajectory {num_samples, num_actuators};
+      auto const copy = [](std::optional<FloatArray> const& from, std::vector<float>& to, std::string const& name) {
+        if (!from) {
+          return;
+        }
+        if (static_cast<std::size_t>(from->size()) != to.size()) {
+          throw pybind11::value_error("Argument '" + name + "' does not match the shape of the trajectory");
+        }
+        std::copy(from->data(), from->data() + to.size(), to.begin());
+        return;
+      };
+      copy(position, trajectory.position, "position");
+      copy(velocity, trajectory.velocity, "velocity");
+      copy(torque, trajectory.torque, "torque");
+      copy(kp, trajectory.kp, "kp");
+      copy(kd, trajectory.kd, "kd");
+      copy(max_speed, trajectory.max_speed, "max_speed");
+      return trajectory;
+    }
+
+
+    /**\class AsyncResult
+     * \brief
+     *    Result of an asynchronous request handed from the completion thread to the event loop. Exceptions
+     *    are only rethrown inside the event loop so that they are translated to the registered Python types.
+    */
+    class AsyncResult {
+      public:
+        AsyncResult(pybind11::object const& value, std::exception_ptr error)
+        : value_{value}, error_{error} {
+          return;
+        }
+
+        pybind11::object get() const {
+          if (error_) {
+            std::rethrow_exception(error_);
+          }
+          return value_;
+        }
+
+      protected:
+        pybind11::object value_;
+        std::exception_ptr error_;
+    };
+
+    /**\class PendingFuture
+     * \brief
+     *    An asyncio future of the running event loop that is resolved from the completion thread
+    */
+    class PendingFuture {
+      public:
+        PendingFuture()
+        : loop_{pybind11::module_::import("asyncio").attr("get_running_loop")()},
+          future_{loop_.attr("create_future")()} {
+          return;
+        }
+
+        ~PendingFuture() {
+          if (future_) {
+            pybind11::gil_scoped_acquire const acquire {};
+            future_ = pybind11::object();
+            loop_ = pybind11::object();
+          }
+          return;
+        }
+
+        /**\fn getAwaitable
+         * \brief
+         *    Get the coroutine awaiting the future and returning its result
+        */
+        pybind11::object getAwaitable() const {
+          return pybind11::module_::import("myactuator_rmd_py").attr("_resolve")(future_);
+        }
+
+        /**\fn complete
+         * \brief
+         *    Hand the result to the event loop, called from the completion thread without the GIL
+        */
+        template <typename T>
+        void complete(T const& result, std::exception_ptr error) {
+          pybind11::gil_scoped_acquire const acquire {};
+          try {
+            pybind11::object const value {error ? pybind11::none() : pybind11::cast(result)};
+            loop_.attr("call_soon_threadsafe")(pybind11::module_::import("myactuator_rmd_py").attr("_complete"),
+                                               future_, AsyncResult{value, error});
+          } catch (pybind11::error_already_set const&) {
+            // The event loop was closed in the meantime, nobody is waiting for the result anymore
+          }
+          future_ = pybind11::object();
+          loop_ = pybind11::object();
+          return;
+        }
+
+      protected:
+        pybind11::object loop_;
+        pybind11::object future_;
+    };
+
+    /**\fn awaitable
+     * \brief
+     *    Helper function for turning a non-blocking request into a Python awaitable
+     *
+     * \tparam T
+     *    The type of the result of the request
+     * \param[in] request
+     *    Function that queues the request with the given completion
+     * \return
+     *    The awaitable returning the result of the request
+    */
+    template <typename T, typename F>
+    pybind11::object awaitable(F const& request) {
+      auto const future {std::make_shared<PendingFuture>()};
+      request(myactuator_rmd::Completion<T>{[future](T const& result, std::exception_ptr error) {
+        future->complete(result, error);
+        return;
+      }});
+      return future->getAwaitable();
+    }
+
+    /**\fn statusAwaitable
+     * \brief
+     *    Helper function for turning a non-blocking command without result into a Python awaitable
+     *
+     * \param[in] request
+     *    Function that queues the command with the given completion
+     * \return
+     *    The awaitable returning None once the command was acknowledged
+    */
+    template <typename F>
+    pybind11::object statusAwaitable(F const& request) {
+      auto const future {std::make_shared<PendingFuture>()};
+      request(myactuator_rmd::StatusCompletion{[future](std::exception_ptr error) {
+        future->complete(pybind11::none(), error);
+        return;
+      }});
+      return future->getAwaitable();
+    }
+
+    /**\fn AsyncDriverDeleter
+     * \brief
+     *    Releases the GIL while the asynchronous driver joins its completion thread, which might be waiting
+     *    for the GIL in order to resolve a future
+    */
+    struct AsyncDriverDeleter {
+      void operator () (myactuator_rmd::AsyncDriver* driver) const {
+        pybind11::gil_scoped_release const release {};
+        delete driver;
+        return;
+      }
+    };
+
   }
 }
 
 PYBIND11_MODULE(myactuator_rmd_py, m) {
 
   m.doc() = "Python bindings for MyActuator RMD-X actuator series";
-  pybind11::class_<myactuator_rmd::Driver>(m, "Driver");
+  pybind11::class_<myactuator_rmd::DriverStatistics>(m, "DriverStatistics")
+    .def_readonly("num_sent_frames", &myactuator_rmd::DriverStatistics::num_sent_frames)
+    .def_readonly("num_received_frames", &myactuator_rmd::DriverStatistics::num_received_frames)
+    .def_readonly("num_dropped_frames", &myactuator_rmd::DriverStatistics::num_dropped_frames)
+    .def_readonly("num_syscalls", &myactuator_rmd::DriverStatistics::num_syscalls)
+    .def_readonly("num_stale_frames", &myactuator_rmd::DriverStatistics::num_stale_frames)
+    .def_readonly("num_retries", &myactuator_rmd::DriverStatistics::num_retries)
+    .def_readonly("num_timeouts", &myactuator_rmd::DriverStatistics::num_timeouts)
+    .def_readonly("command_skew", &myactuator_rmd::DriverStatistics::command_skew)
+    .def_readonly("max_command_skew", &myactuator_rmd::DriverStatistics::max_command_skew);
+  pybind11::class_<myactuator_rmd::Driver>(m, "Driver")
+    .def("getStatistics", &myactuator_rmd::Driver::getStatistics);
   pybind11::class_<myactuator_rmd::CanDriver, myactuator_rmd::Driver>(m, "CanDriver")
-    .def(pybind11::init<std::string const&>());
+    .def(pybind11::init<std::string const&>())
+    .def("setRecvBufferSize", [](myactuator_rmd::CanDriver& driver, int const size) { driver.setRecvBufferSize(size); })
+    .def("setSendBufferSize", [](myactuator_rmd::CanDriver& driver, int const size) { driver.setSendBufferSize(size); })
+    .def("getRecvBufferSize", [](myactuator_rmd::CanDriver const& driver) { return driver.getRecvBufferSize(); })
+    .def("getSendBufferSize", [](myactuator_rmd::CanDriver const& driver) { return driver.getSendBufferSize(); })
+    .def("setBusyPoll", [](myactuator_rmd::CanDriver& driver, std::chrono::microseconds const& spin_budget) { driver.setBusyPoll(spin_budget); })
+    .def("setKernelBusyPoll", [](myactuator_rmd::CanDriver& driver, std::chrono::microseconds const& busy_poll) { driver.setKernelBusyPoll(busy_poll); })
+    .def("setIoBackend", [](myactuator_rmd::CanDriver& driver, myactuator_rmd::can::IoBackend const backend) { return driver.setIoBackend(backend); })
+    .def("getIoBackend", [](myactuator_rmd::CanDriver const& driver) { return driver.getIoBackend(); })
+    .def("setTimestamping", [](myactuator_rmd::CanDriver& driver, bool const is_enabled) { driver.setTimestamping(is_enabled); })
+    .def("setMaxRetries", [](myactuator_rmd::CanDriver& driver, std::size_t const max_retries) { driver.setMaxRetries(max_retries); });
+  m.def("setThreadAffinity", &myactuator_rmd::setThreadAffinity);
+  m.def("setThreadPriority", &myactuator_rmd::setThreadPriority);
+  pybind11::class_<myactuator_rmd::BusIoThread>(m, "BusIoThread")
+    .def(pybind11::init<myactuator_rmd::Driver&, std::chrono::microseconds const&, std::size_t const>(),
+         pybind11::arg("driver"), pybind11::arg("idle_period") = std::chrono::microseconds(50), pybind11::arg("max_batch_size") = 32,
+         pybind11::keep_alive<1,2>())
+    .def("isRunning", &myactuator_rmd::BusIoThread::isRunning);
+  pybind11::class_<myactuator_rmd::ChannelDriver, myactuator_rmd::Driver>(m, "ChannelDriver")
+    .def(pybind11::init<myactuator_rmd::BusIoThread&>(), pybind11::keep_alive<1,2>());
+  pybind11::class_<myactuator_rmd::HeartbeatDriver, myactuator_rmd::Driver>(m, "HeartbeatDriver")
+    .def(pybind11::init<myactuator_rmd::Driver&, std::chrono::microseconds const&, int const>(),
+         pybind11::arg("driver"), pybind11::arg("period"), pybind11::arg("priority") = 0, pybind11::keep_alive<1,2>())
+    .def("getNumHeartbeats", &myactuator_rmd::HeartbeatDriver::getNumHeartbeats)
+    .def("getNumFailedHeartbeats", &myactuator_rmd::HeartbeatDriver::getNumFailedHeartbeats);
+  pybind11::class_<myactuator_rmd::MultiBusDriver, myactuator_rmd::Driver>(m, "MultiBusDriver")
+    .def(pybind11::init<std::vector<std::string> const&>())
+    .def_static("getHandle", &myactuator_rmd::MultiBusDriver::getHandle)
+    .def("getNumBuses", &myactuator_rmd::MultiBusDriver::getNumBuses);
+  pybind11::enum_<myactuator_rmd::ReplayMode>(m, "ReplayMode")
+    .value("ORIGINAL_TIMING", myactuator_rmd::ReplayMode::ORIGINAL_TIMING)
+    .value("AS_FAST_AS_POSSIBLE", myactuator_rmd::ReplayMode::AS_FAST_AS_POSSIBLE);
+  pybind11::class_<myactuator_rmd::RecordedFrame>(m, "RecordedFrame")
+    .def(pybind11::init<std::chrono::microseconds const&, myactuator_rmd::can::Frame const&>())
+    .def_readonly("timestamp", &myactuator_rmd::RecordedFrame::timestamp)
+    .def_readonly("frame", &myactuator_rmd::RecordedFrame::frame);
+  pybind11::class_<myactuator_rmd::ReplayDriver, myactuator_rmd::Driver>(m, "ReplayDriver")
+    .def(pybind11::init<std::vector<myactuator_rmd::RecordedFrame> const&, myactuator_rmd::ReplayMode const>(),
+         pybind11::arg("frames"), pybind11::arg("mode") = myactuator_rmd::ReplayMode::AS_FAST_AS_POSSIBLE)
+    .def("getRemaining", &myactuator_rmd::ReplayDriver::getRemaining);
+  m.def("readCandumpLog", pybind11::overload_cast<std::string const&>(&myactuator_rmd::readCandumpLog));
+  m.def("readBinaryLog", pybind11::overload_cast<std::string const&>(&myactuator_rmd::readBinaryLog));
+  pybind11::class_<myactuator_rmd::ActuatorInfo>(m, "ActuatorInfo")
+    .def_readonly("actuator_id", &myactuator_rmd::ActuatorInfo::actuator_id)
+    .def_readonly("motor_model", &myactuator_rmd::ActuatorInfo::motor_model)
+    .def_readonly("version_date", &myactuator_rmd::ActuatorInfo::version_date)
+    .def_readonly("gains", &myactuator_rmd::ActuatorInfo::gains)
+    .def_readonly("acceleration", &myactuator_rmd::ActuatorInfo::acceleration);
+  m.def("discoverActuators", &myactuator_rmd::discoverActuators, pybind11::arg("driver"),
+        pybind11::arg("timeout") = std::chrono::milliseconds(20), pybind11::arg("actuator_ids") = std::vector<std::uint32_t>{},
+        pybind11::call_guard<pybind11::gil_scoped_release>());
+  m.def("getAllGains", &myactuator_rmd::getAllGains, pybind11::arg("driver"), pybind11::arg("actuator_ids"),
+        pybind11::arg("timeout") = std::chrono::milliseconds(20), pybind11::call_guard<pybind11::gil_scoped_release>());
+  pybind11::class_<myactuator_rmd::FleetConfiguration>(m, "FleetConfiguration")
+    .def(pybind11::init<>())
+    .def("setAcceleration", &myactuator_rmd::FleetConfiguration::setAcceleration, pybind11::return_value_policy::reference_internal)
+    .def("setControllerGains", &myactuator_rmd::FleetConfiguration::setControllerGains, pybind11::arg("actuator_id"),
+         pybind11::arg("gains"), pybind11::arg("is_persistent") = false, pybind11::return_value_policy::reference_internal)
+    .def("setAllGains", &myactuator_rmd::FleetConfiguration::setAllGains, pybind11::arg("actuator_id"),
+         pybind11::arg("gains"), pybind11::arg("is_persistent") = false, pybind11::return_value_policy::reference_internal)
+    .def("setTimeout", &myactuator_rmd::FleetConfiguration::setTimeout, pybind11::return_value_policy::reference_internal)
+    .def("size", &myactuator_rmd::FleetConfiguration::size)
+    .def("apply", &myactuator_rmd::FleetConfiguration::apply, pybind11::arg("driver"),
+         pybind11::arg("timeout") = std::chrono::milliseconds(20), pybind11::call_guard<pybind11::gil_scoped_release>());
   pybind11::class_<myactuator_rmd::ActuatorInterface>(m, "ActuatorInterface")
     .def(pybind11::init<myactuator_rmd::Driver&, std::uint32_t>())
-    .def("getAcceleration", &myactuator_rmd::ActuatorInterface::getAcceleration)
-    .def("getCanId", &myactuator_rmd::ActuatorInterface::getCanId)
-    .def("getControllerGains", &myactuator_rmd::ActuatorInterface::getControllerGains)
+    .def("getAcceleration", &myactuator_rmd::ActuatorInterface::getAcceleration, pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("getCanId", &myactuator_rmd::ActuatorInterface::getCanId, pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("getControllerGains", &myactuator_rmd::ActuatorInterface::getControllerGains, pybind11::call_guard<pybind11::gil_scoped_release>())
     // --- edit ---
-    .def("getSingleGain", &myactuator_rmd::ActuatorInterface::getSingleGain)
-    .def("setSingleGain", &myactuator_rmd::ActuatorInterface::setSingleGain)
-    .def("setSingleGainPersistently", &myactuator_rmd::ActuatorInterface::setSingleGainPersistently)
-    .def("functionControl", &myactuator_rmd::ActuatorInterface::functionControl)
-    .def("motionControl", &myactuator_rmd::ActuatorInterface::motionControl)
+    .def("getSingleGain", &myactuator_rmd::ActuatorInterface::getSingleGain, pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("setSingleGain", &myactuator_rmd::ActuatorInterface::setSingleGain, pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("setSingleGainPersistently", &myactuator_rmd::ActuatorInterface::setSingleGainPersistently, pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("getAllGains", &myactuator_rmd::ActuatorInterface::getAllGains, pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("setAllGains", &myactuator_rmd::ActuatorInterface::setAllGains, pybind11::arg("gains"), pybind11::arg("is_persistent") = false,
+         pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("functionControl", &myactuator_rmd::ActuatorInterface::functionControl, pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("motionControl", &myactuator_rmd::ActuatorInterface::motionControl, pybind11::call_guard<pybind11::gil_scoped_release>())
     // ---------------------
-    .def("getControlMode", &myactuator_rmd::ActuatorInterface::getControlMode)
-    .def("getMotorModel", &myactuator_rmd::ActuatorInterface::getMotorModel)
-    .def("getMotorPower", &myactuator_rmd::ActuatorInterface::getMotorPower)
-    .def("getMotorStatus1", &myactuator_rmd::ActuatorInterface::getMotorStatus1)
-    .def("getMotorStatus2", &myactuator_rmd::ActuatorInterface::getMotorStatus2)
-    .def("getMotorStatus3", &myactuator_rmd::ActuatorInterface::getMotorStatus3)
-    .def("getMultiTurnAngle", &myactuator_rmd::ActuatorInterface::getMultiTurnAngle)
-    .def("getMultiTurnEncoderPosition", &myactuator_rmd::ActuatorInterface::getMultiTurnEncoderPosition)
-    .def("getMultiTurnEncoderOriginalPosition", &myactuator_rmd::ActuatorInterface::getMultiTurnEncoderOriginalPosition)
-    .def("getMultiTurnEncoderZeroOffset", &myactuator_rmd::ActuatorInterface::getMultiTurnEncoderZeroOffset)
-    .def("getRuntime", &myactuator_rmd::ActuatorInterface::getRuntime)
-    .def("getSingleTurnAngle", &myactuator_rmd::ActuatorInterface::getSingleTurnAngle)
-    .def("getSingleTurnEncoderPosition", &myactuator_rmd::ActuatorInterface::getSingleTurnEncoderPosition)
-    .def("getVersionDate", &myactuator_rmd::ActuatorInterface::getVersionDate)
-    .def("lockBrake", &myactuator_rmd::ActuatorInterface::lockBrake)
-    .def("releaseBrake", &myactuator_rmd::ActuatorInterface::releaseBrake)
-    .def("reset", &myactuator_rmd::ActuatorInterface::reset)
-    .def("sendCurrentSetpoint", &myactuator_rmd::ActuatorInterface::sendCurrentSetpoint)
-    .def("sendPositionAbsoluteSetpoint", &myactuator_rmd::ActuatorInterface::sendPositionAbsoluteSetpoint)
-    .def("sendTorqueSetpoint", &myactuator_rmd::ActuatorInterface::sendTorqueSetpoint)
-    .def("sendVelocitySetpoint", &myactuator_rmd::ActuatorInterface::sendVelocitySetpoint)
-    .def("setAcceleration", &myactuator_rmd::ActuatorInterface::setAcceleration)
-    .def("setCanBaudRate", &myactuator_rmd::ActuatorInterface::setCanBaudRate)
-    .def("setCanId", &myactuator_rmd::ActuatorInterface::setCanId)
-    .def("setControllerGains", &myactuator_rmd::ActuatorInterface::setControllerGains)
-    .def("setCurrentPositionAsEncoderZero", &myactuator_rmd::ActuatorInterface::setCurrentPositionAsEncoderZero)
-    .def("setEncoderZero", &myactuator_rmd::ActuatorInterface::setEncoderZero)
-    .def("setTimeout", &myactuator_rmd::ActuatorInterface::setTimeout)
-    .def("shutdownMotor", &myactuator_rmd::ActuatorInterface::shutdownMotor)
-    .def("stopMotor", &myactuator_rmd::ActuatorInterface::stopMotor);
+    .def("getControlMode", &myactuator_rmd::ActuatorInterface::getControlMode, pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("getMotorModel", &myactuator_rmd::ActuatorInterface::getMotorModel, pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("getMotorPower", &myactuator_rmd::ActuatorInterface::getMotorPower, pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("getMotorStatus1", &myactuator_rmd::ActuatorInterface::getMotorStatus1, pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("getMotorStatus2", &myactuator_rmd::ActuatorInterface::getMotorStatus2, pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("getMotorStatus3", &myactuator_rmd::ActuatorInterface::getMotorStatus3, pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("getMultiTurnAngle", &myactuator_rmd::ActuatorInterface::getMultiTurnAngle, pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("getMultiTurnEncoderPosition", &myactuator_rmd::ActuatorInterface::getMultiTurnEncoderPosition, pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("getMultiTurnEncoderOriginalPosition", &myactuator_rmd::ActuatorInterface::getMultiTurnEncoderOriginalPosition, pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("getMultiTurnEncoderZeroOffset", &myactuator_rmd::ActuatorInterface::getMultiTurnEncoderZeroOffset, pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("getRuntime", &myactuator_rmd::ActuatorInterface::getRuntime, pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("getSingleTurnAngle", &myactuator_rmd::ActuatorInterface::getSingleTurnAngle, pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("getSingleTurnEncoderPosition", &myactuator_rmd::ActuatorInterface::getSingleTurnEncoderPosition, pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("getVersionDate", &myactuator_rmd::ActuatorInterface::getVersionDate, pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("lockBrake", &myactuator_rmd::ActuatorInterface::lockBrake, pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("releaseBrake", &myactuator_rmd::ActuatorInterface::releaseBrake, pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("reset", &myactuator_rmd::ActuatorInterface::reset, pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("sendCurrentSetpoint", &myactuator_rmd::ActuatorInterface::sendCurrentSetpoint, pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("sendPositionAbsoluteSetpoint", &myactuator_rmd::ActuatorInterface::sendPositionAbsoluteSetpoint, pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("sendTorqueSetpoint", &myactuator_rmd::ActuatorInterface::sendTorqueSetpoint, pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("sendVelocitySetpoint", &myactuator_rmd::ActuatorInterface::sendVelocitySetpoint, pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("setAcceleration", &myactuator_rmd::ActuatorInterface::setAcceleration, pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("setCanBaudRate", &myactuator_rmd::ActuatorInterface::setCanBaudRate, pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("setCanId", &myactuator_rmd::ActuatorInterface::setCanId, pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("setCompensation", &myactuator_rmd::ActuatorInterface::setCompensation, pybind11::arg("compensation"), pybind11::keep_alive<1,2>())
+    .def("setControllerGains", &myactuator_rmd::ActuatorInterface::setControllerGains, pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("setCurrentPositionAsEncoderZero", &myactuator_rmd::ActuatorInterface::setCurrentPositionAsEncoderZero, pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("setEncoderZero", &myactuator_rmd::ActuatorInterface::setEncoderZero, pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("setTimeout", &myactuator_rmd::ActuatorInterface::setTimeout, pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("shutdownMotor", &myactuator_rmd::ActuatorInterface::shutdownMotor, pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("stopMotor", &myactuator_rmd::ActuatorInterface::stopMotor, pybind11::call_guard<pybind11::gil_scoped_release>());
+  // Futures are resolved from the completion thread through the event loop, errors are raised when awaited
+  pybind11::exec(R"(
+def _complete(future, result):
+    if not future.done():
+        future.set_result(result)
+
+async def _resolve(future):
+    return (await future).get()
+  )", m.attr("__dict__"));
+  pybind11::class_<myactuator_rmd::bindings::AsyncResult>(m, "_AsyncResult")
+    .def("get", &myactuator_rmd::bindings::AsyncResult::get);
+  pybind11::class_<myactuator_rmd::AsyncDriver, std::unique_ptr<myactuator_rmd::AsyncDriver, myactuator_rmd::bindings::AsyncDriverDeleter>>(m, "AsyncDriver")
+    .def(pybind11::init<myactuator_rmd::Driver&, std::size_t const>(), pybind11::arg("driver"), pybind11::arg("max_batch_size") = 32,
+         pybind11::keep_alive<1,2>())
+    .def("getPending", &myactuator_rmd::AsyncDriver::getPending);
+  pybind11::class_<myactuator_rmd::AsyncActuatorInterface>(m, "AsyncActuatorInterface")
+    .def(pybind11::init<myactuator_rmd::AsyncDriver&, std::uint32_t>(), pybind11::keep_alive<1,2>(),
+         pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("getAcceleration", [](myactuator_rmd::AsyncActuatorInterface& actuator) {
+        return myactuator_rmd::bindings::awaitable<std::int32_t>([&actuator](auto const& completion) { actuator.getAcceleration(completion); });
+      })
+    .def("getControllerGains", [](myactuator_rmd::AsyncActuatorInterface& actuator) {
+        return myactuator_rmd::bindings::awaitable<myactuator_rmd::Gains>([&actuator](auto const& completion) { actuator.getControllerGains(completion); });
+      })
+    .def("getControlMode", [](myactuator_rmd::AsyncActuatorInterface& actuator) {
+        return myactuator_rmd::bindings::awaitable<myactuator_rmd::ControlMode>([&actuator](auto const& completion) { actuator.getControlMode(completion); });
+      })
+    .def("getMotorModel", [](myactuator_rmd::AsyncActuatorInterface& actuator) {
+        return myactuator_rmd::bindings::awaitable<std::string>([&actuator](auto const& completion) { actuator.getMotorModel(completion); });
+      })
+    .def("getMotorPower", [](myactuator_rmd::AsyncActuatorInterface& actuator) {
+        return myactuator_rmd::bindings::awaitable<float>([&actuator](auto const& completion) { actuator.getMotorPower(completion); });
+      })
+    .def("getMotorStatus1", [](myactuator_rmd::AsyncActuatorInterface& actuator) {
+        return myactuator_rmd::bindings::awaitable<myactuator_rmd::MotorStatus1>([&actuator](auto const& completion) { actuator.getMotorStatus1(completion); });
+      })
+    .def("getMotorStatus2", [](myactuator_rmd::AsyncActuatorInterface& actuator) {
+        return myactuator_rmd::bindings::awaitable<myactuator_rmd::MotorStatus2>([&actuator](auto const& completion) { actuator.getMotorStatus2(completion); });
+      })
+    .def("getMotorStatus3", [](myactuator_rmd::AsyncActuatorInterface& actuator) {
+        return myactuator_rmd::bindings::awaitable<myactuator_rmd::MotorStatus3>([&actuator](auto const& completion) { actuator.getMotorStatus3(completion); });
+      })
+    .def("getMultiTurnAngle", [](myactuator_rmd::AsyncActuatorInterface& actuator) {
+        return myactuator_rmd::bindings::awaitable<float>([&actuator](auto const& completion) { actuator.getMultiTurnAngle(completion); });
+      })
+    .def("getRuntime", [](myactuator_rmd::AsyncActuatorInterface& actuator) {
+        return myactuator_rmd::bindings::awaitable<std::chrono::milliseconds>([&actuator](auto const& completion) { actuator.getRuntime(completion); });
+      })
+    .def("getSingleGain", [](myactuator_rmd::AsyncActuatorInterface& actuator, myactuator_rmd::GainType const gain_type) {
+        return myactuator_rmd::bindings::awaitable<float>([&actuator, gain_type](auto const& completion) { actuator.getSingleGain(gain_type, completion); });
+      })
+    .def("getSingleTurnAngle", [](myactuator_rmd::AsyncActuatorInterface& actuator) {
+        return myactuator_rmd::bindings::awaitable<float>([&actuator](auto const& completion) { actuator.getSingleTurnAngle(completion); });
+      })
+    .def("getVersionDate", [](myactuator_rmd::AsyncActuatorInterface& actuator) {
+        return myactuator_rmd::bindings::awaitable<std::uint32_t>([&actuator](auto const& completion) { actuator.getVersionDate(completion); });
+      })
+    .def("motionControl", [](myactuator_rmd::AsyncActuatorInterface& actuator, float const p_des, float const v_des,
+                             float const kp, float const kd, float const t_ff) {
+        return myactuator_rmd::bindings::awaitable<myactuator_rmd::MotionControlStatus>([&](auto const& completion) {
+          actuator.motionControl(p_des, v_des, kp, kd, t_ff, completion);
+        });
+      })
+    .def("sendCurrentSetpoint", [](myactuator_rmd::AsyncActuatorInterface& actuator, float const current) {
+        return myactuator_rmd::bindings::awaitable<myactuator_rmd::Feedback>([&actuator, current](auto const& completion) {
+          actuator.sendCurrentSetpoint(current, completion);
+        });
+      })
+    .def("sendPositionAbsoluteSetpoint", [](myactuator_rmd::AsyncActuatorInterface& actuator, float const position, float const max_speed) {
+        return myactuator_rmd::bindings::awaitable<myactuator_rmd::Feedback>([&actuator, position, max_speed](auto const& completion) {
+          actuator.sendPositionAbsoluteSetpoint(position, max_speed, completion);
+        });
+      }, pybind11::arg("position"), pybind11::arg("max_speed") = 500.0f)
+    .def("sendVelocitySetpoint", [](myactuator_rmd::AsyncActuatorInterface& actuator, float const speed) {
+        return myactuator_rmd::bindings::awaitable<myactuator_rmd::Feedback>([&actuator, speed](auto const& completion) {
+          actuator.sendVelocitySetpoint(speed, completion);
+        });
+      })
+    .def("shutdownMotor", [](myactuator_rmd::AsyncActuatorInterface& actuator) {
+        return myactuator_rmd::bindings::statusAwaitable([&actuator](auto const& completion) { actuator.shutdownMotor(completion); });
+      })
+    .def("stopMotor", [](myactuator_rmd::AsyncActuatorInterface& actuator) {
+        return myactuator_rmd::bindings::statusAwaitable([&actuator](auto const& completion) { actuator.stopMotor(completion); });
+      });
+  pybind11::enum_<myactuator_rmd::SafetyAction>(m, "SafetyAction")
+    .value("CLAMP", myactuator_rmd::SafetyAction::CLAMP)
+    .value("STOP", myactuator_rmd::SafetyAction::STOP)
+    .value("SHUTDOWN", myactuator_rmd::SafetyAction::SHUTDOWN);
+  pybind11::class_<myactuator_rmd::SafetyLimits>(m, "SafetyLimits")
+    .def(pybind11::init<std::size_t const>(), pybind11::arg("num_actuators"))
+    .def("getNumActuators", &myactuator_rmd::SafetyLimits::getNumActuators)
+    .def("getNumViolations", &myactuator_rmd::SafetyLimits::getNumViolations)
+    .def("getTrip", &myactuator_rmd::SafetyLimits::getTrip)
+    .def("reset", &myactuator_rmd::SafetyLimits::reset)
+    .def_readwrite("min_position", &myactuator_rmd::SafetyLimits::min_position)
+    .def_readwrite("max_position", &myactuator_rmd::SafetyLimits::max_position)
+    .def_readwrite("max_velocity", &myactuator_rmd::SafetyLimits::max_velocity)
+    .def_readwrite("max_torque", &myactuator_rmd::SafetyLimits::max_torque)
+    .def_readwrite("max_current", &myactuator_rmd::SafetyLimits::max_current)
+    .def_readwrite("derating_temperature", &myactuator_rmd::SafetyLimits::derating_temperature)
+    .def_readwrite("max_temperature", &myactuator_rmd::SafetyLimits::max_temperature)
+    .def_readwrite("setpoint_action", &myactuator_rmd::SafetyLimits::setpoint_action)
+    .def_readwrite("feedback_action", &myactuator_rmd::SafetyLimits::feedback_action);
+  pybind11::class_<myactuator_rmd::StepResponse>(m, "StepResponse")
+    .def(pybind11::init<std::size_t const, float const>(), pybind11::arg("capacity") = 4096, pybind11::arg("settling_band") = 0.02f)
+    .def("reset", &myactuator_rmd::StepResponse::reset)
+    .def("update", &myactuator_rmd::StepResponse::update)
+    .def("getNumSamples", &myactuator_rmd::StepResponse::getNumSamples)
+    .def("getTimes", [](myactuator_rmd::StepResponse const& response) {
+        auto const& times {response.getTimes()};
+        return std::vector<std::chrono::microseconds>(times.begin(), times.begin() + response.getNumSamples());
+      })
+    .def("getValues", [](myactuator_rmd::StepResponse const& response) {
+        auto const& values {response.getValues()};
+        return std::vector<float>(values.begin(), values.begin() + response.getNumSamples());
+      })
+    .def("getRiseTime", &myactuator_rmd::StepResponse::getRiseTime)
+    .def("getOvershoot", &myactuator_rmd::StepResponse::getOvershoot)
+    .def("getSettlingTime", &myactuator_rmd::StepResponse::getSettlingTime)
+    .def("getSteadyStateError", &myactuator_rmd::StepResponse::getSteadyStateError)
+    .def("getIntegralAbsoluteError", &myactuator_rmd::StepResponse::getIntegralAbsoluteError)
+    .def("getBandwidth", &myactuator_rmd::StepResponse::getBandwidth);
+  pybind11::enum_<myactuator_rmd::CaptureMode>(m, "CaptureMode")
+    .value("CURRENT", myactuator_rmd::CaptureMode::CURRENT)
+    .value("VELOCITY", myactuator_rmd::CaptureMode::VELOCITY)
+    .value("POSITION", myactuator_rmd::CaptureMode::POSITION);
+  pybind11::enum_<myactuator_rmd::ExcitationSignal>(m, "ExcitationSignal")
+    .value("SINE", myactuator_rmd::ExcitationSignal::SINE)
+    .value("CHIRP", myactuator_rmd::ExcitationSignal::CHIRP)
+    .value("SQUARE", myactuator_rmd::ExcitationSignal::SQUARE);
+  pybind11::class_<myactuator_rmd::CaptureData>(m, "CaptureData")
+    .def_readonly("time", &myactuator_rmd::CaptureData::time)
+    .def_readonly("setpoint", &myactuator_rmd::CaptureData::setpoint)
+    .def_readonly("temperature", &myactuator_rmd::CaptureData::temperature)
+    .def_readonly("current", &myactuator_rmd::CaptureData::current)
+    .def_readonly("velocity", &myactuator_rmd::CaptureData::velocity)
+    .def_readonly("position", &myactuator_rmd::CaptureData::position);
+  pybind11::class_<myactuator_rmd::Capture>(m, "Capture")
+    .def(pybind11::init<myactuator_rmd::Driver&, std::uint32_t const, std::size_t const>(), pybind11::arg("driver"),
+         pybind11::arg("actuator_id"), pybind11::arg("capacity") = 65536, pybind11::keep_alive<1,2>())
+    .def("run", &myactuator_rmd::Capture::run, pybind11::arg("duration"), pybind11::arg("period") = std::chrono::microseconds(0),
+         pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("getSetpoint", &myactuator_rmd::Capture::getSetpoint)
+    .def("clear", &myactuator_rmd::Capture::clear)
+    .def("__len__", &myactuator_rmd::Capture::size)
+    .def("getNumOverwritten", &myactuator_rmd::Capture::getNumOverwritten)
+    .def("getNumTimeouts", &myactuator_rmd::Capture::getNumTimeouts)
+    .def("getFrames", &myactuator_rmd::Capture::getFrames)
+    .def("decode", &myactuator_rmd::Capture::decode)
+    .def("writeCsv", [](myactuator_rmd::Capture const& capture, std::string const& filename) {
+        std::ofstream ofs {filename};
+        capture.writeCsv(ofs);
+      })
+    .def("writeBinary", [](myactuator_rmd::Capture const& capture, std::string const& filename) {
+        std::ofstream ofs {filename, std::ios::binary};
+        capture.writeBinary(ofs);
+      })
+    .def_readwrite("mode", &myactuator_rmd::Capture::mode)
+    .def_readwrite("signal", &myactuator_rmd::Capture::signal)
+    .def_readwrite("offset", &myactuator_rmd::Capture::offset)
+    .def_readwrite("amplitude", &myactuator_rmd::Capture::amplitude)
+    .def_readwrite("frequency", &myactuator_rmd::Capture::frequency)
+    .def_readwrite("end_frequency", &myactuator_rmd::Capture::end_frequency)
+    .def_readwrite("max_speed", &myactuator_rmd::Capture::max_speed);
+  pybind11::class_<myactuator_rmd::FrictionModel>(m, "FrictionModel")
+    .def(pybind11::init<float const, float const, float const, float const>(), pybind11::arg("coulomb") = 0.0f,
+         pybind11::arg("static_friction") = 0.0f, pybind11::arg("stribeck_speed") = 1.0f, pybind11::arg("viscous") = 0.0f)
+    .def("getTorque", &myactuator_rmd::FrictionModel::getTorque)
+    .def_readwrite("coulomb", &myactuator_rmd::FrictionModel::coulomb)
+    .def_readwrite("static_friction", &myactuator_rmd::FrictionModel::static_friction)
+    .def_readwrite("stribeck_speed", &myactuator_rmd::FrictionModel::stribeck_speed)
+    .def_readwrite("viscous", &myactuator_rmd::FrictionModel::viscous);
+  pybind11::class_<myactuator_rmd::Compensation>(m, "Compensation")
+    .def(pybind11::init<std::uint32_t const, float const, std::size_t const>(), pybind11::arg("encoder_range") = 65536,
+         pybind11::arg("max_speed") = 720.0f, pybind11::arg("num_friction_bins") = 1025)
+    .def("getEncoderRange", &myactuator_rmd::Compensation::getEncoderRange)
+    .def("setCoggingTable", &myactuator_rmd::Compensation::setCoggingTable)
+    .def("getCoggingTable", &myactuator_rmd::Compensation::getCoggingTable)
+    .def("setFrictionModel", &myactuator_rmd::Compensation::setFrictionModel)
+    .def("getFrictionModel", &myactuator_rmd::Compensation::getFrictionModel)
+    .def("setEncoderReference", &myactuator_rmd::Compensation::setEncoderReference)
+    .def("getEncoderPosition", &myactuator_rmd::Compensation::getEncoderPosition)
+    .def("getCoggingTorque", &myactuator_rmd::Compensation::getCoggingTorque)
+    .def("getFrictionTorque", &myactuator_rmd::Compensation::getFrictionTorque)
+    .def("getTorque", &myactuator_rmd::Compensation::getTorque);
+  pybind11::class_<myactuator_rmd::CompensationCalibration>(m, "CompensationCalibration")
+    .def(pybind11::init<myactuator_rmd::ActuatorInterface&, float const, std::chrono::microseconds const&>(),
+         pybind11::arg("actuator"), pybind11::arg("torque_constant"), pybind11::arg("period") = std::chrono::milliseconds(2),
+         pybind11::keep_alive<1,2>())
+    .def("calibrateFriction", &myactuator_rmd::CompensationCalibration::calibrateFriction, pybind11::arg("compensation"),
+         pybind11::arg("speeds"), pybind11::arg("num_samples") = 500, pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("calibrateCogging", &myactuator_rmd::CompensationCalibration::calibrateCogging, pybind11::arg("compensation"),
+         pybind11::arg("speed"), pybind11::arg("reducer_ratio"), pybind11::arg("num_bins") = 512,
+         pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("calibrate", &myactuator_rmd::CompensationCalibration::calibrate, pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("getNumOverruns", &myactuator_rmd::CompensationCalibration::getNumOverruns)
+    .def_readwrite("num_settling_samples", &myactuator_rmd::CompensationCalibration::num_settling_samples);
+  pybind11::enum_<myactuator_rmd::ExcitationType>(m, "ExcitationType")
+    .value("POSITION_STEP", myactuator_rmd::ExcitationType::POSITION_STEP)
+    .value("VELOCITY_STEP", myactuator_rmd::ExcitationType::VELOCITY_STEP);
+  pybind11::class_<myactuator_rmd::GainTuner>(m, "GainTuner")
+    .def(pybind11::init<myactuator_rmd::ActuatorInterface&, myactuator_rmd::ExcitationType const, float const,
+                        std::chrono::microseconds const&, std::size_t const>(),
+         pybind11::arg("actuator"), pybind11::arg("type"), pybind11::arg("amplitude"),
+         pybind11::arg("period") = std::chrono::milliseconds(2), pybind11::arg("num_samples") = 500, pybind11::keep_alive<1,2>())
+    .def("runStep", &myactuator_rmd::GainTuner::runStep, pybind11::return_value_policy::reference_internal,
+         pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("evaluate", &myactuator_rmd::GainTuner::evaluate, pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("tune", &myactuator_rmd::GainTuner::tune, pybind11::arg("gain_type"), pybind11::arg("min_gain"), pybind11::arg("max_gain"),
+         pybind11::arg("num_experiments") = 12, pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("getCost", &myactuator_rmd::GainTuner::getCost)
+    .def("getNumExperiments", &myactuator_rmd::GainTuner::getNumExperiments)
+    .def("getNumOverruns", &myactuator_rmd::GainTuner::getNumOverruns)
+    .def_readwrite("overshoot_weight", &myactuator_rmd::GainTuner::overshoot_weight)
+    .def_readwrite("max_speed", &myactuator_rmd::GainTuner::max_speed);
+  pybind11::class_<myactuator_rmd::ActuatorGroup>(m, "ActuatorGroup")
+    .def(pybind11::init<myactuator_rmd::Driver&, std::vector<std::uint32_t> const&>(), pybind11::keep_alive<1,2>())
+    .def("getActuatorIds", &myactuator_rmd::ActuatorGroup::getActuatorIds)
+    .def("__len__", &myactuator_rmd::ActuatorGroup::size)
+    .def("setTimeout", &myactuator_rmd::ActuatorGroup::setTimeout)
+    .def("setSafetyLimits", &myactuator_rmd::ActuatorGroup::setSafetyLimits, pybind11::arg("limits"), pybind11::keep_alive<1,2>())
+    .def("motionControl", [](myactuator_rmd::ActuatorGroup& group, myactuator_rmd::bindings::FloatArray const p_des,
+                             myactuator_rmd::bindings::FloatArray const v_des, myactuator_rmd::bindings::FloatArray const kp,
+                             myactuator_rmd::bindings::FloatArray const kd, myactuator_rmd::bindings::FloatArray const t_ff) {
+        myactuator_rmd::bindings::checkSize(p_des, group, "p_des");
+        myactuator_rmd::bindings::checkSize(v_des, group, "v_des");
+        myactuator_rmd::bindings::checkSize(kp, group, "kp");
+        myactuator_rmd::bindings::checkSize(kd, group, "kd");
+        myactuator_rmd::bindings::checkSize(t_ff, group, "t_ff");
+        auto const n {static_cast<pybind11::ssize_t>(group.size())};
+        myactuator_rmd::bindings::OutputArray position(n);
+        myactuator_rmd::bindings::OutputArray velocity(n);
+        myactuator_rmd::bindings::OutputArray torque(n);
+        float* const position_data {position.mutable_data()};
+        float* const velocity_data {velocity.mutable_data()};
+        float* const torque_data {torque.mutable_data()};
+        myactuator_rmd::SafetyAction action {};
+        {
+          pybind11::gil_scoped_release const release {};
+          action = group.motionControl(p_des.data(), v_des.data(), kp.data(), kd.data(), t_ff.data(),
+                                       position_data, velocity_data, torque_data);
+        }
+        // Only the overload writing to given arrays returns the action together with the feedback
+        if (action != myactuator_rmd::SafetyAction::CLAMP) {
+          throw myactuator_rmd::Exception("Safety limits halted the actuators!");
+        }
+        return pybind11::make_tuple(position, velocity, torque);
+      }, pybind11::arg("p_des"), pybind11::arg("v_des"), pybind11::arg("kp"), pybind11::arg("kd"), pybind11::arg("t_ff"))
+    .def("motionControl", [](myactuator_rmd::ActuatorGroup& group, myactuator_rmd::bindings::FloatArray const p_des,
+                             myactuator_rmd::bindings::FloatArray const v_des, myactuator_rmd::bindings::FloatArray const kp,
+                             myactuator_rmd::bindings::FloatArray const kd, myactuator_rmd::bindings::FloatArray const t_ff,
+                             myactuator_rmd::bindings::OutputArray position, myactuator_rmd::bindings::OutputArray velocity,
+                             myactuator_rmd::bindings::OutputArray torque) {
+        myactuator_rmd::bindings::checkSize(p_des, group, "p_des");
+        myactuator_rmd::bindings::checkSize(v_des, group, "v_des");
+        myactuator_rmd::bindings::checkSize(kp, group, "kp");
+        myactuator_rmd::bindings::checkSize(kd, group, "kd");
+        myactuator_rmd::bindings::checkSize(t_ff, group, "t_ff");
+        myactuator_rmd::bindings::checkSize(position, group, "position");
+        myactuator_rmd::bindings::checkSize(velocity, group, "velocity");
+        myactuator_rmd::bindings::checkSize(torque, group, "torque");
+        float* const position_data {position.mutable_data()};
+        float* const velocity_data {velocity.mutable_data()};
+        float* const torque_data {torque.mutable_data()};
+        pybind11::gil_scoped_release const release {};
+        return group.motionControl(p_des.data(), v_des.data(), kp.data(), kd.data(), t_ff.data(), position_data, velocity_data, torque_data);
+      }, pybind11::arg("p_des"), pybind11::arg("v_des"), pybind11::arg("kp"), pybind11::arg("kd"), pybind11::arg("t_ff"),
+         pybind11::arg("position").noconvert(), pybind11::arg("velocity").noconvert(), pybind11::arg("torque").noconvert());
+  pybind11::enum_<myactuator_rmd::InterpolationType>(m, "InterpolationType")
+    .value("CUBIC", myactuator_rmd::InterpolationType::CUBIC)
+    .value("QUINTIC", myactuator_rmd::InterpolationType::QUINTIC)
+    .value("TRAPEZOIDAL", myactuator_rmd::InterpolationType::TRAPEZOIDAL);
+  pybind11::class_<myactuator_rmd::TrajectoryInterpolator>(m, "TrajectoryInterpolator")
+    .def(pybind11::init<std::vector<float> const&, std::chrono::microseconds const&, myactuator_rmd::InterpolationType const,
+                        std::size_t const>(),
+         pybind11::arg("position"), pybind11::arg("period"), pybind11::arg("type") = myactuator_rmd::InterpolationType::QUINTIC,
+         pybind11::arg("capacity") = 64)
+    .def("getNumActuators", &myactuator_rmd::TrajectoryInterpolator::getNumActuators)
+    .def("getNumWaypoints", &myactuator_rmd::TrajectoryInterpolator::getNumWaypoints)
+    .def("isMoving", &myactuator_rmd::TrajectoryInterpolator::isMoving)
+    .def("addWaypoint", [](myactuator_rmd::TrajectoryInterpolator& interpolator, std::chrono::microseconds const& duration,
+                           myactuator_rmd::bindings::FloatArray const position) {
+        if ((position.ndim() != 1) || (static_cast<std::size_t>(position.size()) != interpolator.getNumActuators())) {
+          throw pybind11::value_error("Argument 'position' has to be a one-dimensional array with one element per actuator (" +
+                                      std::to_string(interpolator.getNumActuators()) + ")");
+        }
+        return interpolator.addWaypoint(duration, position.data());
+      }, pybind11::arg("duration"), pybind11::arg("position"))
+    .def("reset", [](myactuator_rmd::TrajectoryInterpolator& interpolator, myactuator_rmd::bindings::FloatArray const position) {
+        if ((position.ndim() != 1) || (static_cast<std::size_t>(position.size()) != interpolator.getNumActuators())) {
+          throw pybind11::value_error("Argument 'position' has to be a one-dimensional array with one element per actuator (" +
+                                      std::to_string(interpolator.getNumActuators()) + ")");
+        }
+        interpolator.reset(position.data());
+        return;
+      }, pybind11::arg("position"))
+    .def("step", [](myactuator_rmd::TrajectoryInterpolator& interpolator) {
+        auto const n {static_cast<pybind11::ssize_t>(interpolator.getNumActuators())};
+        myactuator_rmd::bindings::OutputArray position {n};
+        myactuator_rmd::bindings::OutputArray velocity {n};
+        interpolator.step(position.mutable_data(), velocity.mutable_data());
+        return pybind11::make_tuple(position, velocity);
+      })
+    .def_readwrite("kp", &myactuator_rmd::TrajectoryInterpolator::kp)
+    .def_readwrite("kd", &myactuator_rmd::TrajectoryInterpolator::kd)
+    .def_readwrite("max_speed", &myactuator_rmd::TrajectoryInterpolator::max_speed);
+  pybind11::enum_<myactuator_rmd::StreamMode>(m, "StreamMode")
+    .value("MOTION_CONTROL", myactuator_rmd::StreamMode::MOTION_CONTROL)
+    .value("POSITION_SETPOINT", myactuator_rmd::StreamMode::POSITION_SETPOINT);
+  pybind11::class_<myactuator_rmd::TrajectoryStreamer>(m, "TrajectoryStreamer")
+    .def(pybind11::init<myactuator_rmd::ActuatorGroup&, std::chrono::microseconds const&, myactuator_rmd::StreamMode const>(),
+         pybind11::arg("group"), pybind11::arg("period"), pybind11::arg("mode") = myactuator_rmd::StreamMode::MOTION_CONTROL,
+         pybind11::keep_alive<1,2>())
+    .def("setTrajectory", [](myactuator_rmd::TrajectoryStreamer& streamer, myactuator_rmd::bindings::FloatArray const position,
+                             std::optional<myactuator_rmd::bindings::FloatArray> const velocity,
+                             std::optional<myactuator_rmd::bindings::FloatArray> const torque,
+                             std::optional<myactuator_rmd::bindings::FloatArray> const kp,
+                             std::optional<myactuator_rmd::bindings::FloatArray> const kd,
+                             std::optional<myactuator_rmd::bindings::FloatArray> const max_speed) {
+        auto const trajectory {myactuator_rmd::bindings::toTrajectory(position, velocity, torque, kp, kd, max_speed)};
+        streamer.setTrajectory(trajectory);
+        return;
+      }, pybind11::arg("position"), pybind11::arg("velocity") = pybind11::none(), pybind11::arg("torque") = pybind11::none(),
+         pybind11::arg("kp") = pybind11::none(), pybind11::arg("kd") = pybind11::none(), pybind11::arg("max_speed") = pybind11::none())
+    .def("setInterpolator", &myactuator_rmd::TrajectoryStreamer::setInterpolator, pybind11::arg("interpolator"),
+         pybind11::keep_alive<1,2>(), pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("start", &myactuator_rmd::TrajectoryStreamer::start)
+    .def("stop", &myactuator_rmd::TrajectoryStreamer::stop, pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("isRunning", &myactuator_rmd::TrajectoryStreamer::isRunning)
+    .def("getProgress", &myactuator_rmd::TrajectoryStreamer::getProgress)
+    .def("getNumSamples", &myactuator_rmd::TrajectoryStreamer::getNumSamples)
+    .def("getOverruns", &myactuator_rmd::TrajectoryStreamer::getOverruns)
+    .def("getError", &myactuator_rmd::TrajectoryStreamer::getError)
+    .def("getFeedback", [](myactuator_rmd::TrajectoryStreamer const& streamer) {
+        std::vector<float> position {};
+        std::vector<float> velocity {};
+        std::vector<float> torque {};
+        auto const num_samples {static_cast<pybind11::ssize_t>(streamer.getFeedback(position, velocity, torque))};
+        auto const num_actuators {num_samples > 0 ? static_cast<pybind11::ssize_t>(position.size())/num_samples : 0};
+        std::vector<pybind11::ssize_t> const shape {num_samples, num_actuators};
+        return pybind11::make_tuple(myactuator_rmd::bindings::OutputArray(shape, position.data()),
+                                    myactuator_rmd::bindings::OutputArray(shape, velocity.data()),
+                                    myactuator_rmd::bindings::OutputArray(shape, torque.data()));
+      });
   pybind11::register_exception<myactuator_rmd::Exception>(m, "ActuatorException");
   pybind11::register_exception<myactuator_rmd::ProtocolException>(m, "ProtocolException");
   pybind11::register_exception<myactuator_rmd::ValueRangeException>(m, "ValueRangeException");
@@ -233,12 +886,26 @@ PYBIND11_MODULE(myactuator_rmd_py, m) {
     .def(pybind11::init<std::uint32_t const, std::array<std::uint8_t,8> const&>())
     .def("getId", &myactuator_rmd::can::Frame::getId)
     .def("getData", &myactuator_rmd::can::Frame::getData);
+  pybind11::class_<myactuator_rmd::can::Filter>(m_can, "Filter")
+    .def(pybind11::init<std::uint32_t const, std::uint32_t const>())
+    .def("getId", &myactuator_rmd::can::Filter::getId)
+    .def("getMask", &myactuator_rmd::can::Filter::getMask)
+    .def("matches", &myactuator_rmd::can::Filter::matches);
+  m_can.def("computeFilters", &myactuator_rmd::can::computeFilters);
+  pybind11::enum_<myactuator_rmd::can::IoBackend>(m_can, "IoBackend")
+    .value("READ_WRITE", myactuator_rmd::can::IoBackend::READ_WRITE)
+    .value("IO_URING", myactuator_rmd::can::IoBackend::IO_URING);
   pybind11::class_<myactuator_rmd::can::Node>(m_can, "Node")
     .def(pybind11::init<std::string const&>())
     .def("setRecvFilter", &myactuator_rmd::can::Node::setRecvFilter)
-    .def("read", &myactuator_rmd::can::Node::read)
-    .def("write", pybind11::overload_cast<myactuator_rmd::can::Frame const&>(&myactuator_rmd::can::Node::write));
+    .def("setRecvFilters", &myactuator_rmd::can::Node::setRecvFilters)
+    .def("setIoBackend", &myactuator_rmd::can::Node::setIoBackend)
+    .def("read", &myactuator_rmd::can::Node::read, pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("write", pybind11::overload_cast<myactuator_rmd::can::Frame const&>(&myactuator_rmd::can::Node::write),
+         pybind11::call_guard<pybind11::gil_scoped_release>())
+    .def("tryWrite", pybind11::overload_cast<myactuator_rmd::can::Frame const&>(&myactuator_rmd::can::Node::tryWrite));
   pybind11::register_exception<myactuator_rmd::can::SocketException>(m_can, "SocketException");
+  pybind11::register_exception<myactuator_rmd::can::TimeoutException>(m_can, "TimeoutException");
   pybind11::register_exception<myactuator_rmd::can::Exception>(m_can, "CanException");
   pybind11::register_exception<myactuator_rmd::can::TxTimeoutError>(m_can, "TxTimeoutError");
   pybind11::register_exception<myactuator_rmd::can::LostArbitrationError>(m_can, "LostArbitrationError");
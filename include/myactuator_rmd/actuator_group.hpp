@@ -0,0 +1,197 @@
+/**
+ * \file actuator_group.hpp
+ * \mainpage
+ *    Contains the interface to a group of actuators commanded together
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#ifndef MYACTUATOR_RMD__ACTUATOR_GROUP
+#define MYACTUATOR_RMD__ACTUATOR_GROUP
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "myactuator_rmd/actuator_state/motion_control_status.hpp"
+#include "myactuator_rmd/control/safety_limits.hpp"
+#include "myactuator_rmd/driver/driver.hpp"
+#include "myactuator_rmd/driver/transfer.hpp"
+
+
+namespace myactuator_rmd {
+
+  /**\class ActuatorGroup
+   * \brief
+   *    Commands several actuators with a single call: All requests are handed to the driver at once so that
+   *    they can be written before waiting for any reply. The CAN drivers hand all requests to the kernel with a
+   *    single system call so that the commands reach the actuators within a few frame times of each other, the
+   *    remaining skew is reported in the statistics of the driver. The buffers are allocated only once on
+   *    construction.
+  */
+  class ActuatorGroup {
+    public:
+      /**\fn ActuatorGroup
+       * \brief
+       *    Class constructor
+       * 
+       * \param[in] driver
+       *    The driver communicating over the network interface
+       * \param[in] actuator_ids
+       *    The actuator ids [1, 32] of all actuators in the group
+      */
+      ActuatorGroup(Driver& driver, std::vector<std::uint32_t> const& actuator_ids);
+      ActuatorGroup() = delete;
+      ActuatorGroup(ActuatorGroup const&) = default;
+      ActuatorGroup& operator = (ActuatorGroup const&) = default;
+      ActuatorGroup(ActuatorGroup&&) = default;
+      ActuatorGroup& operator = (ActuatorGroup&&) = default;
+
+      /**\fn getActuatorIds
+       * \brief
+       *    Get the ids of the actuators in the group
+       * 
+       * \return
+       *    The actuator ids in the order used for all arrays
+      */
+      [[nodiscard]]
+      std::vector<std::uint32_t> const& getActuatorIds() const noexcept;
+
+      /**\fn size
+       * \brief
+       *    Get the number of actuators in the group
+       * 
+       * \return
+       *    The number of actuators in the group
+      */
+      [[nodiscard]]
+      std::size_t size() const noexcept;
+
+      /**\fn setTimeout
+       * \brief
+       *    Set the deadline for the replies of all following commands, e.g. a few hundred microseconds for a
+       *    control loop. A missing actuator then only delays the group by the timeout before a TimeoutException
+       *    is thrown instead of by the receive timeout of the driver.
+       * 
+       * \param[in] timeout
+       *    The time the replies may take, zero uses the receive timeout of the driver
+      */
+      void setTimeout(std::chrono::microseconds const& timeout) noexcept;
+
+      /**\fn setSafetyLimits
+       * \brief
+       *    Check all following commands and their feedback against the given limits. Set-points are clamped
+       *    before they are sent. If a limit requests a stop or shutdown, the command is replaced by stopping or
+       *    shutting down all actuators of the group and the output arrays are filled from their status read
+       *    afterwards. Replies to motion control commands do not hold the temperature, so in motion control mode
+       *    the torque limits are only derated if the temperatures are polled separately and handed to
+       *    \ref SafetyLimits::checkTemperature. The limits have to outlive the group or be removed before they
+       *    are destroyed.
+       *
+       * \param[in] limits
+       *    The limits with one entry per actuator in the order of \ref getActuatorIds, a null pointer removes them
+      */
+      void setSafetyLimits(SafetyLimits* const limits);
+
+      /**\fn motionControl
+       * \brief
+       *    Send a motion control command (0x400) to all actuators in the group. All arrays have to hold
+       *    one element per actuator in the order of \ref getActuatorIds.
+       * 
+       * \param[in] p_des
+       *    Desired positions [-12.5, 12.5] rad
+       * \param[in] v_des
+       *    Desired velocities [-45.0, 45.0] rad/s
+       * \param[in] kp
+       *    Position gains [0, 500]
+       * \param[in] kd
+       *    Velocity gains [0, 5]
+       * \param[in] t_ff
+       *    Feedforward torques [-24.0, 24.0] Nm
+       * \param[out] position
+       *    The positions echoed by the actuators in rad
+       * \param[out] velocity
+       *    The velocities echoed by the actuators in rad/s
+       * \param[out] torque
+       *    The torques echoed by the actuators in Nm, not a number if the command was replaced by a halt
+       * \return
+       *    The action taken by the safety limits, clamp if the command was sent and no limit tripped
+      */
+      SafetyAction motionControl(float const* p_des, float const* v_des, float const* kp, float const* kd, float const* t_ff,
+                                 float* position, float* velocity, float* torque);
+
+      /**\fn motionControl
+       * \brief
+       *    Send a motion control command (0x400) to all actuators in the group
+       * 
+       * \param[in] p_des
+       *    Desired positions [-12.5, 12.5] rad
+       * \param[in] v_des
+       *    Desired velocities [-45.0, 45.0] rad/s
+       * \param[in] kp
+       *    Position gains [0, 500]
+       * \param[in] kd
+       *    Velocity gains [0, 5]
+       * \param[in] t_ff
+       *    Feedforward torques [-24.0, 24.0] Nm
+       * \return
+       *    The echoed status (position, velocity, torque) of all actuators, after a halt by the safety limits
+       *    the status read from the halted actuators without torque
+      */
+      [[nodiscard]]
+      std::vector<MotionControlStatus> motionControl(std::vector<float> const& p_des, std::vector<float> const& v_des,
+                                                     std::vector<float> const& kp, std::vector<float> const& kd,
+                                                     std::vector<float> const& t_ff);
+
+      /**\fn sendPositionAbsoluteSetpoint
+       * \brief
+       *    Send an absolute position set-point to all actuators in the group. All arrays have to hold
+       *    one element per actuator in the order of \ref getActuatorIds.
+       * 
+       * \param[in] position
+       *    The position set-points in degree
+       * \param[in] max_speed
+       *    The maximum speeds for the motion in degree per second
+       * \param[out] shaft_angle
+       *    The output shaft angles in degree
+       * \param[out] shaft_speed
+       *    The output shaft velocities in degree per second
+       * \param[out] current
+       *    The currents used by the actuators in Ampere
+       * \return
+       *    The action taken by the safety limits, clamp if the command was sent and no limit tripped
+      */
+      SafetyAction sendPositionAbsoluteSetpoint(float const* position, float const* max_speed,
+                                                float* shaft_angle, float* shaft_speed, float* current);
+
+    protected:
+      /**\fn halt
+       * \brief
+       *    Stop or shut down all actuators of the group
+       *
+       * \param[in] action
+       *    The action requested by the safety limits
+      */
+      void halt(SafetyAction const action);
+
+      /**\fn readStatus
+       * \brief
+       *    Read the motor status 2 of all actuators of the group into the responses of the halt transfers
+      */
+      void readStatus();
+
+      Driver& driver_;
+      std::vector<std::uint32_t> actuator_ids_;
+      std::vector<Transfer> transfers_;
+      std::vector<Transfer> halt_transfers_;
+      SafetyLimits* limits_;
+      std::vector<float> limited_position_;
+      std::vector<float> limited_velocity_;
+      std::vector<float> limited_torque_;
+      std::vector<float> temperature_;
+  };
+
+}
+
+#endif // MYACTUATOR_RMD__ACTUATOR_GROUP
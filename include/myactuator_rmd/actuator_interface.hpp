@@ -12,7 +12,9 @@
 
 #include <chrono>
 #include <cstdint>
+#include <map>
 #include <string>
+#include <vector>
 
 #include "myactuator_rmd/actuator_state/acceleration_type.hpp"
 #include "myactuator_rmd/actuator_state/can_baud_rate.hpp"
@@ -22,7 +24,9 @@
 #include "myactuator_rmd/actuator_state/motor_status_1.hpp"
 #include "myactuator_rmd/actuator_state/motor_status_2.hpp"
 #include "myactuator_rmd/actuator_state/motor_status_3.hpp"
+#include "myactuator_rmd/control/compensation.hpp"
 #include "myactuator_rmd/driver/driver.hpp"
+#include "myactuator_rmd/driver/transfer.hpp"
 
 #include "myactuator_rmd/actuator_state/gain_type.hpp"
 #include "myactuator_rmd/actuator_state/function_control_type.hpp"
@@ -114,6 +118,28 @@ namespace myactuator_rmd {
      [[nodiscard]]
       float setSingleGainPersistently(GainType const gain_type, float const value);
 
+      /**\fn getAllGains
+       * \brief
+       *    Reads the values of all gain types at once: All requests are written before any reply is waited for
+       *    and the replies are told apart by the gain type they echo
+       * \returns
+       *    The gain values by gain type
+      */
+      [[nodiscard]]
+      std::map<GainType,float> getAllGains();
+
+      /**\fn setAllGains
+       * \brief
+       *    Sets the values of several gain types at once with all requests written before any reply is waited for
+       * \param[in] gains
+       *    The gain values to set by gain type
+       * \param[in] is_persistent
+       *    Whether the gains should be written to the ROM or only to the RAM
+       * \returns
+       *    The gain values echoed by the actuator by gain type
+      */
+      std::map<GainType,float> setAllGains(std::map<GainType,float> const& gains, bool const is_persistent = false);
+
       /**\fn functionControl
        * \brief
        * Send a function control command (Integer based)
@@ -325,7 +351,9 @@ namespace myactuator_rmd {
 
       /**\fn sendTorqueSetpoint
        * \brief
-       *    Send a torque set-point to the actuator by setting the current
+       *    Send a torque set-point to the actuator by setting the current. If a compensation is set, the cogging
+       *    torque at the last single-turn encoder position and the friction at the last velocity are added to the
+       *    torque, and the encoder position is read in the same batch as the current set-point.
        *
        * \param[in] torque
        *    The desired torque in [Nm]
@@ -379,6 +407,16 @@ namespace myactuator_rmd {
       */
       void setCanId(std::uint16_t const can_id);
 
+      /**\fn setCompensation
+       * \brief
+       *    Set the compensation of cogging and friction applied to torque set-points, it has to outlive the
+       *    actuator interface
+       *
+       * \param[in] compensation
+       *    The compensation of this actuator, a nullptr disables the compensation
+      */
+      void setCompensation(Compensation const* const compensation);
+
       /**\fn setCurrentPositionAsEncoderZero
        * \brief
        *    Set the zero offset (initial position) of the encoder to the current position
@@ -439,6 +477,10 @@ namespace myactuator_rmd {
     protected:
       Driver& driver_;
       std::uint32_t actuator_id_;
+      Compensation const* compensation_;
+      std::vector<Transfer> compensation_transfers_;
+      float encoder_position_;
+      Feedback feedback_;
   };
 
 }
@@ -10,6 +10,7 @@
 #define MYACTUATOR_RMD__ACTUATOR_STATE__GAIN_TYPE
 #pragma once
 
+#include <array>
 #include <cstdint>
 
 
@@ -30,6 +31,15 @@ namespace myactuator_rmd {
     POSITION_LOOP_KD = 0x09
   };
 
+  /**\var gain_types
+   * \brief
+   * All controller gain types in the order of their function indices
+   */
+  constexpr std::array<GainType,7> gain_types {
+    GainType::CURRENT_LOOP_KP, GainType::CURRENT_LOOP_KI, GainType::SPEED_LOOP_KP, GainType::SPEED_LOOP_KI,
+    GainType::POSITION_LOOP_KP, GainType::POSITION_LOOP_KI, GainType::POSITION_LOOP_KD
+  };
+
 }
 
 #endif // MYACTUATOR_RMD__ACTUATOR_STATE__GAIN_TYPE
\ No newline at end of file
@@ -0,0 +1,298 @@
+/**
+ * \file async_actuator_interface.hpp
+ * \mainpage
+ *    Contains the non-blocking interface to a single actuator
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#ifndef MYACTUATOR_RMD__ASYNC_ACTUATOR_INTERFACE
+#define MYACTUATOR_RMD__ASYNC_ACTUATOR_INTERFACE
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <string>
+
+#include "myactuator_rmd/actuator_state/control_mode.hpp"
+#include "myactuator_rmd/actuator_state/feedback.hpp"
+#include "myactuator_rmd/actuator_state/gain_type.hpp"
+#include "myactuator_rmd/actuator_state/gains.hpp"
+#include "myactuator_rmd/actuator_state/motion_control_status.hpp"
+#include "myactuator_rmd/actuator_state/motor_status_1.hpp"
+#include "myactuator_rmd/actuator_state/motor_status_2.hpp"
+#include "myactuator_rmd/actuator_state/motor_status_3.hpp"
+#include "myactuator_rmd/driver/async_driver.hpp"
+#include "myactuator_rmd/driver/can_address_offset.hpp"
+#include "myactuator_rmd/protocol/message.hpp"
+
+
+namespace myactuator_rmd {
+
+  /**\fn Completion
+   * \brief
+   *    Called from the completion thread with the result of a request. In case of an error the result is
+   *    default-constructed and the error holds the exception that occurred.
+   *
+   * \tparam T
+   *    The type of the result
+  */
+  template <typename T>
+  using Completion = std::function<void(T const& result, std::exception_ptr error)>;
+
+  /**\fn StatusCompletion
+   * \brief
+   *    Called from the completion thread once a command without result was acknowledged or failed
+  */
+  using StatusCompletion = std::function<void(std::exception_ptr error)>;
+
+  /**\class AsyncActuatorInterface
+   * \brief
+   *    Non-blocking counterpart of the actuator interface: every call only queues the request with an
+   *    asynchronous driver and returns immediately, the result is reported to the given completion
+  */
+  class AsyncActuatorInterface {
+    public:
+      /**\fn AsyncActuatorInterface
+       * \brief
+       *    Class constructor
+       *
+       * \param[in] driver
+       *    The asynchronous driver the requests are queued with
+       * \param[in] actuator_id
+       *    The actuator id [1, 32]
+      */
+      AsyncActuatorInterface(AsyncDriver& driver, std::uint32_t const actuator_id);
+      AsyncActuatorInterface() = delete;
+      AsyncActuatorInterface(AsyncActuatorInterface const&) = default;
+      AsyncActuatorInterface& operator = (AsyncActuatorInterface const&) = default;
+      AsyncActuatorInterface(AsyncActuatorInterface&&) = default;
+      AsyncActuatorInterface& operator = (AsyncActuatorInterface&&) = default;
+
+      /**\fn getAcceleration
+       * \brief
+       *    Reads the current acceleration in dps
+       *
+       * \param[in] completion
+       *    The completion receiving the result
+      */
+      void getAcceleration(Completion<std::int32_t> const& completion);
+
+      /**\fn getControllerGains
+       * \brief
+       *    Reads the currently used controller gains
+       *
+       * \param[in] completion
+       *    The completion receiving the result
+      */
+      void getControllerGains(Completion<Gains> const& completion);
+
+      /**\fn getControlMode
+       * \brief
+       *    Reads the currently used control mode
+       *
+       * \param[in] completion
+       *    The completion receiving the result
+      */
+      void getControlMode(Completion<ControlMode> const& completion);
+
+      /**\fn getMotorModel
+       * \brief
+       *    Reads the motor model
+       *
+       * \param[in] completion
+       *    The completion receiving the result
+      */
+      void getMotorModel(Completion<std::string> const& completion);
+
+      /**\fn getMotorPower
+       * \brief
+       *    Reads the current motor power in Watt
+       *
+       * \param[in] completion
+       *    The completion receiving the result
+      */
+      void getMotorPower(Completion<float> const& completion);
+
+      /**\fn getMotorStatus1
+       * \brief
+       *    Reads the motor status 1 including temperature, brake, voltage and error flags
+       *
+       * \param[in] completion
+       *    The completion receiving the result
+      */
+      void getMotorStatus1(Completion<MotorStatus1> const& completion);
+
+      /**\fn getMotorStatus2
+       * \brief
+       *    Reads the motor status 2 including temperature, current, speed and angle
+       *
+       * \param[in] completion
+       *    The completion receiving the result
+      */
+      void getMotorStatus2(Completion<MotorStatus2> const& completion);
+
+      /**\fn getMotorStatus3
+       * \brief
+       *    Reads the motor status 3 including temperature and phase currents
+       *
+       * \param[in] completion
+       *    The completion receiving the result
+      */
+      void getMotorStatus3(Completion<MotorStatus3> const& completion);
+
+      /**\fn getMultiTurnAngle
+       * \brief
+       *    Reads the multi-turn angle in degree
+       *
+       * \param[in] completion
+       *    The completion receiving the result
+      */
+      void getMultiTurnAngle(Completion<float> const& completion);
+
+      /**\fn getRuntime
+       * \brief
+       *    Reads the system runtime
+       *
+       * \param[in] completion
+       *    The completion receiving the result
+      */
+      void getRuntime(Completion<std::chrono::milliseconds> const& completion);
+
+      /**\fn getSingleGain
+       * \brief
+       *    Reads a single controller gain
+       *
+       * \param[in] gain_type
+       *    The gain to be read
+       * \param[in] completion
+       *    The completion receiving the result
+      */
+      void getSingleGain(GainType const gain_type, Completion<float> const& completion);
+
+      /**\fn getSingleTurnAngle
+       * \brief
+       *    Reads the single-turn angle in degree
+       *
+       * \param[in] completion
+       *    The completion receiving the result
+      */
+      void getSingleTurnAngle(Completion<float> const& completion);
+
+      /**\fn getVersionDate
+       * \brief
+       *    Reads the version date of the firmware
+       *
+       * \param[in] completion
+       *    The completion receiving the result
+      */
+      void getVersionDate(Completion<std::uint32_t> const& completion);
+
+      /**\fn motionControl
+       * \brief
+       *    Sends a motion control command
+       *
+       * \param[in] p_des
+       *    The desired position in rad
+       * \param[in] v_des
+       *    The desired velocity in rad/s
+       * \param[in] kp
+       *    The position gain
+       * \param[in] kd
+       *    The velocity gain
+       * \param[in] t_ff
+       *    The feedforward torque in Nm
+       * \param[in] completion
+       *    The completion receiving the result
+      */
+      void motionControl(float const p_des, float const v_des, float const kp, float const kd, float const t_ff,
+                         Completion<MotionControlStatus> const& completion);
+
+      /**\fn sendCurrentSetpoint
+       * \brief
+       *    Sends a current set-point in Ampere
+       *
+       * \param[in] current
+       *    The current set-point in Ampere
+       * \param[in] completion
+       *    The completion receiving the feedback
+      */
+      void sendCurrentSetpoint(float const current, Completion<Feedback> const& completion);
+
+      /**\fn sendPositionAbsoluteSetpoint
+       * \brief
+       *    Sends an absolute position set-point
+       *
+       * \param[in] position
+       *    The position set-point in degree
+       * \param[in] max_speed
+       *    The maximum speed for the motion in degree per second
+       * \param[in] completion
+       *    The completion receiving the feedback
+      */
+      void sendPositionAbsoluteSetpoint(float const position, float const max_speed, Completion<Feedback> const& completion);
+
+      /**\fn sendVelocitySetpoint
+       * \brief
+       *    Sends a velocity set-point
+       *
+       * \param[in] speed
+       *    The speed set-point in degree per second
+       * \param[in] completion
+       *    The completion receiving the feedback
+      */
+      void sendVelocitySetpoint(float const speed, Completion<Feedback> const& completion);
+
+      /**\fn shutdownMotor
+       * \brief
+       *    Turns off the motor and clears its state
+       *
+       * \param[in] completion
+       *    The completion notified once the command was acknowledged
+      */
+      void shutdownMotor(StatusCompletion const& completion);
+
+      /**\fn stopMotor
+       * \brief
+       *    Stops the motor but does not clear its state
+       *
+       * \param[in] completion
+       *    The completion notified once the command was acknowledged
+      */
+      void stopMotor(StatusCompletion const& completion);
+
+    protected:
+      /**\fn submit
+       * \brief
+       *    Queue a request and decode its response on the completion thread
+       *
+       * \tparam T
+       *    The type of the result
+       * \tparam F
+       *    The function decoding the response bytes into the result
+       * \param[in] request
+       *    The request to be sent
+       * \param[in] decode
+       *    The function decoding the response, may throw in case of an invalid response
+       * \param[in] completion
+       *    The completion receiving the result
+       * \param[in] request_offset
+       *    The CAN id offset the request should be sent to
+       * \param[in] response_offset
+       *    The CAN id offset the response is expected from
+      */
+      template <typename T, typename F>
+      void submit(Message const& request, F const& decode, Completion<T> const& completion,
+                  std::uint32_t const request_offset = CanAddressOffset::request,
+                  std::uint32_t const response_offset = CanAddressOffset::response);
+
+      AsyncDriver& driver_;
+      std::uint32_t actuator_id_;
+  };
+
+}
+
+#endif // MYACTUATOR_RMD__ASYNC_ACTUATOR_INTERFACE
@@ -26,6 +26,16 @@ namespace myactuator_rmd {
         using std::system_error::system_error;
     };
 
+    /**\class TimeoutException
+     * \brief
+     *    Exception class for replies that did not arrive before their deadline or the receive timeout of the
+     *    socket. Transfers exchanged together with the one that timed out are not affected by it.
+    */
+    class TimeoutException: public SocketException {
+      public:
+        using SocketException::SocketException;
+    };
+
     /**\class Exception
      * \brief
      *    Exception base class for CAN specific errors
@@ -0,0 +1,115 @@
+/**
+ * \file filter.hpp
+ * \mainpage
+ *    Contains a receive filter for SocketCAN and a builder computing a small set of filters
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#ifndef MYACTUATOR_RMD__CAN__FILTER
+#define MYACTUATOR_RMD__CAN__FILTER
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+
+namespace myactuator_rmd {
+  namespace can {
+
+    /**\class Filter
+     * \brief
+     *    Receive filter of the form (id, mask): A frame passes if all bits of its CAN id selected by the mask
+     *    are equal to the ones of the filter id
+    */
+    class Filter {
+      public:
+        /**\fn Filter
+         * \brief
+         *    Class constructor
+         *
+         * \param[in] id
+         *    The CAN id the selected bits are compared to
+         * \param[in] mask
+         *    The bits of the CAN id that have to match
+        */
+        constexpr Filter(std::uint32_t const id, std::uint32_t const mask) noexcept;
+        Filter() = delete;
+        Filter(Filter const&) = default;
+        Filter& operator = (Filter const&) = default;
+        Filter(Filter&&) = default;
+        Filter& operator = (Filter&&) = default;
+
+        /**\fn getId
+         * \brief
+         *    Getter for the filter id
+         *
+         * \return
+         *    The CAN id the selected bits are compared to
+        */
+        [[nodiscard]]
+        constexpr std::uint32_t getId() const noexcept;
+
+        /**\fn getMask
+         * \brief
+         *    Getter for the filter mask
+         *
+         * \return
+         *    The bits of the CAN id that have to match
+        */
+        [[nodiscard]]
+        constexpr std::uint32_t getMask() const noexcept;
+
+        /**\fn matches
+         * \brief
+         *    Check if a frame with the given CAN id passes the filter, in the same way the kernel does
+         *
+         * \param[in] can_id
+         *    The CAN id of the frame including its flags
+         * \return
+         *    True if the frame passes the filter, false otherwise
+        */
+        [[nodiscard]]
+        constexpr bool matches(std::uint32_t const can_id) const noexcept;
+
+      protected:
+        std::uint32_t id_;
+        std::uint32_t mask_;
+    };
+
+    constexpr Filter::Filter(std::uint32_t const id, std::uint32_t const mask) noexcept
+    : id_{id & mask}, mask_{mask} {
+      return;
+    }
+
+    constexpr std::uint32_t Filter::getId() const noexcept {
+      return id_;
+    }
+
+    constexpr std::uint32_t Filter::getMask() const noexcept {
+      return mask_;
+    }
+
+    constexpr bool Filter::matches(std::uint32_t const can_id) const noexcept {
+      return (can_id & mask_) == id_;
+    }
+
+    /**\fn computeFilters
+     * \brief
+     *    Compute a small set of filters that lets exactly the given standard CAN ids pass. Neighbouring ids
+     *    are merged into a single filter where possible (Quine-McCluskey), so e.g. the response ids of 32
+     *    consecutive actuators require only a handful of filters instead of one per id. The filters reject
+     *    extended and remote frames.
+     *
+     * \param[in] can_ids
+     *    The 11-bit CAN ids that should pass
+     * \return
+     *    The filters covering exactly the given CAN ids
+    */
+    [[nodiscard]]
+    std::vector<Filter> computeFilters(std::vector<std::uint32_t> const& can_ids);
+
+  }
+}
+
+#endif // MYACTUATOR_RMD__CAN__FILTER
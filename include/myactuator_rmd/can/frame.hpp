@@ -34,6 +34,18 @@ namespace myactuator_rmd {
          *    The data to be transmitted to the CAN node
         */
         constexpr Frame(std::uint32_t const can_id, std::array<std::uint8_t,8> const& data) noexcept;
+
+        /**\fn Frame
+         * \brief
+         *    Class constructor copying the payload straight from a buffer, e.g. the one of a SocketCAN frame
+         *    filled by the kernel, without going through an intermediate array
+         * 
+         * \param[in] can_id
+         *    The CAN id of the message
+         * \param[in] data
+         *    The data to be transmitted to the CAN node
+        */
+        constexpr Frame(std::uint32_t const can_id, std::uint8_t const (&data)[8]) noexcept;
         Frame() = delete;
         Frame(Frame const&) = default;
         Frame& operator = (Frame const&) = default;
@@ -70,6 +82,11 @@ namespace myactuator_rmd {
       return;
     }
 
+    constexpr Frame::Frame(std::uint32_t const can_id, std::uint8_t const (&data)[8]) noexcept
+    : can_id_{can_id}, data_{data[0], data[1], data[2], data[3], data[4], data[5], data[6], data[7]} {
+      return;
+    }
+
     constexpr std::uint32_t Frame::getId() const noexcept {
       return can_id_;
     }
@@ -0,0 +1,245 @@
+/**
+ * \file io_uring.hpp
+ * \mainpage
+ *    Contains an io_uring based transport for CAN frames on a socket
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#ifndef MYACTUATOR_RMD__CAN__IO_URING
+#define MYACTUATOR_RMD__CAN__IO_URING
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include <linux/can.h>
+#include <linux/io_uring.h>
+
+
+namespace myactuator_rmd {
+  namespace can {
+
+    /**\class IoUring
+     * \brief
+     *    Transport for CAN frames of a socket based on io_uring. A (multishot) receive is kept posted at all
+     *    times on a pool of buffers provided to the kernel, so that received frames can be taken from the
+     *    completion queue without any system call. Written frames are only queued and are submitted in a
+     *    single system call together with all other pending requests, linked so that they leave in order. Frames
+     *    the kernel rejects as the queue of the network device is full keep their write buffer and are written
+     *    again together with all frames queued after them once roughly a frame time has passed.
+     *    Throws a SocketException if the kernel does not support the required io_uring features.
+    */
+    class IoUring {
+      public:
+        /**\fn IoUring
+         * \brief
+         *    Class constructor, sets up the ring for the given socket and posts the first receive
+         *
+         * \param[in] socket
+         *    The socket that frames should be read from and written to
+         * \param[in] num_buffers
+         *    The number of receive buffers and of frames that can be in flight for writing
+        */
+        IoUring(int const socket, std::uint16_t const num_buffers = 64);
+        IoUring() = delete;
+        IoUring(IoUring const&) = delete;
+        IoUring& operator = (IoUring const&) = delete;
+        IoUring(IoUring&&) = delete;
+        IoUring& operator = (IoUring&&) = delete;
+        ~IoUring();
+
+        /**\fn tryRead
+         * \brief
+         *    Take the next received frame from the completion queue without blocking
+         *
+         * \param[out] frame
+         *    The received frame
+         * \return
+         *    True if a frame was received, false otherwise
+        */
+        [[nodiscard]]
+        bool tryRead(struct ::can_frame& frame);
+
+        /**\fn tryWrite
+         * \brief
+         *    Queue a frame for writing, it is only written after the next call to \ref submit or \ref wait. Frames
+         *    rejected before are written ahead of it. Errors of the kernel writing a frame other than a full
+         *    queue of the network device are rethrown by the next call to the ring.
+         *
+         * \param[in] frame
+         *    The frame to be written
+         * \return
+         *    False if all write buffers are in flight, true if the frame was queued
+        */
+        [[nodiscard]]
+        bool tryWrite(struct ::can_frame const& frame);
+
+        /**\fn submit
+         * \brief
+         *    Submit all queued requests to the kernel without waiting
+        */
+        void submit();
+
+        /**\fn wait
+         * \brief
+         *    Submit all queued requests and wait for the kernel to complete at least one request, e.g. until a
+         *    frame was received or a written frame released its buffer. While rejected frames wait for their
+         *    retry, it returns after the retry delay at the latest.
+         *
+         * \param[in] timeout
+         *    The maximum time to wait for, zero waits indefinitely
+        */
+        void wait(std::chrono::microseconds const& timeout);
+
+        /**\fn isReadable
+         * \brief
+         *    Check if a received frame is available without blocking
+         *
+         * \return
+         *    True if a frame can be read, false otherwise
+        */
+        [[nodiscard]]
+        bool isReadable();
+
+        /**\fn isWritable
+         * \brief
+         *    Check if another frame can be queued for writing without blocking
+         *
+         * \return
+         *    True if a write buffer is available, false otherwise
+        */
+        [[nodiscard]]
+        bool isWritable();
+
+        /**\fn getNumWrittenFrames
+         * \brief
+         *    Get the number of frames the kernel confirmed to have written
+         *
+         * \return
+         *    The number of written frames
+        */
+        [[nodiscard]]
+        std::uint64_t getNumWrittenFrames() const noexcept;
+
+        /**\fn getNumRejectedWrites
+         * \brief
+         *    Get the number of times the kernel rejected writing a frame as the queue of the network device was
+         *    full, every rejected frame is written again
+         *
+         * \return
+         *    The number of rejected writes
+        */
+        [[nodiscard]]
+        std::uint64_t getNumRejectedWrites() const noexcept;
+
+        /**\fn getNumSyscalls
+         * \brief
+         *    Get the number of system calls entering the ring since its creation
+         *
+         * \return
+         *    The number of system calls
+        */
+        [[nodiscard]]
+        std::uint64_t getNumSyscalls() const noexcept;
+
+      protected:
+        // Time until frames rejected by a full queue of the network device are written again, roughly the
+        // duration of a frame at 1 Mbit/s like CanNode::frame_time
+        inline static constexpr std::chrono::microseconds retry_delay {std::chrono::microseconds(130)};
+
+        /**\fn getSqe
+         * \brief
+         *    Get the next free submission queue entry, submits the queued entries if the queue is full
+         *
+         * \return
+         *    The cleared submission queue entry
+        */
+        [[nodiscard]]
+        struct ::io_uring_sqe* getSqe();
+
+        /**\fn enter
+         * \brief
+         *    Submit the queued entries and optionally wait for completions
+         *
+         * \param[in] min_complete
+         *    The number of completions to wait for
+         * \param[in] timeout
+         *    The maximum time to wait for if waiting, zero waits indefinitely
+        */
+        void enter(unsigned const min_complete, std::chrono::microseconds const& timeout);
+
+        /**\fn reap
+         * \brief
+         *    Process all entries of the completion queue, rethrows errors of failed requests
+        */
+        void reap();
+
+        /**\fn postWrites
+         * \brief
+         *    Queue writing all pending frames as a single linked chain, unless a previous chain is still in
+         *    flight or the retry delay after a rejection has not passed yet
+        */
+        void postWrites();
+
+        /**\fn release
+         * \brief
+         *    Unmap the memory shared with the kernel and close the ring
+        */
+        void release() noexcept;
+
+        /**\fn postReceive
+         * \brief
+         *    Queue a receive that selects one of the provided buffers
+        */
+        void postReceive();
+
+        /**\fn provideBuffer
+         * \brief
+         *    Queue handing a consumed receive buffer back to the kernel
+         *
+         * \param[in] buffer
+         *    The index of the buffer
+        */
+        void provideBuffer(std::uint16_t const buffer);
+
+        int socket_;
+        int ring_;
+        void* ring_memory_;
+        std::size_t ring_memory_size_;
+        struct ::io_uring_sqe* sqes_;
+        std::size_t sqes_size_;
+        unsigned* sq_head_;
+        unsigned* sq_tail_;
+        unsigned sq_mask_;
+        unsigned sq_entries_;
+        unsigned* sq_array_;
+        unsigned* cq_head_;
+        unsigned* cq_tail_;
+        unsigned cq_mask_;
+        struct ::io_uring_cqe* cqes_;
+        unsigned num_queued_;
+        std::vector<struct ::can_frame> receive_buffers_;
+        std::deque<std::uint16_t> received_;
+        std::uint16_t num_provided_;
+        std::vector<struct ::can_frame> write_buffers_;
+        std::vector<std::uint16_t> free_write_buffers_;
+        std::deque<std::uint16_t> pending_write_buffers_;
+        std::vector<std::uint16_t> posted_write_buffers_;
+        std::vector<bool> is_write_rejected_;
+        std::size_t num_posted_writes_;
+        std::chrono::steady_clock::time_point retry_time_;
+        bool is_receive_posted_;
+        bool is_multishot_;
+        int error_;
+        std::uint64_t num_written_frames_;
+        std::uint64_t num_rejected_writes_;
+        std::uint64_t num_syscalls_;
+    };
+
+  }
+}
+
+#endif // MYACTUATOR_RMD__CAN__IO_URING
@@ -13,15 +13,29 @@
 #include <array>
 #include <chrono>
 #include <cstdint>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "myactuator_rmd/can/filter.hpp"
 #include "myactuator_rmd/can/frame.hpp"
+#include "myactuator_rmd/can/io_uring.hpp"
+#include "myactuator_rmd/can/tx_queue.hpp"
 
 
 namespace myactuator_rmd {
   namespace can {
 
+    /**\enum IoBackend
+     * \brief
+     *    Implementation used for reading and writing frames
+    */
+    enum class IoBackend {
+      READ_WRITE,
+      IO_URING
+    };
+
     /**\class Node
      *  \brief
      *     Base class for sending and receiving CAN frames over SocketCAN with a default 8*uint8 length
@@ -46,7 +60,7 @@ namespace myactuator_rmd {
              std::chrono::microseconds const& receive_timeout = std::chrono::seconds(1), bool const is_signal_errors = true);
         Node() = delete;
         Node(Node const&) = delete;
-        Node& operator = (Node const&) = default;
+        Node& operator = (Node const&) = delete;
         Node(Node&&) = default;
         Node& operator = (Node&&) = default;
         ~Node();
@@ -71,6 +85,17 @@ namespace myactuator_rmd {
         */
         void setRecvFilter(std::vector<std::uint32_t> const& can_ids, bool const is_invert = false);
 
+        /**\fn setRecvFilters
+         * \brief
+         *    Set arbitrary (id, mask) filters for receiving CAN frames, see \ref computeFilters
+         * 
+         * \param[in] filters
+         *    The filters, a frame is accepted if it passes any of them
+         * \param[in] is_join_filters
+         *    If set to true a frame is only accepted if it passes all of the filters (CAN_RAW_JOIN_FILTERS)
+        */
+        void setRecvFilters(std::vector<Filter> const& filters, bool const is_join_filters = false);
+
         /**\fn setSendTimeout
          * \brief
          *    Set socket timeout for sending frames
@@ -89,6 +114,180 @@ namespace myactuator_rmd {
         */
         void setRecvTimeout(std::chrono::microseconds const& timeout);
 
+        /**\fn setRecvBufferSize
+         * \brief
+         *    Set the size of the receive buffer of the socket. Replies arriving while the buffer is full are
+         *    dropped by the kernel. Sizes beyond net.core.rmem_max require CAP_NET_ADMIN, without it the
+         *    size is silently capped by the kernel.
+         * 
+         * \param[in] size
+         *    The requested size of the receive buffer in bytes
+        */
+        void setRecvBufferSize(int const size);
+
+        /**\fn setSendBufferSize
+         * \brief
+         *    Set the size of the send buffer of the socket. Sizes beyond net.core.wmem_max require
+         *    CAP_NET_ADMIN, without it the size is silently capped by the kernel.
+         * 
+         * \param[in] size
+         *    The requested size of the send buffer in bytes
+        */
+        void setSendBufferSize(int const size);
+
+        /**\fn getRecvBufferSize
+         * \brief
+         *    Get the size of the receive buffer of the socket as applied by the kernel
+         * 
+         * \return
+         *    The size of the receive buffer in bytes, the kernel doubles the requested size for bookkeeping
+        */
+        [[nodiscard]]
+        int getRecvBufferSize() const;
+
+        /**\fn getSendBufferSize
+         * \brief
+         *    Get the size of the send buffer of the socket as applied by the kernel
+         * 
+         * \return
+         *    The size of the send buffer in bytes, the kernel doubles the requested size for bookkeeping
+        */
+        [[nodiscard]]
+        int getSendBufferSize() const;
+
+        /**\fn setRxOverflowDetection
+         * \brief
+         *    Let the kernel report the number of frames dropped due to a full receive buffer (SO_RXQ_OVFL).
+         *    The count is attached to every received frame and can be queried with \ref getNumDroppedFrames.
+         * 
+         * \param[in] is_enabled
+         *    If set to true the drop count is reported
+        */
+        void setRxOverflowDetection(bool const is_enabled);
+
+        /**\fn setTimestamping
+         * \brief
+         *    Let the kernel attach the time it received a frame at to every frame (SO_TIMESTAMP), which can be
+         *    queried with \ref getTimestamp after the frame was read
+         * 
+         * \param[in] is_enabled
+         *    If set to true frames are timestamped by the kernel
+        */
+        void setTimestamping(bool const is_enabled);
+
+        /**\fn setBusyPoll
+         * \brief
+         *    Let \ref read spin on non-blocking receive calls for up to the given budget before it falls back to
+         *    a blocking receive. This avoids the wakeup latency of the scheduler for replies arriving shortly
+         *    after the request at the cost of fully occupying a core while waiting, the reading thread should
+         *    therefore be pinned to an isolated core, see \ref setThreadAffinity.
+         * 
+         * \param[in] spin_budget
+         *    The maximum time to spin for, zero disables spinning
+        */
+        void setBusyPoll(std::chrono::microseconds const& spin_budget);
+
+        /**\fn setKernelBusyPoll
+         * \brief
+         *    Let the kernel busy poll the network device for the given time when the socket has no frames
+         *    pending (SO_BUSY_POLL). Only has an effect for network devices supporting it and values beyond
+         *    net.core.busy_read require CAP_NET_ADMIN.
+         * 
+         * \param[in] busy_poll
+         *    The time the kernel should busy poll for, zero disables busy polling
+        */
+        void setKernelBusyPoll(std::chrono::microseconds const& busy_poll);
+
+        /**\fn setIoBackend
+         * \brief
+         *    Select the implementation used for reading and writing frames. The io_uring backend keeps a
+         *    receive posted at all times and submits batches of written frames with a single system call, it
+         *    falls back to reading and writing the socket if the kernel does not support it. Frames received
+         *    by the ring but not read yet are discarded when switching back. The kernel does not report
+         *    dropped frames to the io_uring backend.
+         * 
+         * \param[in] backend
+         *    The requested backend
+         * \return
+         *    The backend that is used from now on
+        */
+        IoBackend setIoBackend(IoBackend const backend);
+
+        /**\fn getIoBackend
+         * \brief
+         *    Get the implementation used for reading and writing frames
+         * 
+         * \return
+         *    The backend in use
+        */
+        [[nodiscard]]
+        IoBackend getIoBackend() const noexcept;
+
+        /**\fn getNumSyscalls
+         * \brief
+         *    Get the number of system calls made for reading, writing and waiting on the socket
+         * 
+         * \return
+         *    The number of system calls
+        */
+        [[nodiscard]]
+        std::uint64_t getNumSyscalls() const noexcept;
+
+        /**\fn getNumWrittenFrames
+         * \brief
+         *    Get the number of frames written successfully. With the io_uring backend only frames the kernel
+         *    already confirmed to have written are counted.
+         * 
+         * \return
+         *    The number of written frames
+        */
+        [[nodiscard]]
+        std::uint64_t getNumWrittenFrames() const noexcept;
+
+        /**\fn getNumRejectedWrites
+         * \brief
+         *    Get the number of times a frame could not be written as the transmit queue of the socket or the CAN
+         *    controller was full. The frame is not lost, it is either left to the caller or, with the io_uring
+         *    backend, written again by the ring.
+         * 
+         * \return
+         *    The number of rejected writes
+        */
+        [[nodiscard]]
+        std::uint64_t getNumRejectedWrites() const noexcept;
+
+        /**\fn getNumReadFrames
+         * \brief
+         *    Get the number of frames read including error frames
+         * 
+         * \return
+         *    The number of read frames
+        */
+        [[nodiscard]]
+        std::uint64_t getNumReadFrames() const noexcept;
+
+        /**\fn getNumDroppedFrames
+         * \brief
+         *    Get the number of frames dropped by the kernel as reported with the last frame that was read.
+         *    Always zero unless \ref setRxOverflowDetection was enabled.
+         * 
+         * \return
+         *    The number of dropped frames
+        */
+        [[nodiscard]]
+        std::uint64_t getNumDroppedFrames() const noexcept;
+
+        /**\fn getTimestamp
+         * \brief
+         *    Get the time the last frame was received at. Without \ref setTimestamping or with the io_uring
+         *    backend this is the time the frame was read at instead.
+         * 
+         * \return
+         *    The receive time of the last frame since the Unix epoch
+        */
+        [[nodiscard]]
+        std::chrono::microseconds getTimestamp() const noexcept;
+
         /**\fn setErrorFilters
          * \brief
          *    Set error filters for the socket. We will only receive error frames if we explicitly activate it!
@@ -101,7 +300,8 @@ namespace myactuator_rmd {
         /**\fn read
          * \brief
          *    Read a CAN frame in a blocking manner
-         *    Only CAN frames that a receive filter was set for can be read
+         *    Only CAN frames that a receive filter was set for can be read, throws a TimeoutException if no
+         *    frame arrives within the receive timeout
          * 
          * \return
          *    The read CAN frame
@@ -129,6 +329,62 @@ namespace myactuator_rmd {
         */
         void write(std::uint32_t const can_id, std::array<std::uint8_t,8> const& data);
 
+        /**\fn tryWrite
+         * \brief
+         *    Write the given CAN frame without blocking
+         * 
+         * \param[in] frame
+         *    The CAN frame to be written
+         * \return
+         *    False if the frame could not be written as the transmit queue of the socket or the CAN controller
+         *    is full, true if it was written
+        */
+        [[nodiscard]]
+        bool tryWrite(Frame const& frame);
+
+        /**\fn tryWrite
+         * \brief
+         *    Write the given data to a CAN frame with the corresponding can_id without blocking
+         * 
+         * \param[in] can_id
+         *   The CAN id that the data should be sent to
+         * \param[in] data
+         *    The data to be sent
+         * \return
+         *    False if the frame could not be written as the transmit queue of the socket or the CAN controller
+         *    is full, true if it was written
+        */
+        [[nodiscard]]
+        bool tryWrite(std::uint32_t const can_id, std::array<std::uint8_t,8> const& data);
+
+        /**\fn flush
+         * \brief
+         *    Write the pending frames of the queue in the order of their priority until the socket would block.
+         *    Consecutive frames are handed to the kernel with a single system call so that they leave back-to-back.
+         * 
+         * \param[in,out] queue
+         *    The queue whose frames should be written, written frames are removed from it
+         * \return
+         *    The number of frames that were written
+        */
+        std::size_t flush(TxQueue& queue);
+
+        /**\fn wait
+         * \brief
+         *    Wait until a frame can be read or written
+         * 
+         * \param[in] is_read
+         *    Wait for a frame to be readable
+         * \param[in] is_write
+         *    Wait for the socket to accept another frame
+         * \param[in] timeout
+         *    The maximum time to wait for, zero waits indefinitely in the same way as the socket timeouts
+         * \return
+         *    Flags indicating whether the socket is readable and writable, both are false after a timeout
+        */
+        [[nodiscard]]
+        std::pair<bool,bool> wait(bool const is_read, bool const is_write, std::chrono::microseconds const& timeout) const;
+
       protected:
         /**\fn initSocket
          * \brief
@@ -139,6 +395,24 @@ namespace myactuator_rmd {
         */
         void initSocket(std::string const& ifname);
 
+        /**\fn readSocket
+         * \brief
+         *    Read a CAN frame from the socket, spinning for the spin budget before blocking
+         * 
+         * \param[out] frame
+         *    The read CAN frame
+        */
+        void readSocket(struct ::can_frame& frame) const;
+
+        /**\fn readIoUring
+         * \brief
+         *    Take a CAN frame from the ring, spinning for the spin budget before blocking
+         * 
+         * \param[out] frame
+         *    The read CAN frame
+        */
+        void readIoUring(struct ::can_frame& frame) const;
+
         /**\fn closeSocket
          * \brief
          *    Close the underlying socket
@@ -147,6 +421,16 @@ namespace myactuator_rmd {
 
         std::string ifname_;
         int socket_;
+        std::chrono::microseconds send_timeout_;
+        std::chrono::microseconds receive_timeout_;
+        std::chrono::microseconds spin_budget_;
+        std::unique_ptr<IoUring> io_uring_;
+        std::uint64_t num_written_frames_;
+        std::uint64_t num_rejected_writes_;
+        mutable std::uint64_t num_read_frames_;
+        mutable std::uint64_t num_dropped_frames_;
+        mutable std::chrono::microseconds timestamp_;
+        mutable std::uint64_t num_syscalls_;
     };
 
   }
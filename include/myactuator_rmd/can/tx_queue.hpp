@@ -0,0 +1,130 @@
+/**
+ * \file tx_queue.hpp
+ * \mainpage
+ *    Contains a user-space transmit queue ordering pending CAN frames by priority
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#ifndef MYACTUATOR_RMD__CAN__TX_QUEUE
+#define MYACTUATOR_RMD__CAN__TX_QUEUE
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <deque>
+
+#include "myactuator_rmd/can/frame.hpp"
+
+
+namespace myactuator_rmd {
+  namespace can {
+
+    /**\enum TxPriority
+     * \brief
+     *    Priority of a frame waiting for transmission, lower values are sent first
+    */
+    enum class TxPriority: std::uint8_t {
+      CONTROL = 0,
+      TELEMETRY = 1
+    };
+
+    /**\class TxQueue
+     * \brief
+     *    Frames that could not be written yet as the transmit queue of the CAN controller was full. Frames of
+     *    a higher priority are always handed out first, frames of the same priority in the order they were
+     *    pushed. The queue is bounded so that a stalled bus results in backpressure instead of unbounded
+     *    growth.
+    */
+    class TxQueue {
+      public:
+        /**\fn TxQueue
+         * \brief
+         *    Class constructor
+         *
+         * \param[in] max_size
+         *    The maximum number of pending frames over all priorities
+        */
+        TxQueue(std::size_t const max_size = 256);
+        TxQueue(TxQueue const&) = default;
+        TxQueue& operator = (TxQueue const&) = default;
+        TxQueue(TxQueue&&) = default;
+        TxQueue& operator = (TxQueue&&) = default;
+
+        /**\fn push
+         * \brief
+         *    Enqueue a frame for transmission
+         *
+         * \param[in] frame
+         *    The frame to be sent
+         * \param[in] priority
+         *    The priority of the frame
+         * \return
+         *    False if the queue is full and the frame was not enqueued, true otherwise
+        */
+        [[nodiscard]]
+        bool push(Frame const& frame, TxPriority const priority = TxPriority::TELEMETRY);
+
+        /**\fn front
+         * \brief
+         *    Get the frame that should be sent next, the queue must not be empty
+         *
+         * \return
+         *    The pending frame with the highest priority
+        */
+        [[nodiscard]]
+        Frame const& front() const;
+
+        /**\fn peek
+         * \brief
+         *    Get a pending frame by its position in the order in which the frames are sent
+         *
+         * \param[in] i
+         *    The position of the frame, zero corresponds to \ref front
+         * \return
+         *    The pending frame at the given position
+        */
+        [[nodiscard]]
+        Frame const& peek(std::size_t const i) const;
+
+        /**\fn pop
+         * \brief
+         *    Remove the frame returned by \ref front after it was written, the queue must not be empty
+        */
+        void pop();
+
+        /**\fn clear
+         * \brief
+         *    Discard all pending frames
+        */
+        void clear() noexcept;
+
+        /**\fn size
+         * \brief
+         *    Get the number of pending frames
+         *
+         * \return
+         *    The number of pending frames over all priorities
+        */
+        [[nodiscard]]
+        std::size_t size() const noexcept;
+
+        /**\fn empty
+         * \brief
+         *    Check if there are no pending frames
+         *
+         * \return
+         *    True if no frame is pending, false otherwise
+        */
+        [[nodiscard]]
+        bool empty() const noexcept;
+
+      protected:
+        std::size_t max_size_;
+        std::array<std::deque<Frame>,2> frames_;
+    };
+
+  }
+}
+
+#endif // MYACTUATOR_RMD__CAN__TX_QUEUE
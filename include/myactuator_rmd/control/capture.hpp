@@ -0,0 +1,232 @@
+/**
+ * \file capture.hpp
+ * \mainpage
+ *    Contains the capture of raw feedback frames of an excited actuator for system identification
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#ifndef MYACTUATOR_RMD__CONTROL__CAPTURE
+#define MYACTUATOR_RMD__CONTROL__CAPTURE
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include "myactuator_rmd/driver/driver.hpp"
+#include "myactuator_rmd/driver/replay_driver.hpp"
+#include "myactuator_rmd/driver/transfer.hpp"
+
+
+namespace myactuator_rmd {
+
+  /**\enum CaptureMode
+   * \brief
+   *    Strongly typed enum for the set-point the excitation is applied to
+  */
+  enum class CaptureMode {
+    CURRENT,
+    VELOCITY,
+    POSITION
+  };
+
+  /**\enum ExcitationSignal
+   * \brief
+   *    Strongly typed enum for the shape of the excitation
+  */
+  enum class ExcitationSignal {
+    SINE,
+    CHIRP,
+    SQUARE
+  };
+
+  /**\class CaptureData
+   * \brief
+   *    Decoded samples of a capture in columns, one element per sample
+  */
+  class CaptureData {
+    public:
+      CaptureData() = default;
+      CaptureData(CaptureData const&) = default;
+      CaptureData& operator = (CaptureData const&) = default;
+      CaptureData(CaptureData&&) = default;
+      CaptureData& operator = (CaptureData&&) = default;
+
+      std::vector<double> time;
+      std::vector<float> setpoint;
+      std::vector<float> temperature;
+      std::vector<float> current;
+      std::vector<float> velocity;
+      std::vector<float> position;
+  };
+
+  /**\class Capture
+   * \brief
+   *    Drives a single actuator with an excitation and records the raw request and reply frames of every
+   *    sample into a ring buffer allocated on construction, overwriting the oldest samples once it is full.
+   *    Replies carry the receive time stamped by the kernel if the driver supports it (see
+   *    CanDriver::setTimestamping). Nothing is decoded while capturing, the frames are only decoded on export.
+  */
+  class Capture {
+    public:
+      /**\fn Capture
+       * \brief
+       *    Class constructor
+       *
+       * \param[in] driver
+       *    The driver communicating over the network interface
+       * \param[in] actuator_id
+       *    The id of the actuator to be excited
+       * \param[in] capacity
+       *    The maximum number of samples that are kept
+      */
+      Capture(Driver& driver, std::uint32_t const actuator_id, std::size_t const capacity = 65536);
+      Capture() = delete;
+      Capture(Capture const&) = delete;
+      Capture& operator = (Capture const&) = delete;
+      Capture(Capture&&) = delete;
+      Capture& operator = (Capture&&) = delete;
+
+      /**\fn run
+       * \brief
+       *    Excite the actuator and record its replies for the given duration. Replies that do not arrive within
+       *    the receive timeout of the driver are counted and skipped. The actuator is stopped afterwards, also if
+       *    the capture is aborted by an exception.
+       *
+       * \param[in] duration
+       *    The duration of the excitation
+       * \param[in] period
+       *    The period between two consecutive set-points, zero sends the next set-point as soon as the reply to
+       *    the previous one arrived
+       * \return
+       *    The number of samples recorded
+      */
+      std::size_t run(std::chrono::microseconds const& duration,
+                      std::chrono::microseconds const& period = std::chrono::microseconds(0));
+
+      /**\fn getSetpoint
+       * \brief
+       *    Evaluate the excitation
+       *
+       * \param[in] time
+       *    The time since the start of the excitation
+       * \param[in] duration
+       *    The duration of the whole excitation that a chirp sweeps its frequency over
+       * \return
+       *    The set-point in Ampere, degrees per second or degrees depending on the mode
+      */
+      [[nodiscard]]
+      float getSetpoint(std::chrono::microseconds const& time, std::chrono::microseconds const& duration) const noexcept;
+
+      /**\fn clear
+       * \brief
+       *    Discard all recorded samples
+      */
+      void clear() noexcept;
+
+      /**\fn size
+       * \brief
+       *    Get the number of samples in the ring buffer
+       *
+       * \return
+       *    The number of samples
+      */
+      [[nodiscard]]
+      std::size_t size() const noexcept;
+
+      /**\fn getNumOverwritten
+       * \brief
+       *    Get the number of samples that were overwritten because the ring buffer was full
+       *
+       * \return
+       *    The number of overwritten samples
+      */
+      [[nodiscard]]
+      std::uint64_t getNumOverwritten() const noexcept;
+
+      /**\fn getNumTimeouts
+       * \brief
+       *    Get the number of set-points whose reply did not arrive
+       *
+       * \return
+       *    The number of missing replies
+      */
+      [[nodiscard]]
+      std::uint64_t getNumTimeouts() const noexcept;
+
+      /**\fn getFrames
+       * \brief
+       *    Get the recorded request and reply frames in the order they were exchanged, e.g. for replaying them
+       *    with a ReplayDriver. Requests are stamped with the time they were handed to the driver.
+       *
+       * \return
+       *    The raw frames of all samples in the ring buffer
+      */
+      [[nodiscard]]
+      std::vector<RecordedFrame> getFrames() const;
+
+      /**\fn decode
+       * \brief
+       *    Decode the samples in the ring buffer
+       *
+       * \return
+       *    The columns of the samples with the time in seconds since the first reply
+      */
+      [[nodiscard]]
+      CaptureData decode() const;
+
+      /**\fn writeCsv
+       * \brief
+       *    Write the decoded samples as comma-separated values with a header line
+       *
+       * \param[in,out] os
+       *    The output stream the samples should be written to
+      */
+      void writeCsv(std::ostream& os) const;
+
+      /**\fn writeBinary
+       * \brief
+       *    Write the raw frames in the binary format that can be read with \ref readBinaryLog
+       *
+       * \param[in,out] os
+       *    The output stream the frames should be written to
+      */
+      void writeBinary(std::ostream& os) const;
+
+      CaptureMode mode;
+      ExcitationSignal signal;
+      float offset;
+      float amplitude;
+      float frequency;
+      float end_frequency;
+      float max_speed;
+
+    protected:
+      /**\fn getRequest
+       * \brief
+       *    Serialise the request for a set-point
+       *
+       * \param[in] setpoint
+       *    The set-point in Ampere, degrees per second or degrees depending on the mode
+       * \return
+       *    The serialised request
+      */
+      [[nodiscard]]
+      std::array<std::uint8_t,8> getRequest(float const setpoint) const;
+
+      Driver& driver_;
+      std::vector<Transfer> transfers_;
+      std::vector<RecordedFrame> requests_;
+      std::vector<RecordedFrame> replies_;
+      std::size_t head_;
+      std::size_t size_;
+      std::uint64_t num_overwritten_;
+      std::uint64_t num_timeouts_;
+  };
+
+}
+
+#endif // MYACTUATOR_RMD__CONTROL__CAPTURE
@@ -0,0 +1,256 @@
+/**
+ * \file compensation.hpp
+ * \mainpage
+ *    Contains the per-actuator compensation of cogging and friction torques
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#ifndef MYACTUATOR_RMD__CONTROL__COMPENSATION
+#define MYACTUATOR_RMD__CONTROL__COMPENSATION
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "myactuator_rmd/actuator_state/motion_control_status.hpp"
+#include "myactuator_rmd/control/controller.hpp"
+
+
+namespace myactuator_rmd {
+
+  /**\class FrictionModel
+   * \brief
+   *    Friction torque of an actuator as a function of its output shaft velocity, made up of Coulomb, Stribeck
+   *    and viscous friction
+  */
+  class FrictionModel {
+    public:
+      /**\fn FrictionModel
+       * \brief
+       *    Class constructor
+       *
+       * \param[in] coulomb_
+       *    The Coulomb friction in Nm
+       * \param[in] static_friction_
+       *    The friction at standstill in Nm, decays to the Coulomb friction with the Stribeck velocity
+       * \param[in] stribeck_speed_
+       *    The Stribeck velocity in degree per second
+       * \param[in] viscous_
+       *    The viscous friction in Nm per degree per second
+      */
+      constexpr FrictionModel(float const coulomb_ = 0.0f, float const static_friction_ = 0.0f,
+                              float const stribeck_speed_ = 1.0f, float const viscous_ = 0.0f) noexcept;
+      FrictionModel(FrictionModel const&) = default;
+      FrictionModel& operator = (FrictionModel const&) = default;
+      FrictionModel(FrictionModel&&) = default;
+      FrictionModel& operator = (FrictionModel&&) = default;
+
+      /**\fn getTorque
+       * \brief
+       *    Evaluate the friction model
+       *
+       * \param[in] speed
+       *    The output shaft velocity in degree per second
+       * \return
+       *    The torque in Nm that overcomes the friction at this velocity
+      */
+      [[nodiscard]]
+      float getTorque(float const speed) const noexcept;
+
+      float coulomb;
+      float static_friction;
+      float stribeck_speed;
+      float viscous;
+  };
+
+  constexpr FrictionModel::FrictionModel(float const coulomb_, float const static_friction_, float const stribeck_speed_,
+                                         float const viscous_) noexcept
+  : coulomb{coulomb_}, static_friction{static_friction_}, stribeck_speed{stribeck_speed_}, viscous{viscous_} {
+    return;
+  }
+
+  /**\class Compensation
+   * \brief
+   *    Compensation of the cogging and friction torques of a single actuator. The cogging torque is tabulated
+   *    over one revolution of the single-turn encoder and the friction model is sampled once into a table over
+   *    the velocity range, so that both are looked up with a single linear interpolation. Velocities beyond the
+   *    table only extrapolate the viscous friction. Around standstill the friction is blended linearly over a
+   *    single entry of the table instead of switching its sign.
+  */
+  class Compensation {
+    public:
+      /**\fn Compensation
+       * \brief
+       *    Class constructor, initialises both tables to zero
+       *
+       * \param[in] encoder_range
+       *    The number of counts of the single-turn encoder per revolution
+       * \param[in] max_speed
+       *    The largest output shaft velocity in degree per second that the friction table covers
+       * \param[in] num_friction_bins
+       *    The number of entries of the friction table, an odd number keeps an entry at standstill
+      */
+      Compensation(std::uint32_t const encoder_range = 65536, float const max_speed = 720.0f,
+                   std::size_t const num_friction_bins = 1025);
+      Compensation(Compensation const&) = default;
+      Compensation& operator = (Compensation const&) = default;
+      Compensation(Compensation&&) = default;
+      Compensation& operator = (Compensation&&) = default;
+
+      /**\fn getEncoderRange
+       * \brief
+       *    Get the range of the single-turn encoder
+       *
+       * \return
+       *    The number of counts of the single-turn encoder per revolution
+      */
+      [[nodiscard]]
+      std::uint32_t getEncoderRange() const noexcept;
+
+      /**\fn setCoggingTable
+       * \brief
+       *    Set the cogging torques, throws a ValueRangeException if the table is empty
+       *
+       * \param[in] torques
+       *    The cogging torques in Nm at equally spaced encoder positions over one revolution starting at zero
+      */
+      void setCoggingTable(std::vector<float> const& torques);
+
+      /**\fn getCoggingTable
+       * \brief
+       *    Get the cogging torques
+       *
+       * \return
+       *    The cogging torques in Nm at equally spaced encoder positions over one revolution starting at zero
+      */
+      [[nodiscard]]
+      std::vector<float> getCoggingTable() const;
+
+      /**\fn setFrictionModel
+       * \brief
+       *    Set the friction model and sample it into the friction table
+       *
+       * \param[in] model
+       *    The friction model of the actuator
+      */
+      void setFrictionModel(FrictionModel const& model) noexcept;
+
+      /**\fn getFrictionModel
+       * \brief
+       *    Get the friction model
+       *
+       * \return
+       *    The friction model of the actuator
+      */
+      [[nodiscard]]
+      FrictionModel const& getFrictionModel() const noexcept;
+
+      /**\fn setEncoderReference
+       * \brief
+       *    Relate the single-turn encoder to the output shaft angle so that the encoder position can be estimated
+       *    from the output shaft angle, e.g. from the feedback to motion control commands
+       *
+       * \param[in] encoder_position
+       *    The single-turn encoder position as returned by ActuatorInterface::getSingleTurnEncoderPosition
+       * \param[in] shaft_angle
+       *    The output shaft angle in degree at this encoder position
+       * \param[in] reducer_ratio
+       *    The reducer ratio of the actuator, refer to actuator_constants.hpp
+      */
+      void setEncoderReference(std::int16_t const encoder_position, float const shaft_angle, float const reducer_ratio) noexcept;
+
+      /**\fn getEncoderPosition
+       * \brief
+       *    Estimate the single-turn encoder position from the output shaft angle
+       *
+       * \param[in] shaft_angle
+       *    The output shaft angle in degree
+       * \return
+       *    The encoder position in counts
+      */
+      [[nodiscard]]
+      float getEncoderPosition(float const shaft_angle) const noexcept;
+
+      /**\fn getCoggingTorque
+       * \brief
+       *    Interpolate the cogging torque
+       *
+       * \param[in] encoder_position
+       *    The single-turn encoder position in counts, wrapped around to a single revolution
+       * \return
+       *    The cogging torque in Nm
+      */
+      [[nodiscard]]
+      float getCoggingTorque(float const encoder_position) const noexcept;
+
+      /**\fn getFrictionTorque
+       * \brief
+       *    Interpolate the friction torque
+       *
+       * \param[in] speed
+       *    The output shaft velocity in degree per second
+       * \return
+       *    The friction torque in Nm
+      */
+      [[nodiscard]]
+      float getFrictionTorque(float const speed) const noexcept;
+
+      /**\fn getTorque
+       * \brief
+       *    Get the torque that compensates both cogging and friction
+       *
+       * \param[in] encoder_position
+       *    The single-turn encoder position in counts
+       * \param[in] speed
+       *    The output shaft velocity in degree per second
+       * \return
+       *    The torque in Nm to be added to the desired torque
+      */
+      [[nodiscard]]
+      float getTorque(float const encoder_position, float const speed) const noexcept;
+
+    protected:
+      std::uint32_t encoder_range_;
+      float max_speed_;
+      std::vector<float> cogging_;
+      float cogging_scale_;
+      FrictionModel friction_model_;
+      std::vector<float> friction_;
+      float friction_scale_;
+      float reference_encoder_;
+      double reference_angle_;
+      double counts_per_degree_;
+  };
+
+  /**\class CompensationController
+   * \brief
+   *    Controller adding the compensation torques of every actuator of a group to the feedforward torque of its
+   *    motion control commands. The cogging torque is looked up at the encoder position estimated from the last
+   *    feedback, which requires the encoder reference to be set, and the friction at the desired velocity.
+  */
+  class CompensationController: public Controller {
+    public:
+      /**\fn CompensationController
+       * \brief
+       *    Class constructor
+       *
+       * \param[in] compensations
+       *    The compensation of every actuator of the group
+      */
+      CompensationController(std::vector<Compensation> const& compensations);
+      CompensationController() = delete;
+      CompensationController(CompensationController const&) = default;
+      CompensationController& operator = (CompensationController const&) = default;
+      CompensationController(CompensationController&&) = default;
+      CompensationController& operator = (CompensationController&&) = default;
+
+      void update(std::vector<MotionControlStatus> const& status, std::vector<MotionControlCommand>& command) override;
+
+    protected:
+      std::vector<Compensation> compensations_;
+  };
+
+}
+
+#endif // MYACTUATOR_RMD__CONTROL__COMPENSATION
@@ -0,0 +1,147 @@
+/**
+ * \file compensation_calibration.hpp
+ * \mainpage
+ *    Contains the calibration of the cogging and friction compensation of an actuator
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#ifndef MYACTUATOR_RMD__CONTROL__COMPENSATION_CALIBRATION
+#define MYACTUATOR_RMD__CONTROL__COMPENSATION_CALIBRATION
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "myactuator_rmd/control/compensation.hpp"
+#include "myactuator_rmd/control/periodic_rate.hpp"
+#include "myactuator_rmd/actuator_interface.hpp"
+
+
+namespace myactuator_rmd {
+
+  /**\class CompensationCalibration
+   * \brief
+   *    Calibrates the compensation of an actuator by turning it at constant velocities and measuring the torque
+   *    it takes from its current. The actuator has to be able to turn freely without load. The friction is
+   *    identified from the torques at different velocities in both directions, and the cogging torque from the
+   *    torques over one revolution of the encoder turning slowly in both directions, where averaging both
+   *    directions cancels the friction. The Stribeck effect is not identified, the static friction is set to
+   *    the Coulomb friction. A velocity of zero is commanded at the end of every calibration, also if it is
+   *    aborted by an exception.
+  */
+  class CompensationCalibration {
+    public:
+      /**\fn CompensationCalibration
+       * \brief
+       *    Class constructor
+       *
+       * \param[in] actuator
+       *    The actuator to be calibrated
+       * \param[in] torque_constant
+       *    The torque constant of the actuator in Nm/A, refer to actuator_constants.hpp
+       * \param[in] period
+       *    The period between two consecutive velocity set-points
+      */
+      CompensationCalibration(ActuatorInterface& actuator, float const torque_constant,
+                              std::chrono::microseconds const& period = std::chrono::milliseconds(2));
+      CompensationCalibration() = delete;
+      CompensationCalibration(CompensationCalibration const&) = delete;
+      CompensationCalibration& operator = (CompensationCalibration const&) = delete;
+      CompensationCalibration(CompensationCalibration&&) = delete;
+      CompensationCalibration& operator = (CompensationCalibration&&) = delete;
+
+      /**\fn calibrateFriction
+       * \brief
+       *    Identify the Coulomb and viscous friction with a least-squares fit and set the friction model of the
+       *    compensation, throws a ValueRangeException if less than two different velocities are given
+       *
+       * \param[in,out] compensation
+       *    The compensation whose friction model is set
+       * \param[in] speeds
+       *    The output shaft velocities in degree per second that the actuator is turned with in both directions
+       * \param[in] num_samples
+       *    The number of samples the torque is averaged over at every velocity
+       * \return
+       *    The identified friction model
+      */
+      FrictionModel calibrateFriction(Compensation& compensation, std::vector<float> const& speeds, std::size_t const num_samples = 500);
+
+      /**\fn calibrateCogging
+       * \brief
+       *    Record the cogging torque and set the cogging table and the encoder reference of the compensation.
+       *    Entries of the table that no sample fell into are interpolated from their neighbours.
+       *
+       * \param[in,out] compensation
+       *    The compensation whose cogging table is set
+       * \param[in] speed
+       *    The output shaft velocity in degree per second that the actuator is turned with in both directions
+       * \param[in] reducer_ratio
+       *    The reducer ratio of the actuator, refer to actuator_constants.hpp
+       * \param[in] num_bins
+       *    The number of entries of the cogging table
+       * \return
+       *    The cogging table in Nm
+      */
+      std::vector<float> calibrateCogging(Compensation& compensation, float const speed, float const reducer_ratio,
+                                          std::size_t const num_bins = 512);
+
+      /**\fn calibrate
+       * \brief
+       *    Calibrate both the friction and the cogging of the compensation
+       *
+       * \param[in,out] compensation
+       *    The compensation to be calibrated
+       * \param[in] speeds
+       *    The output shaft velocities in degree per second for calibrating the friction
+       * \param[in] cogging_speed
+       *    The output shaft velocity in degree per second for calibrating the cogging
+       * \param[in] reducer_ratio
+       *    The reducer ratio of the actuator, refer to actuator_constants.hpp
+      */
+      void calibrate(Compensation& compensation, std::vector<float> const& speeds, float const cogging_speed,
+                     float const reducer_ratio);
+
+      /**\fn getNumOverruns
+       * \brief
+       *    Get the number of periods in which a set-point was sent late
+       *
+       * \return
+       *    The number of overruns
+      */
+      [[nodiscard]]
+      std::uint64_t getNumOverruns() const noexcept;
+
+      std::size_t num_settling_samples;
+
+    protected:
+      /**\fn measureTorque
+       * \brief
+       *    Turn the actuator with a constant velocity and average the torque after it settled
+       *
+       * \param[in] speed
+       *    The output shaft velocity in degree per second
+       * \param[in] num_samples
+       *    The number of samples the torque is averaged over
+       * \return
+       *    The average torque in Nm
+      */
+      float measureTorque(float const speed, std::size_t const num_samples);
+
+      /**\fn wait
+       * \brief
+       *    Wait until the next period
+      */
+      void wait();
+
+      ActuatorInterface& actuator_;
+      float torque_constant_;
+      std::chrono::microseconds period_;
+      PeriodicRate rate_;
+      std::uint64_t overruns_;
+  };
+
+}
+
+#endif // MYACTUATOR_RMD__CONTROL__COMPENSATION_CALIBRATION
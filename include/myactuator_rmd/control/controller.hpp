@@ -0,0 +1,91 @@
+/**
+ * \file controller.hpp
+ * \mainpage
+ *    Contains the interface for host-side controllers evaluated by the streamer every period
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#ifndef MYACTUATOR_RMD__CONTROL__CONTROLLER
+#define MYACTUATOR_RMD__CONTROL__CONTROLLER
+#pragma once
+
+#include <vector>
+
+#include "myactuator_rmd/actuator_state/motion_control_status.hpp"
+
+
+namespace myactuator_rmd {
+
+  /**\class MotionControlCommand
+   * \brief
+   *    The arguments of a motion control command (0x400) for a single actuator
+  */
+  class MotionControlCommand {
+    public:
+      /**\fn MotionControlCommand
+       * \brief
+       *    Class constructor
+       *
+       * \param[in] p_des_
+       *    Desired position [-12.5, 12.5] rad
+       * \param[in] v_des_
+       *    Desired velocity [-45.0, 45.0] rad/s
+       * \param[in] kp_
+       *    Position gain [0, 500]
+       * \param[in] kd_
+       *    Velocity gain [0, 5]
+       * \param[in] t_ff_
+       *    Feedforward torque [-24.0, 24.0] Nm
+      */
+      constexpr MotionControlCommand(float const p_des_ = 0.0f, float const v_des_ = 0.0f, float const kp_ = 0.0f,
+                                     float const kd_ = 0.0f, float const t_ff_ = 0.0f) noexcept;
+      MotionControlCommand(MotionControlCommand const&) = default;
+      MotionControlCommand& operator = (MotionControlCommand const&) = default;
+      MotionControlCommand(MotionControlCommand&&) = default;
+      MotionControlCommand& operator = (MotionControlCommand&&) = default;
+
+      float p_des;
+      float v_des;
+      float kp;
+      float kd;
+      float t_ff;
+  };
+
+  constexpr MotionControlCommand::MotionControlCommand(float const p_des_, float const v_des_, float const kp_,
+                                                       float const kd_, float const t_ff_) noexcept
+  : p_des{p_des_}, v_des{v_des_}, kp{kp_}, kd{kd_}, t_ff{t_ff_} {
+    return;
+  }
+
+  /**\class Controller
+   * \brief
+   *    Pure abstract base class for host-side controllers, e.g. gravity compensation or coupling between
+   *    joints. A controller attached to a TrajectoryStreamer is evaluated by the streaming thread right before
+   *    every motion control command and may modify the set-points of the current sample in place.
+  */
+  class Controller {
+    public:
+      Controller() = default;
+      Controller(Controller const&) = default;
+      Controller& operator = (Controller const&) = default;
+      Controller(Controller&&) = default;
+      Controller& operator = (Controller&&) = default;
+      virtual ~Controller() = default;
+
+      /**\fn update
+       * \brief
+       *    Compute the commands of the next period. Called from the streaming thread, it should neither
+       *    allocate nor block. Both arrays hold one element per actuator of the group and must not be resized.
+       *
+       * \param[in] status
+       *    The feedback of all actuators to the previous command, zero before the first reply was received
+       * \param[in,out] command
+       *    The commands of the current sample, to be modified in place
+      */
+      virtual void update(std::vector<MotionControlStatus> const& status, std::vector<MotionControlCommand>& command) = 0;
+  };
+
+}
+
+#endif // MYACTUATOR_RMD__CONTROL__CONTROLLER
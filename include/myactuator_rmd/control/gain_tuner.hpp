@@ -0,0 +1,163 @@
+/**
+ * \file gain_tuner.hpp
+ * \mainpage
+ *    Contains an automatic tuner of single controller gains based on step responses
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#ifndef MYACTUATOR_RMD__CONTROL__GAIN_TUNER
+#define MYACTUATOR_RMD__CONTROL__GAIN_TUNER
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include "myactuator_rmd/actuator_state/gain_type.hpp"
+#include "myactuator_rmd/control/step_response.hpp"
+#include "myactuator_rmd/actuator_interface.hpp"
+
+
+namespace myactuator_rmd {
+
+  /**\enum ExcitationType
+   * \brief
+   *    Strongly typed enum for the set-point that is stepped to excite the actuator
+  */
+  enum class ExcitationType {
+    POSITION_STEP,
+    VELOCITY_STEP
+  };
+
+  /**\class GainTuner
+   * \brief
+   *    Tunes a single controller gain of an actuator by exciting it with steps of its set-point. Every
+   *    experiment commands the step and samples the feedback once per period, analysing it on the fly, and then
+   *    commands the set-point from before the step again for as many periods to return to the initial state.
+   *    The gain is searched with a golden-section search that minimises the integral of the absolute error
+   *    plus the weighted overshoot, which assumes that the cost has a single minimum within the given range.
+  */
+  class GainTuner {
+    public:
+      /**\fn GainTuner
+       * \brief
+       *    Class constructor
+       *
+       * \param[in] actuator
+       *    The actuator to be tuned
+       * \param[in] type
+       *    The set-point that is stepped
+       * \param[in] amplitude
+       *    The height of the step in degrees for position steps and in degrees per second for velocity steps
+       * \param[in] period
+       *    The period between two consecutive samples of the feedback
+       * \param[in] num_samples
+       *    The number of samples recorded after every step
+      */
+      GainTuner(ActuatorInterface& actuator, ExcitationType const type, float const amplitude,
+                std::chrono::microseconds const& period = std::chrono::milliseconds(2), std::size_t const num_samples = 500);
+      GainTuner() = delete;
+      GainTuner(GainTuner const&) = delete;
+      GainTuner& operator = (GainTuner const&) = delete;
+      GainTuner(GainTuner&&) = delete;
+      GainTuner& operator = (GainTuner&&) = delete;
+
+      /**\fn runStep
+       * \brief
+       *    Run a single experiment with the gains currently set on the actuator
+       *
+       * \return
+       *    The analysed step response, valid until the next experiment
+      */
+      StepResponse const& runStep();
+
+      /**\fn evaluate
+       * \brief
+       *    Set a gain on the actuator and run a single experiment with it
+       *
+       * \param[in] gain_type
+       *    The gain to be set
+       * \param[in] gain
+       *    The value of the gain
+       * \return
+       *    The cost of the resulting step response
+      */
+      float evaluate(GainType const gain_type, float const gain);
+
+      /**\fn tune
+       * \brief
+       *    Search the gain with the lowest cost within the given range and set it on the actuator
+       *
+       * \param[in] gain_type
+       *    The gain to be tuned
+       * \param[in] min_gain
+       *    The lower bound of the gain
+       * \param[in] max_gain
+       *    The upper bound of the gain
+       * \param[in] num_experiments
+       *    The number of experiments the search may run, at least two
+       * \return
+       *    The best gain that was found
+      */
+      float tune(GainType const gain_type, float const min_gain, float const max_gain, std::size_t const num_experiments = 12);
+
+      /**\fn getCost
+       * \brief
+       *    Compute the cost of a step response
+       *
+       * \param[in] response
+       *    The analysed step response
+       * \return
+       *    The integral of the absolute error plus the weighted overshoot
+      */
+      [[nodiscard]]
+      float getCost(StepResponse const& response) const noexcept;
+
+      /**\fn getNumExperiments
+       * \brief
+       *    Get the number of experiments run so far
+       *
+       * \return
+       *    The number of experiments
+      */
+      [[nodiscard]]
+      std::size_t getNumExperiments() const noexcept;
+
+      /**\fn getNumOverruns
+       * \brief
+       *    Get the number of periods in which a sample was taken late
+       *
+       * \return
+       *    The number of overruns
+      */
+      [[nodiscard]]
+      std::uint64_t getNumOverruns() const noexcept;
+
+      float overshoot_weight;
+      float max_speed;
+
+    protected:
+      /**\fn command
+       * \brief
+       *    Command the set-point of the excitation
+       *
+       * \param[in] setpoint
+       *    The set-point in degrees or degrees per second
+       * \return
+       *    The position or velocity of the feedback
+      */
+      float command(float const setpoint);
+
+      ActuatorInterface& actuator_;
+      ExcitationType type_;
+      float amplitude_;
+      std::chrono::microseconds period_;
+      std::size_t num_samples_;
+      StepResponse response_;
+      std::size_t num_experiments_;
+      std::uint64_t overruns_;
+  };
+
+}
+
+#endif // MYACTUATOR_RMD__CONTROL__GAIN_TUNER
@@ -0,0 +1,72 @@
+/**
+ * \file periodic_rate.hpp
+ * \mainpage
+ *    Contains a helper for running a loop at a fixed rate
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#ifndef MYACTUATOR_RMD__CONTROL__PERIODIC_RATE
+#define MYACTUATOR_RMD__CONTROL__PERIODIC_RATE
+#pragma once
+
+#include <chrono>
+
+
+namespace myactuator_rmd {
+
+  /**\class PeriodicRate
+   * \brief
+   *    Sleeps until the next period of a fixed grid starting at construction or the last reset. A period that
+   *    cannot be kept does not have to be caught up on, instead the grid is restarted from the current time as
+   *    catching up would result in a burst of commands.
+  */
+  class PeriodicRate {
+    public:
+      /**\fn PeriodicRate
+       * \brief
+       *    Class constructor
+       *
+       * \param[in] period
+       *    The period of the loop, zero for not sleeping at all
+      */
+      PeriodicRate(std::chrono::microseconds const& period);
+      PeriodicRate() = delete;
+      PeriodicRate(PeriodicRate const&) = default;
+      PeriodicRate& operator = (PeriodicRate const&) = default;
+      PeriodicRate(PeriodicRate&&) = default;
+      PeriodicRate& operator = (PeriodicRate&&) = default;
+
+      /**\fn reset
+       * \brief
+       *    Start the grid at the current time
+      */
+      void reset() noexcept;
+
+      /**\fn sleep
+       * \brief
+       *    Sleep until the next period
+       *
+       * \return
+       *    False if the loop fell behind by more than a period and the grid was restarted, true otherwise
+      */
+      bool sleep();
+
+      /**\fn getPeriod
+       * \brief
+       *    Get the period of the loop
+       *
+       * \return
+       *    The period of the loop
+      */
+      [[nodiscard]]
+      std::chrono::microseconds getPeriod() const noexcept;
+
+    protected:
+      std::chrono::microseconds period_;
+      std::chrono::steady_clock::time_point next_;
+  };
+
+}
+
+#endif // MYACTUATOR_RMD__CONTROL__PERIODIC_RATE
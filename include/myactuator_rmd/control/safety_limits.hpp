@@ -0,0 +1,203 @@
+/**
+ * \file safety_limits.hpp
+ * \mainpage
+ *    Contains a table of per-actuator limits that set-points and feedback are checked against
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#ifndef MYACTUATOR_RMD__CONTROL__SAFETY_LIMITS
+#define MYACTUATOR_RMD__CONTROL__SAFETY_LIMITS
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+
+namespace myactuator_rmd {
+
+  /**\enum SafetyAction
+   * \brief
+   *    Strongly typed enum for the reactions to a violated limit
+  */
+  enum class SafetyAction {
+    CLAMP,
+    STOP,
+    SHUTDOWN
+  };
+
+  /**\class SafetyLimits
+   * \brief
+   *    Per-actuator limits that the set-points of a group are checked against before they are sent and
+   *    its feedback after it was received. Set-points outside the limits are always clamped, additionally
+   *    a violation may stop or shut down all actuators of the group in the same cycle. A stop or shutdown is
+   *    latched until \ref reset is called. The checks do not throw and only use branch-free loops over the
+   *    actuators. The torque limit is derated linearly from the derating temperature down to zero at the
+   *    maximum temperature. As motion control replies do not hold the temperature, in motion control mode it
+   *    has to be polled and handed to \ref checkTemperature for the derating to apply. Limits are given in
+   *    rad, rad/s, Nm, A and degree Celsius and converted for commands in degree.
+  */
+  class SafetyLimits {
+    public:
+      /**\fn SafetyLimits
+       * \brief
+       *    Class constructor, initialises all limits to the ranges of the motion control command
+       *
+       * \param[in] num_actuators
+       *    The number of actuators of the group the limits are intended for
+      */
+      SafetyLimits(std::size_t const num_actuators = 0);
+      SafetyLimits(SafetyLimits const&) = default;
+      SafetyLimits& operator = (SafetyLimits const&) = default;
+      SafetyLimits(SafetyLimits&&) = default;
+      SafetyLimits& operator = (SafetyLimits&&) = default;
+
+      /**\fn getNumActuators
+       * \brief
+       *    Get the number of actuators the limits are intended for
+       *
+       * \return
+       *    The number of actuators
+      */
+      [[nodiscard]]
+      std::size_t getNumActuators() const noexcept;
+
+      /**\fn getNumViolations
+       * \brief
+       *    Get the number of values that violated a limit since construction
+       *
+       * \return
+       *    The number of violations
+      */
+      [[nodiscard]]
+      std::uint64_t getNumViolations() const noexcept;
+
+      /**\fn getTrip
+       * \brief
+       *    Get the latched action of the last violation that stopped or shut down the actuators
+       *
+       * \return
+       *    The latched stop or shutdown, clamp if the actuators may be commanded
+      */
+      [[nodiscard]]
+      SafetyAction getTrip() const noexcept;
+
+      /**\fn reset
+       * \brief
+       *    Release a latched stop or shutdown so that the actuators may be commanded again
+      */
+      void reset() noexcept;
+
+      /**\fn limitMotionControl
+       * \brief
+       *    Clamp the set-points of a motion control command in place
+       *
+       * \param[in,out] p_des
+       *    Desired positions in rad
+       * \param[in,out] v_des
+       *    Desired velocities in rad/s
+       * \param[in,out] t_ff
+       *    Feedforward torques in Nm
+       * \return
+       *    The action to be taken, clamp if the clamped command should be sent
+      */
+      [[nodiscard]]
+      SafetyAction limitMotionControl(float* p_des, float* v_des, float* t_ff) noexcept;
+
+      /**\fn limitPositionSetpoint
+       * \brief
+       *    Clamp the set-points of an absolute position command in place
+       *
+       * \param[in,out] position
+       *    The position set-points in degree
+       * \param[in,out] max_speed
+       *    The maximum speeds in degree per second
+       * \return
+       *    The action to be taken, clamp if the clamped command should be sent
+      */
+      [[nodiscard]]
+      SafetyAction limitPositionSetpoint(float* position, float* max_speed) noexcept;
+
+      /**\fn checkMotionControlFeedback
+       * \brief
+       *    Check the feedback to a motion control command
+       *
+       * \param[in] position
+       *    The positions in rad
+       * \param[in] velocity
+       *    The velocities in rad/s
+       * \param[in] torque
+       *    The torques in Nm
+       * \return
+       *    The action to be taken
+      */
+      [[nodiscard]]
+      SafetyAction checkMotionControlFeedback(float const* position, float const* velocity, float const* torque) noexcept;
+
+      /**\fn checkFeedback
+       * \brief
+       *    Check the feedback to a closed-loop command and update the derated torque limits
+       *
+       * \param[in] shaft_angle
+       *    The output shaft angles in degree
+       * \param[in] shaft_speed
+       *    The output shaft velocities in degree per second
+       * \param[in] current
+       *    The currents in Ampere
+       * \param[in] temperature
+       *    The temperatures in degree Celsius
+       * \return
+       *    The action to be taken
+      */
+      [[nodiscard]]
+      SafetyAction checkFeedback(float const* shaft_angle, float const* shaft_speed, float const* current,
+                                 float const* temperature) noexcept;
+
+      /**\fn checkTemperature
+       * \brief
+       *    Check the temperatures, e.g. polled with the motor status, and update the derated torque limits
+       *
+       * \param[in] temperature
+       *    The temperatures in degree Celsius
+       * \return
+       *    The action to be taken
+      */
+      [[nodiscard]]
+      SafetyAction checkTemperature(float const* temperature) noexcept;
+
+      // Per actuator: Position range in rad, maximum velocity in rad/s, maximum torque in Nm, maximum current
+      // in A as well as the temperature in degree Celsius where the derating starts and the maximum temperature
+      std::vector<float> min_position;
+      std::vector<float> max_position;
+      std::vector<float> max_velocity;
+      std::vector<float> max_torque;
+      std::vector<float> max_current;
+      std::vector<float> derating_temperature;
+      std::vector<float> max_temperature;
+      // Reactions to set-points and feedback outside the limits
+      SafetyAction setpoint_action;
+      SafetyAction feedback_action;
+
+    protected:
+      /**\fn react
+       * \brief
+       *    Count the violations and latch a stop or shutdown
+       *
+       * \param[in] num_violations
+       *    The number of values outside the limits
+       * \param[in] action
+       *    The action configured for the violated limits
+       * \return
+       *    The action to be taken
+      */
+      SafetyAction react(std::size_t const num_violations, SafetyAction const action) noexcept;
+
+      std::size_t num_actuators_;
+      std::vector<float> derating_;
+      std::uint64_t num_violations_;
+      SafetyAction trip_;
+  };
+
+}
+
+#endif // MYACTUATOR_RMD__CONTROL__SAFETY_LIMITS
@@ -0,0 +1,176 @@
+/**
+ * \file step_response.hpp
+ * \mainpage
+ *    Contains the incremental analysis of the step response of an actuator
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#ifndef MYACTUATOR_RMD__CONTROL__STEP_RESPONSE
+#define MYACTUATOR_RMD__CONTROL__STEP_RESPONSE
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+
+namespace myactuator_rmd {
+
+  /**\class StepResponse
+   * \brief
+   *    Records the response of an actuator to a step of its set-point and updates the characteristics of the
+   *    response with every sample, so that they are available right after the last sample without a second
+   *    pass. The samples are stored in buffers allocated on construction, samples beyond the capacity are
+   *    still analysed but not stored.
+  */
+  class StepResponse {
+    public:
+      /**\fn StepResponse
+       * \brief
+       *    Class constructor
+       *
+       * \param[in] capacity
+       *    The maximum number of samples that are stored
+       * \param[in] settling_band
+       *    The band around the target relative to the height of the step that the response has to stay within
+       *    to count as settled
+      */
+      StepResponse(std::size_t const capacity = 4096, float const settling_band = 0.02f);
+      StepResponse(StepResponse const&) = default;
+      StepResponse& operator = (StepResponse const&) = default;
+      StepResponse(StepResponse&&) = default;
+      StepResponse& operator = (StepResponse&&) = default;
+
+      /**\fn reset
+       * \brief
+       *    Discard all samples and start analysing a new step, the buffers are kept. Throws a
+       *    ValueRangeException if the step has no height.
+       *
+       * \param[in] initial
+       *    The value before the step
+       * \param[in] target
+       *    The value commanded by the step, has to differ from the initial value
+      */
+      void reset(float const initial, float const target);
+
+      /**\fn update
+       * \brief
+       *    Add a sample of the response
+       *
+       * \param[in] time
+       *    The time of the sample since the step was commanded
+       * \param[in] value
+       *    The measured value
+      */
+      void update(std::chrono::microseconds const& time, float const value) noexcept;
+
+      /**\fn getNumSamples
+       * \brief
+       *    Get the number of stored samples
+       *
+       * \return
+       *    The number of stored samples
+      */
+      [[nodiscard]]
+      std::size_t getNumSamples() const noexcept;
+
+      /**\fn getTimes
+       * \brief
+       *    Get the times of the stored samples, only the first getNumSamples() elements are valid
+       *
+       * \return
+       *    The times of the samples since the step was commanded
+      */
+      [[nodiscard]]
+      std::vector<std::chrono::microseconds> const& getTimes() const noexcept;
+
+      /**\fn getValues
+       * \brief
+       *    Get the values of the stored samples, only the first getNumSamples() elements are valid
+       *
+       * \return
+       *    The measured values
+      */
+      [[nodiscard]]
+      std::vector<float> const& getValues() const noexcept;
+
+      /**\fn getRiseTime
+       * \brief
+       *    Get the time the response took to rise from 10% to 90% of the step
+       *
+       * \return
+       *    The rise time in seconds, infinity if 90% were not reached yet
+      */
+      [[nodiscard]]
+      float getRiseTime() const noexcept;
+
+      /**\fn getOvershoot
+       * \brief
+       *    Get the largest overshoot beyond the target
+       *
+       * \return
+       *    The overshoot relative to the height of the step
+      */
+      [[nodiscard]]
+      float getOvershoot() const noexcept;
+
+      /**\fn getSettlingTime
+       * \brief
+       *    Get the time after which the response stayed within the settling band around the target
+       *
+       * \return
+       *    The settling time in seconds, infinity if the last sample is outside of the settling band
+      */
+      [[nodiscard]]
+      float getSettlingTime() const noexcept;
+
+      /**\fn getSteadyStateError
+       * \brief
+       *    Get the error of the last sample
+       *
+       * \return
+       *    The absolute error relative to the height of the step
+      */
+      [[nodiscard]]
+      float getSteadyStateError() const noexcept;
+
+      /**\fn getIntegralAbsoluteError
+       * \brief
+       *    Get the integral of the absolute error over all samples
+       *
+       * \return
+       *    The integral of the absolute error relative to the height of the step in seconds
+      */
+      [[nodiscard]]
+      float getIntegralAbsoluteError() const noexcept;
+
+      /**\fn getBandwidth
+       * \brief
+       *    Get the bandwidth estimated from the rise time, assuming a response dominated by a single pole
+       *
+       * \return
+       *    The bandwidth in Hertz, zero if 90% of the step were not reached yet
+      */
+      [[nodiscard]]
+      float getBandwidth() const noexcept;
+
+    protected:
+      std::vector<std::chrono::microseconds> times_;
+      std::vector<float> values_;
+      float settling_band_;
+      std::size_t num_samples_;
+      float initial_;
+      float height_;
+      float rise_start_;
+      float rise_end_;
+      float peak_;
+      float settling_time_;
+      float error_;
+      float integral_error_;
+      float last_time_;
+  };
+
+}
+
+#endif // MYACTUATOR_RMD__CONTROL__STEP_RESPONSE
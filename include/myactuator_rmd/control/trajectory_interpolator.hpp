@@ -0,0 +1,194 @@
+/**
+ * \file trajectory_interpolator.hpp
+ * \mainpage
+ *    Contains an interpolator generating set-points at a fixed rate from sparse waypoints
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#ifndef MYACTUATOR_RMD__CONTROL__TRAJECTORY_INTERPOLATOR
+#define MYACTUATOR_RMD__CONTROL__TRAJECTORY_INTERPOLATOR
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+
+namespace myactuator_rmd {
+
+  /**\enum InterpolationType
+   * \brief
+   *    Strongly typed enum for the profiles used between two waypoints
+  */
+  enum class InterpolationType {
+    CUBIC,
+    QUINTIC,
+    TRAPEZOIDAL
+  };
+
+  /**\class TrajectoryInterpolator
+   * \brief
+   *    Generates the set-points of a group of actuators for every period from queued waypoints. Cubic and
+   *    quintic segments pass through the waypoints without stopping if the following waypoint is already
+   *    queued when a segment starts, trapezoidal segments accelerate and decelerate during a quarter of the
+   *    segment each and stop at every waypoint. The coefficients of a segment are computed once when it
+   *    starts so that every step only evaluates a polynomial. The waypoints are stored in a ring buffer
+   *    allocated on construction. Waypoints may be added from another thread while the set-points are
+   *    generated, e.g. by a TrajectoryStreamer.
+  */
+  class TrajectoryInterpolator {
+    public:
+      /**\fn TrajectoryInterpolator
+       * \brief
+       *    Class constructor
+       *
+       * \param[in] position
+       *    The current positions of all actuators that the first segment starts from
+       * \param[in] period
+       *    The period between two consecutive set-points
+       * \param[in] type
+       *    The profile used between two waypoints
+       * \param[in] capacity
+       *    The maximum number of waypoints that can be queued
+      */
+      TrajectoryInterpolator(std::vector<float> const& position, std::chrono::microseconds const& period,
+                             InterpolationType const type = InterpolationType::QUINTIC, std::size_t const capacity = 64);
+      TrajectoryInterpolator() = delete;
+      TrajectoryInterpolator(TrajectoryInterpolator const&) = delete;
+      TrajectoryInterpolator& operator = (TrajectoryInterpolator const&) = delete;
+      TrajectoryInterpolator(TrajectoryInterpolator&&) = delete;
+      TrajectoryInterpolator& operator = (TrajectoryInterpolator&&) = delete;
+
+      /**\fn getNumActuators
+       * \brief
+       *    Get the number of actuators the set-points are generated for
+       *
+       * \return
+       *    The number of actuators
+      */
+      [[nodiscard]]
+      std::size_t getNumActuators() const noexcept;
+
+      /**\fn getNumWaypoints
+       * \brief
+       *    Get the number of waypoints that were queued but not started yet
+       *
+       * \return
+       *    The number of queued waypoints
+      */
+      [[nodiscard]]
+      std::size_t getNumWaypoints() const;
+
+      /**\fn isMoving
+       * \brief
+       *    Check whether a segment is currently interpolated
+       *
+       * \return
+       *    True if moving towards a waypoint, false if holding the last waypoint
+      */
+      [[nodiscard]]
+      bool isMoving() const;
+
+      /**\fn addWaypoint
+       * \brief
+       *    Queue a waypoint that is reached the given time after the previous one
+       *
+       * \param[in] duration
+       *    The time from the previous waypoint to this one
+       * \param[in] position
+       *    The positions of all actuators at the waypoint
+       * \return
+       *    False if the queue is full and the waypoint was not added, true otherwise
+      */
+      [[nodiscard]]
+      bool addWaypoint(std::chrono::microseconds const& duration, float const* position);
+
+      /**\fn addWaypoint
+       * \brief
+       *    Queue a waypoint that is reached the given time after the previous one
+       *
+       * \param[in] duration
+       *    The time from the previous waypoint to this one
+       * \param[in] position
+       *    The positions of all actuators at the waypoint, one element per actuator
+       * \return
+       *    False if the queue is full and the waypoint was not added, true otherwise
+      */
+      [[nodiscard]]
+      bool addWaypoint(std::chrono::microseconds const& duration, std::vector<float> const& position);
+
+      /**\fn reset
+       * \brief
+       *    Discard all queued waypoints and hold the given positions
+       *
+       * \param[in] position
+       *    The positions of all actuators that the next segment starts from
+      */
+      void reset(float const* position);
+
+      /**\fn step
+       * \brief
+       *    Advance by one period and get the set-points, holds the last waypoint if no segment is left
+       *
+       * \param[out] position
+       *    The desired positions of all actuators
+       * \param[out] velocity
+       *    The desired velocities of all actuators
+      */
+      void step(float* position, float* velocity);
+
+      // Per actuator: Gains of the motion control command and maximum speed of position set-points in dps
+      // used when streaming the set-points
+      std::vector<float> kp;
+      std::vector<float> kd;
+      std::vector<float> max_speed;
+
+    protected:
+      /**\fn startSegment
+       * \brief
+       *    Take the next waypoint from the queue and compute the coefficients of the segment towards it
+      */
+      void startSegment();
+
+      /**\fn evaluate
+       * \brief
+       *    Evaluate the current segment of an actuator
+       *
+       * \param[in] actuator
+       *    The index of the actuator
+       * \param[in] t
+       *    The time since the start of the segment in seconds
+       * \param[out] position
+       *    The desired position
+       * \param[out] velocity
+       *    The desired velocity
+      */
+      void evaluate(std::size_t const actuator, double const t, float& position, float& velocity) const noexcept;
+
+      std::size_t num_actuators_;
+      std::chrono::microseconds period_;
+      InterpolationType type_;
+      std::size_t capacity_;
+
+      mutable std::mutex mutex_;
+      // Ring buffer of the queued waypoints
+      std::vector<float> waypoint_positions_;
+      std::vector<std::chrono::microseconds> waypoint_durations_;
+      std::size_t head_;
+      std::size_t num_waypoints_;
+
+      // Per actuator: Boundary conditions and polynomial coefficients of the current segment
+      std::vector<double> start_position_;
+      std::vector<double> end_position_;
+      std::vector<double> end_velocity_;
+      std::vector<double> coefficients_;
+      std::chrono::microseconds duration_;
+      std::chrono::microseconds elapsed_;
+      bool is_moving_;
+  };
+
+}
+
+#endif // MYACTUATOR_RMD__CONTROL__TRAJECTORY_INTERPOLATOR
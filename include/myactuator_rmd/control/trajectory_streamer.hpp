@@ -0,0 +1,305 @@
+/**
+ * \file trajectory_streamer.hpp
+ * \mainpage
+ *    Contains a streamer that sends uploaded trajectories to a group of actuators at a fixed rate
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#ifndef MYACTUATOR_RMD__CONTROL__TRAJECTORY_STREAMER
+#define MYACTUATOR_RMD__CONTROL__TRAJECTORY_STREAMER
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "myactuator_rmd/actuator_state/motion_control_status.hpp"
+#include "myactuator_rmd/control/controller.hpp"
+#include "myactuator_rmd/control/trajectory_interpolator.hpp"
+#include "myactuator_rmd/actuator_group.hpp"
+
+
+namespace myactuator_rmd {
+
+  /**\enum StreamMode
+   * \brief
+   *    Strongly typed enum for the commands used for streaming a trajectory
+  */
+  enum class StreamMode {
+    MOTION_CONTROL,
+    POSITION_SETPOINT
+  };
+
+  /**\class SampledTrajectory
+   * \brief
+   *    Trajectory for a group of actuators sampled at the rate of the streamer. The samples are stored
+   *    row-major, i.e. all actuators of a sample are stored next to each other.
+  */
+  class SampledTrajectory {
+    public:
+      /**\fn SampledTrajectory
+       * \brief
+       *    Class constructor, initialises all samples to zero
+       *
+       * \param[in] num_samples
+       *    The number of samples of the trajectory
+       * \param[in] num_actuators
+       *    The number of actuators of the group the trajectory is intended for
+      */
+      SampledTrajectory(std::size_t const num_samples = 0, std::size_t const num_actuators = 0);
+      SampledTrajectory(SampledTrajectory const&) = default;
+      SampledTrajectory& operator = (SampledTrajectory const&) = default;
+      SampledTrajectory(SampledTrajectory&&) = default;
+      SampledTrajectory& operator = (SampledTrajectory&&) = default;
+
+      /**\fn getNumSamples
+       * \brief
+       *    Get the number of samples of the trajectory
+       *
+       * \return
+       *    The number of samples
+      */
+      [[nodiscard]]
+      std::size_t getNumSamples() const noexcept;
+
+      /**\fn getNumActuators
+       * \brief
+       *    Get the number of actuators the trajectory is intended for
+       *
+       * \return
+       *    The number of actuators
+      */
+      [[nodiscard]]
+      std::size_t getNumActuators() const noexcept;
+
+      /**\fn index
+       * \brief
+       *    Get the index of a sample of an actuator inside the sample arrays
+       *
+       * \param[in] sample
+       *    The index of the sample
+       * \param[in] actuator
+       *    The index of the actuator inside the group
+       * \return
+       *    The index inside \ref position, \ref velocity and \ref torque
+      */
+      [[nodiscard]]
+      std::size_t index(std::size_t const sample, std::size_t const actuator) const noexcept;
+
+      // Per sample and actuator: Position in rad (degree for position set-points), velocity in rad/s and
+      // feedforward torque in Nm
+      std::vector<float> position;
+      std::vector<float> velocity;
+      std::vector<float> torque;
+      // Per actuator: Gains of the motion control command and maximum speed of position set-points in dps
+      std::vector<float> kp;
+      std::vector<float> kd;
+      std::vector<float> max_speed;
+
+    protected:
+      std::size_t num_samples_;
+      std::size_t num_actuators_;
+  };
+
+  /**\class TrajectoryStreamer
+   * \brief
+   *    Sends an uploaded trajectory from a dedicated thread with a fixed period to a group of actuators so
+   *    that the timing does not depend on the application. The feedback of every sample is recorded and can
+   *    be polled while the trajectory is streamed. After the last sample the last command is repeated until
+   *    a new trajectory is uploaded or the streamer is stopped. Alternatively the set-points can be generated
+   *    from waypoints by an interpolator while the streamer is running. A controller may modify every motion
+   *    control command based on the latest feedback before it is sent. While running the group must not be
+   *    used from any other thread.
+  */
+  class TrajectoryStreamer {
+    public:
+      /**\fn TrajectoryStreamer
+       * \brief
+       *    Class constructor
+       *
+       * \param[in] group
+       *    The group of actuators the trajectory should be sent to
+       * \param[in] period
+       *    The period between two consecutive samples
+       * \param[in] mode
+       *    The command used for sending the samples
+      */
+      TrajectoryStreamer(ActuatorGroup& group, std::chrono::microseconds const& period,
+                         StreamMode const mode = StreamMode::MOTION_CONTROL);
+      TrajectoryStreamer() = delete;
+      TrajectoryStreamer(TrajectoryStreamer const&) = delete;
+      TrajectoryStreamer& operator = (TrajectoryStreamer const&) = delete;
+      TrajectoryStreamer(TrajectoryStreamer&&) = delete;
+      TrajectoryStreamer& operator = (TrajectoryStreamer&&) = delete;
+      ~TrajectoryStreamer();
+
+      /**\fn setTrajectory
+       * \brief
+       *    Upload a new trajectory, it replaces the current one at the next sample
+       *
+       * \param[in] trajectory
+       *    The trajectory to be streamed, has to match the number of actuators of the group
+      */
+      void setTrajectory(SampledTrajectory const& trajectory);
+
+      /**\fn setInterpolator
+       * \brief
+       *    Stream the set-points generated by the given interpolator whenever no uploaded trajectory is
+       *    streamed, instead of repeating the last sample. Its gains and maximum speeds are used for the
+       *    commands. The interpolator has to outlive the streamer or be removed before it is destroyed.
+       *
+       * \param[in] interpolator
+       *    The interpolator generating the set-points, a null pointer removes the current one
+      */
+      void setInterpolator(TrajectoryInterpolator* const interpolator);
+
+      /**\fn setController
+       * \brief
+       *    Evaluate the given controller before every motion control command. It receives the feedback to the
+       *    previous command and the set-points of the current sample and may modify them in place, e.g. to add
+       *    a gravity compensation torque. The controller has to outlive the streamer or be removed before it is
+       *    destroyed.
+       *
+       * \param[in] controller
+       *    The controller to be evaluated, a null pointer removes the current one
+      */
+      void setController(Controller* const controller);
+
+      /**\fn start
+       * \brief
+       *    Start the streaming thread
+      */
+      void start();
+
+      /**\fn stop
+       * \brief
+       *    Stop the streaming thread and wait for it to finish
+      */
+      void stop();
+
+      /**\fn isRunning
+       * \brief
+       *    Check whether the streaming thread is running
+       *
+       * \return
+       *    True if the streaming thread is running, false if it was stopped or failed
+      */
+      [[nodiscard]]
+      bool isRunning() const noexcept;
+
+      /**\fn getProgress
+       * \brief
+       *    Get the number of samples of the current trajectory that were already sent
+       *
+       * \return
+       *    The number of samples sent so far
+      */
+      [[nodiscard]]
+      std::size_t getProgress() const noexcept;
+
+      /**\fn getNumSamples
+       * \brief
+       *    Get the number of samples of the trajectory currently streamed
+       *
+       * \return
+       *    The number of samples of the current trajectory
+      */
+      [[nodiscard]]
+      std::size_t getNumSamples() const;
+
+      /**\fn getOverruns
+       * \brief
+       *    Get the number of cycles where the streamer could not keep up with the period
+       *
+       * \return
+       *    The number of overruns since the start
+      */
+      [[nodiscard]]
+      std::size_t getOverruns() const noexcept;
+
+      /**\fn getError
+       * \brief
+       *    Get the error that terminated the streaming thread
+       *
+       * \return
+       *    The error message, empty if no error occurred
+      */
+      [[nodiscard]]
+      std::string getError() const;
+
+      /**\fn getFeedback
+       * \brief
+       *    Copy the recorded feedback of the samples that were sent so far. For motion control the feedback
+       *    holds position in rad, velocity in rad/s and torque in Nm, for position set-points the position
+       *    in degree, velocity in degree per second and the current in Ampere.
+       *
+       * \param[out] position
+       *    The recorded positions, resized to the progress times the number of actuators
+       * \param[out] velocity
+       *    The recorded velocities, resized to the progress times the number of actuators
+       * \param[out] torque
+       *    The recorded torques or currents, resized to the progress times the number of actuators
+       * \return
+       *    The number of samples copied
+      */
+      std::size_t getFeedback(std::vector<float>& position, std::vector<float>& velocity, std::vector<float>& torque) const;
+
+    protected:
+      /**\fn run
+       * \brief
+       *    The loop executed by the streaming thread
+      */
+      void run();
+
+      /**\fn runOnce
+       * \brief
+       *    Send a single sample of the current trajectory and record the feedback, throws if the safety limits
+       *    of the group halted the actuators instead
+      */
+      void runOnce();
+
+      ActuatorGroup& group_;
+      std::chrono::microseconds period_;
+      StreamMode mode_;
+
+      mutable std::mutex mutex_;
+      SampledTrajectory trajectory_;
+      SampledTrajectory pending_trajectory_;
+      std::atomic<bool> is_pending_;
+      std::vector<float> feedback_position_;
+      std::vector<float> feedback_velocity_;
+      std::vector<float> feedback_torque_;
+      std::vector<float> pending_feedback_position_;
+      std::vector<float> pending_feedback_velocity_;
+      std::vector<float> pending_feedback_torque_;
+      std::vector<float> hold_position_;
+      std::vector<float> hold_velocity_;
+      std::vector<float> hold_torque_;
+
+      // Guards the stages evaluated by the streaming thread so that they can be replaced while it is running
+      std::mutex stage_mutex_;
+      TrajectoryInterpolator* interpolator_;
+      Controller* controller_;
+      std::vector<MotionControlStatus> status_;
+      std::vector<MotionControlCommand> commands_;
+      std::vector<float> command_position_;
+      std::vector<float> command_velocity_;
+      std::vector<float> command_kp_;
+      std::vector<float> command_kd_;
+      std::vector<float> command_torque_;
+
+      std::atomic<std::size_t> progress_;
+      std::atomic<std::size_t> overruns_;
+      std::atomic<bool> is_running_;
+      std::string error_;
+      std::thread thread_;
+  };
+
+}
+
+#endif // MYACTUATOR_RMD__CONTROL__TRAJECTORY_STREAMER
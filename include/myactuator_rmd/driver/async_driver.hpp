@@ -0,0 +1,115 @@
+/**
+ * \file async_driver.hpp
+ * \mainpage
+ *    Contains a wrapper that exchanges transfers of a driver on a dedicated completion thread
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#ifndef MYACTUATOR_RMD__DRIVER__ASYNC_DRIVER
+#define MYACTUATOR_RMD__DRIVER__ASYNC_DRIVER
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "myactuator_rmd/driver/driver.hpp"
+#include "myactuator_rmd/driver/transfer.hpp"
+
+
+namespace myactuator_rmd {
+
+  /**\class AsyncDriver
+   * \brief
+   *    Owns a thread that exchanges submitted transfers with a driver and reports the result to a callback,
+   *    so that the caller never blocks on the bus. All transfers queued while the previous batch was exchanged
+   *    are handed to the driver at once, so that requests to different actuators are in flight at the same time.
+   *    The wrapped driver must not be used from any other thread while the asynchronous driver exists.
+  */
+  class AsyncDriver {
+    public:
+      /**\fn Callback
+       * \brief
+       *    Called from the completion thread once a transfer was exchanged, the error is empty on success.
+       *    Callbacks should return quickly and must not throw.
+      */
+      using Callback = std::function<void(Transfer const& transfer, std::exception_ptr error)>;
+
+      /**\fn AsyncDriver
+       * \brief
+       *    Class constructor, starts the completion thread
+       *
+       * \param[in] driver
+       *    The driver communicating over the network interface
+       * \param[in] max_batch_size
+       *    The maximum number of transfers handed to the driver at once
+      */
+      AsyncDriver(Driver& driver, std::size_t const max_batch_size = 32);
+      AsyncDriver() = delete;
+      AsyncDriver(AsyncDriver const&) = delete;
+      AsyncDriver& operator = (AsyncDriver const&) = delete;
+      AsyncDriver(AsyncDriver&&) = delete;
+      AsyncDriver& operator = (AsyncDriver&&) = delete;
+
+      /**\fn ~AsyncDriver
+       * \brief
+       *    Class destructor, waits for the batch currently exchanged and fails all transfers still queued
+      */
+      ~AsyncDriver();
+
+      /**\fn addId
+       * \brief
+       *    Registers an actuator id with the wrapped driver
+       *
+       * \param[in] actuator_id
+       *    The id of the actuator [1, 32]
+      */
+      void addId(std::uint32_t const actuator_id);
+
+      /**\fn submit
+       * \brief
+       *    Queue a transfer for the completion thread
+       *
+       * \param[in] transfer
+       *    The transfer to be exchanged
+       * \param[in] callback
+       *    The callback invoked with the completed transfer or the error that occurred
+      */
+      void submit(Transfer const& transfer, Callback const& callback);
+
+      /**\fn getPending
+       * \brief
+       *    Get the number of transfers that were submitted but not handed to the driver yet
+       *
+       * \return
+       *    The number of queued transfers
+      */
+      [[nodiscard]]
+      std::size_t getPending() const;
+
+    protected:
+      /**\fn run
+       * \brief
+       *    The loop executed by the completion thread
+      */
+      void run();
+
+      Driver& driver_;
+      std::size_t max_batch_size_;
+      std::mutex driver_mutex_;
+      mutable std::mutex mutex_;
+      std::condition_variable condition_;
+      std::deque<std::pair<Transfer,Callback>> queue_;
+      bool is_running_;
+      std::thread thread_;
+  };
+
+}
+
+#endif // MYACTUATOR_RMD__DRIVER__ASYNC_DRIVER
@@ -0,0 +1,279 @@
+/**
+ * \file bus_io_thread.hpp
+ * \mainpage
+ *    Contains a dedicated I/O thread per bus that clients talk to through wait-free queues
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#ifndef MYACTUATOR_RMD__DRIVER__BUS_IO_THREAD
+#define MYACTUATOR_RMD__DRIVER__BUS_IO_THREAD
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "myactuator_rmd/driver/driver.hpp"
+#include "myactuator_rmd/driver/spsc_queue.hpp"
+#include "myactuator_rmd/driver/transfer.hpp"
+
+
+namespace myactuator_rmd {
+
+  /**\class IoRequest
+   * \brief
+   *    A transfer submitted to the I/O thread of a bus
+  */
+  class IoRequest {
+    public:
+      /**\fn IoRequest
+       * \brief
+       *    Class constructor
+       *
+       * \param[in] transfer_
+       *    The transfer to be exchanged
+       * \param[in] tag_
+       *    Arbitrary value chosen by the client that is returned with the completion
+       * \param[in] is_response_expected_
+       *    Whether to wait for the response or to only send the request
+      */
+      constexpr IoRequest(Transfer const& transfer_ = {}, std::uint64_t const tag_ = 0,
+                          bool const is_response_expected_ = true) noexcept;
+      IoRequest(IoRequest const&) = default;
+      IoRequest& operator = (IoRequest const&) = default;
+      IoRequest(IoRequest&&) = default;
+      IoRequest& operator = (IoRequest&&) = default;
+
+      Transfer transfer;
+      std::uint64_t tag;
+      bool is_response_expected;
+  };
+
+  constexpr IoRequest::IoRequest(Transfer const& transfer_, std::uint64_t const tag_, bool const is_response_expected_) noexcept
+  : transfer{transfer_}, tag{tag_}, is_response_expected{is_response_expected_} {
+    return;
+  }
+
+  /**\class IoCompletion
+   * \brief
+   *    The result of a request returned by the I/O thread of a bus
+  */
+  class IoCompletion {
+    public:
+      /**\fn IoCompletion
+       * \brief
+       *    Class constructor
+       *
+       * \param[in] transfer_
+       *    The exchanged transfer including the response
+       * \param[in] tag_
+       *    The value the client submitted the request with
+       * \param[in] error_
+       *    The error that occurred, empty on success
+      */
+      IoCompletion(Transfer const& transfer_ = {}, std::uint64_t const tag_ = 0, std::exception_ptr error_ = {}) noexcept;
+      IoCompletion(IoCompletion const&) = default;
+      IoCompletion& operator = (IoCompletion const&) = default;
+      IoCompletion(IoCompletion&&) = default;
+      IoCompletion& operator = (IoCompletion&&) = default;
+
+      Transfer transfer;
+      std::uint64_t tag;
+      std::exception_ptr error;
+  };
+
+  inline IoCompletion::IoCompletion(Transfer const& transfer_, std::uint64_t const tag_, std::exception_ptr error_) noexcept
+  : transfer{transfer_}, tag{tag_}, error{error_} {
+    return;
+  }
+
+  class BusIoThread;
+
+  /**\class IoChannel
+   * \brief
+   *    Connection of a single client thread to the I/O thread of a bus consisting of a request and a completion
+   *    queue. Every channel may only be used by one client thread, which has to collect its completions so
+   *    that no more than \ref capacity requests are outstanding at any time. Submitting never blocks, while a
+   *    client waiting for a completion sleeps on a condition variable until the I/O thread wakes it up.
+  */
+  class IoChannel {
+    public:
+      inline static constexpr std::size_t capacity {64};
+
+      IoChannel(IoChannel const&) = delete;
+      IoChannel& operator = (IoChannel const&) = delete;
+      IoChannel(IoChannel&&) = delete;
+      IoChannel& operator = (IoChannel&&) = delete;
+
+      /**\fn trySubmit
+       * \brief
+       *    Submit a request to the I/O thread without blocking
+       *
+       * \param[in] request
+       *    The request to be submitted
+       * \return
+       *    True if the request was queued, false if the request queue is full
+      */
+      [[nodiscard]]
+      bool trySubmit(IoRequest const& request);
+
+      /**\fn tryReceive
+       * \brief
+       *    Collect the oldest completion without blocking
+       *
+       * \param[out] completion
+       *    The completion of a previously submitted request
+       * \return
+       *    True if a completion was available, false otherwise
+      */
+      [[nodiscard]]
+      bool tryReceive(IoCompletion& completion);
+
+      /**\fn receive
+       * \brief
+       *    Collect the oldest completion, sleeping until one is available or the channel was closed
+       *
+       * \param[out] completion
+       *    The completion of a previously submitted request
+       * \return
+       *    True if a completion was collected, false if the I/O thread closed the channel
+      */
+      [[nodiscard]]
+      bool receive(IoCompletion& completion);
+
+    protected:
+      IoChannel();
+
+      /**\fn notify
+       * \brief
+       *    Wake up the client waiting for a completion, called by the I/O thread after pushing a completion
+      */
+      void notify();
+
+      /**\fn close
+       * \brief
+       *    Wake up the client for good, called by the I/O thread when it stops
+      */
+      void close();
+
+      SpscQueue<IoRequest,capacity> requests_;
+      SpscQueue<IoCompletion,capacity> completions_;
+      std::mutex mutex_;
+      std::condition_variable condition_;
+      bool is_closed_;
+
+      friend BusIoThread;
+  };
+
+  /**\class BusIoThread
+   * \brief
+   *    Dedicated thread that owns all I/O of a single bus. Clients submit requests through their own channel,
+   *    so submitting never takes a lock and never contends with other clients. The I/O thread collects the
+   *    requests of all channels, exchanges them in a single batch and returns the completions through the
+   *    channels in the order the requests were submitted. A request that does not expect a response is only
+   *    sent after the batch collected before it was exchanged, so that requests go out on the bus in the order
+   *    they were submitted. The driver must not be used by anybody else while the I/O thread is running.
+  */
+  class BusIoThread {
+    public:
+      inline static constexpr std::size_t max_channels {32};
+
+      /**\fn BusIoThread
+       * \brief
+       *    Class constructor, starts the I/O thread
+       *
+       * \param[in] driver
+       *    The driver of the bus
+       * \param[in] idle_period
+       *    The time the I/O thread sleeps when no request is pending, zero for only yielding
+       * \param[in] max_batch_size
+       *    The maximum number of transfers exchanged at once
+      */
+      BusIoThread(Driver& driver, std::chrono::microseconds const& idle_period = std::chrono::microseconds(50),
+                  std::size_t const max_batch_size = 32);
+      BusIoThread() = delete;
+      BusIoThread(BusIoThread const&) = delete;
+      BusIoThread& operator = (BusIoThread const&) = delete;
+      BusIoThread(BusIoThread&&) = delete;
+      BusIoThread& operator = (BusIoThread&&) = delete;
+      ~BusIoThread();
+
+      /**\fn openChannel
+       * \brief
+       *    Open a new channel for a client thread, the channel lives as long as the I/O thread
+       *
+       * \return
+       *    The channel to be used by a single client thread
+      */
+      [[nodiscard]]
+      IoChannel& openChannel();
+
+      /**\fn addId
+       * \brief
+       *    Registers an actuator id with the driver of the bus
+       *
+       * \param[in] actuator_id
+       *    The id of the actuator [1, 32]
+      */
+      void addId(std::uint32_t const actuator_id);
+
+      /**\fn isRunning
+       * \brief
+       *    Check whether the I/O thread is running
+       *
+       * \return
+       *    True if the I/O thread is running, false after it was stopped
+      */
+      [[nodiscard]]
+      bool isRunning() const noexcept;
+
+    protected:
+      /**\fn run
+       * \brief
+       *    The loop executed by the I/O thread
+      */
+      void run();
+
+      /**\fn flush
+       * \brief
+       *    Exchange the current batch and hand the completions back to their channels
+      */
+      void flush();
+
+      /**\fn complete
+       * \brief
+       *    Hand a completion back to its channel, waits if the client did not collect its completions
+       *
+       * \param[in,out] channel
+       *    The channel the request was submitted through
+       * \param[in] completion
+       *    The completion of the request
+      */
+      void complete(IoChannel& channel, IoCompletion&& completion);
+
+      Driver& driver_;
+      std::chrono::microseconds idle_period_;
+      std::size_t max_batch_size_;
+      std::mutex driver_mutex_;
+      std::mutex channel_mutex_;
+      std::array<std::unique_ptr<IoChannel>,max_channels> channels_;
+      std::atomic<std::size_t> num_channels_;
+      // Current batch and the channel and tag each transfer belongs to, only used by the I/O thread
+      std::vector<Transfer> transfers_;
+      std::vector<std::pair<IoChannel*,std::uint64_t>> owners_;
+      std::atomic<bool> is_running_;
+      std::thread thread_;
+  };
+
+}
+
+#endif // MYACTUATOR_RMD__DRIVER__BUS_IO_THREAD
@@ -10,14 +10,26 @@
 #define MYACTUATOR_RMD__DRIVER__CAN_NODE
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <string>
+#include <system_error>
+#include <tuple>
 #include <vector>
 
+#include "myactuator_rmd/can/filter.hpp"
 #include "myactuator_rmd/can/frame.hpp"
+#include "myactuator_rmd/can/exceptions.hpp"
 #include "myactuator_rmd/can/node.hpp"
+#include "myactuator_rmd/can/tx_queue.hpp"
 #include "myactuator_rmd/driver/driver.hpp"
+#include "myactuator_rmd/driver/driver_statistics.hpp"
+#include "myactuator_rmd/driver/transfer.hpp"
+#include "myactuator_rmd/protocol/command_type.hpp"
 #include "myactuator_rmd/protocol/message.hpp"
 #include "myactuator_rmd/exceptions.hpp"
 
@@ -31,7 +43,44 @@ namespace myactuator_rmd {
   */
   template <std::uint32_t SEND_ID_OFFSET, std::uint32_t RECEIVE_ID_OFFSET>
   class CanNode: public Driver, protected can::Node {
+    public:
+      using can::Node::setRecvBufferSize;
+      using can::Node::setSendBufferSize;
+      using can::Node::getRecvBufferSize;
+      using can::Node::getSendBufferSize;
+      using can::Node::setBusyPoll;
+      using can::Node::setKernelBusyPoll;
+      using can::Node::setIoBackend;
+      using can::Node::getIoBackend;
+      using can::Node::setTimestamping;
+
+      /**\fn setMaxRetries
+       * \brief
+       *    Set how often a request that only reads from the actuator is sent again if its reply does not arrive
+       *    in time. Within a batch the deadline of a request is split evenly between all attempts while single
+       *    requests wait for the receive timeout on every attempt. Requests writing to the actuator are never
+       *    repeated.
+       * 
+       * \param[in] max_retries
+       *    The maximum number of times a request is repeated, zero disables retries
+      */
+      void setMaxRetries(std::size_t const max_retries) noexcept;
+
+      /**\fn getStatistics
+       * \brief
+       *    Get the frame counters of the underlying socket. Dropped frames are counted by the kernel when
+       *    the receive buffer overflows, the count is updated with every frame that is read.
+       * 
+       * \return
+       *    The number of sent, received and dropped frames as well as the outcomes of the requests
+      */
+      [[nodiscard]]
+      DriverStatistics getStatistics() const override;
+
     protected:
+      // Approximate time a single frame occupies a bus at 1 Mbit/s
+      inline static constexpr std::chrono::microseconds frame_time {std::chrono::microseconds(130)};
+
       /**\fn CanNode
        * \brief
        *    Class constructor
@@ -78,7 +127,7 @@ namespace myactuator_rmd {
       /**\fn sendRecv
        * \brief
        *    Writes a given CAN frame based on the request to the actuator with the corresponding id
-       *    and waits for a corresponding reply
+       *    and waits for a corresponding reply, late replies to earlier requests are discarded
        * 
        * \param[in] request
        *    Request that should be sent to the corresponding actuator
@@ -99,7 +148,71 @@ namespace myactuator_rmd {
       inline std::array<std::uint8_t,8> sendRecv(Message const& request, std::uint32_t const actuator_id, std::uint32_t const request_offset, std::uint32_t const response_offset) override;
       // -----------------------------------------------------------------------
 
+      /**\fn sendRecv
+       * \brief
+       *    Writes the requests of all given transfers before reading any reply and then assigns the replies
+       *    to the transfers by their CAN id. Each transfer is awaited until its own deadline counted from the
+       *    start of the batch, transfers without a timeout use the receive timeout of the socket. Throws a
+       *    TimeoutException once all other replies were received if any transfer timed out. Frames that do
+       *    not answer any of the pending requests are discarded.
+       * 
+       * \param[in,out] transfers
+       *    The transfers to be exchanged, their responses are filled in
+      */
+      void sendRecv(std::vector<Transfer>& transfers) override;
+
     protected:
+      /**\fn exchange
+       * \brief
+       *    Write the request of a single transfer and read until its reply arrives, repeats the request if
+       *    it only reads from the actuator and the reply did not arrive in time. Each attempt waits at most
+       *    for the timeout of the transfer or the receive timeout, regardless of stale frames.
+       * 
+       * \param[in] transfer
+       *    The transfer to be exchanged
+       * \return
+       *    The response bytes
+      */
+      [[nodiscard]]
+      std::array<std::uint8_t,8> exchange(Transfer const& transfer);
+
+      /**\fn isQueued
+       * \brief
+       *    Check if a frame is still waiting in the transmit queue
+       * 
+       * \param[in] frame
+       *    The frame to look for
+       * \return
+       *    True if an identical frame was not written yet, false otherwise
+      */
+      [[nodiscard]]
+      bool isQueued(can::Frame const& frame) const noexcept;
+
+      /**\fn getNumAttempts
+       * \brief
+       *    Get the number of times the request of a transfer may be sent
+       * 
+       * \param[in] transfer
+       *    The transfer whose request should be sent
+       * \return
+       *    The number of attempts
+      */
+      [[nodiscard]]
+      std::size_t getNumAttempts(Transfer const& transfer) const noexcept;
+
+      /**\fn getTxPriority
+       * \brief
+       *    Get the priority of the request of a transfer, setpoints and stop commands are sent before telemetry
+       *    requests if the transmit queue of the CAN controller is full
+       * 
+       * \param[in] transfer
+       *    The transfer whose request should be sent
+       * \return
+       *    The priority of the request
+      */
+      [[nodiscard]]
+      static constexpr can::TxPriority getTxPriority(Transfer const& transfer) noexcept;
+
       /**\fn getCanSendId
        * \brief
        *    Get the CAN id that a message should be sent to
@@ -125,11 +238,21 @@ namespace myactuator_rmd {
       constexpr std::uint32_t getCanReceiveId(std::uint32_t const actuator_id) noexcept;
 
       std::vector<std::uint32_t> actuator_ids_;
+      can::TxQueue tx_queue_;
+      std::vector<std::size_t> num_attempts_;
+      std::size_t max_retries_;
+      std::uint64_t num_stale_frames_;
+      std::uint64_t num_retries_;
+      std::uint64_t num_timeouts_;
+      std::chrono::microseconds command_skew_;
+      std::chrono::microseconds max_command_skew_;
   };
 
   template <std::uint32_t SEND_ID_OFFSET, std::uint32_t RECEIVE_ID_OFFSET>
   CanNode<SEND_ID_OFFSET,RECEIVE_ID_OFFSET>::CanNode(std::string const& ifname)
-  : can::Node{ifname}, Driver{} {
+  : can::Node{ifname}, Driver{}, actuator_ids_{}, tx_queue_{}, num_attempts_{}, max_retries_{0},
+    num_stale_frames_{0}, num_retries_{0}, num_timeouts_{0}, command_skew_{0}, max_command_skew_{0} {
+    setRxOverflowDetection(true);
     return;
   }
 
@@ -138,6 +261,9 @@ namespace myactuator_rmd {
     if ((actuator_id < 1) || (actuator_id > 32)) {
       throw Exception("Given actuator id '" + std::to_string(actuator_id) + "' out of admittable range [1, 32]!");
     }
+    if (std::find(actuator_ids_.begin(), actuator_ids_.end(), actuator_id) != actuator_ids_.end()) {
+      return;
+    }
     actuator_ids_.push_back(actuator_id);
     std::vector<std::uint32_t> can_receive_ids {};
     for (auto const& id: actuator_ids_){
@@ -146,7 +272,8 @@ namespace myactuator_rmd {
       can_receive_ids.emplace_back(CanAddressOffset::response_motion_control + id);
       // -----------------------------------------------------------------------
     }
-    setRecvFilter(can_receive_ids);
+    // Merges the response ids of neighbouring actuators and rejects the requests of other nodes
+    setRecvFilters(can::computeFilters(can_receive_ids));
     return;
   }
 
@@ -159,10 +286,8 @@ namespace myactuator_rmd {
 
   template <std::uint32_t SEND_ID_OFFSET, std::uint32_t RECEIVE_ID_OFFSET>
   std::array<std::uint8_t,8> CanNode<SEND_ID_OFFSET,RECEIVE_ID_OFFSET>::sendRecv(Message const& request, std::uint32_t const actuator_id) {
-    auto const can_send_id {getCanSendId(actuator_id)};
-    write(can_send_id, request.getData());
-    can::Frame const frame {can::Node::read()};
-    return frame.getData();
+    Transfer const transfer {actuator_id, request.getData(), SEND_ID_OFFSET, RECEIVE_ID_OFFSET};
+    return exchange(transfer);
   }
 
   // --- edit ---
@@ -175,13 +300,184 @@ namespace myactuator_rmd {
 
   template <std::uint32_t SEND_ID_OFFSET, std::uint32_t RECEIVE_ID_OFFSET>
   std::array<std::uint8_t,8> CanNode<SEND_ID_OFFSET,RECEIVE_ID_OFFSET>::sendRecv(Message const& request, std::uint32_t const actuator_id, std::uint32_t const request_offset, std::uint32_t const response_offset) {
-    auto const can_send_id = request_offset + actuator_id;
-    write(can_send_id, request.getData());
-    can::Frame const frame {can::Node::read()};
-    return frame.getData();
+    Transfer const transfer {actuator_id, request.getData(), request_offset, response_offset};
+    return exchange(transfer);
   }
   // -----------------------------------------------------------------------
-  
+
+  template <std::uint32_t SEND_ID_OFFSET, std::uint32_t RECEIVE_ID_OFFSET>
+  void CanNode<SEND_ID_OFFSET,RECEIVE_ID_OFFSET>::sendRecv(std::vector<Transfer>& transfers) {
+    tx_queue_.clear();
+    num_attempts_.assign(transfers.size(), 1);
+    for (auto& transfer: transfers) {
+      transfer.is_received = false;
+      transfer.is_timed_out = false;
+      can::Frame const frame {transfer.request_offset + transfer.actuator_id, transfer.request};
+      if (!tx_queue_.push(frame, getTxPriority(transfer))) {
+        tx_queue_.clear();
+        throw Exception("Batch of " + std::to_string(transfers.size()) + " transfers exceeds the transmit queue!");
+      }
+    }
+    auto const start {std::chrono::steady_clock::now()};
+    std::size_t pending {transfers.size()};
+    std::size_t num_unwritten {transfers.size()};
+    std::size_t num_timed_out {0};
+    bool is_writable {false};
+    bool is_controller_full {false};
+    while (pending > 0) {
+      // Repeats or gives up on the transfers whose attempt expired and waits at most until the next one is due
+      auto const now {std::chrono::steady_clock::now()};
+      auto next_deadline {std::chrono::steady_clock::time_point::max()};
+      for (std::size_t i = 0; i < transfers.size(); ++i) {
+        auto& transfer {transfers[i]};
+        auto const timeout {(transfer.timeout.count() > 0) ? transfer.timeout : receive_timeout_};
+        if (transfer.is_received || transfer.is_timed_out || (timeout.count() == 0)) {
+          continue;
+        }
+        auto const num_attempts {static_cast<std::chrono::microseconds::rep>(getNumAttempts(transfer))};
+        auto const attempt {static_cast<std::chrono::microseconds::rep>(num_attempts_[i])};
+        if (start + timeout*attempt/num_attempts > now) {
+          next_deadline = std::min(next_deadline, start + timeout*attempt/num_attempts);
+          continue;
+        }
+        // A copy is only added once the previous one was written, otherwise its attempt is merely extended.
+        // Copies are pushed behind all requests of the batch, so the command skew still covers the originals.
+        can::Frame const frame {transfer.request_offset + transfer.actuator_id, transfer.request};
+        bool const is_unwritten {(attempt < num_attempts) && isQueued(frame)};
+        if ((attempt < num_attempts) && (is_unwritten || tx_queue_.push(frame, getTxPriority(transfer)))) {
+          ++num_attempts_[i];
+          num_retries_ += static_cast<std::uint64_t>(!is_unwritten);
+          next_deadline = std::min(next_deadline, start + timeout*(attempt + 1)/num_attempts);
+        } else {
+          transfer.is_timed_out = true;
+          ++num_timed_out;
+          ++num_timeouts_;
+          --pending;
+        }
+      }
+      if (pending == 0) {
+        break;
+      }
+      // Writes as many requests as the controller accepts and reads replies while waiting for it to drain
+      auto const num_written {flush(tx_queue_)};
+      if ((num_unwritten > 0) && (num_written >= num_unwritten)) {
+        command_skew_ = std::chrono::ceil<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+        max_command_skew_ = std::max(max_command_skew_, command_skew_);
+      }
+      num_unwritten -= std::min(num_unwritten, num_written);
+      // The socket reports room in its own buffer only, if nothing could be written after it reported to be
+      // writable the queue of the controller is full. Only replies are waited for then and writing is tried
+      // again after about a frame left the controller instead of spinning on the writable socket.
+      is_controller_full = (num_written == 0) && !tx_queue_.empty() && (is_writable || is_controller_full);
+      std::chrono::microseconds timeout {(next_deadline != std::chrono::steady_clock::time_point::max()) ?
+                                         std::chrono::ceil<std::chrono::microseconds>(next_deadline - now) :
+                                         std::chrono::microseconds(0)};
+      if (is_controller_full && ((timeout.count() == 0) || (timeout > frame_time))) {
+        timeout = frame_time;
+      }
+      bool is_readable {false};
+      std::tie(is_readable, is_writable) = wait(true, !tx_queue_.empty() && !is_controller_full, timeout);
+      if (!is_readable) {
+        continue;
+      }
+      can::Frame const frame {can::Node::read()};
+      // Replies arriving for a CAN id with several pending requests are assigned in order
+      auto it {std::find_if(transfers.begin(), transfers.end(), [&frame](Transfer const& t) noexcept -> bool {
+        return !t.is_received && !t.is_timed_out && isReply(t, frame.getId(), frame.getData());
+      })};
+      if (it != transfers.end()) {
+        it->response = frame.getData();
+        it->is_received = true;
+        it->timestamp = can::Node::getTimestamp();
+        --pending;
+      } else {
+        ++num_stale_frames_;
+      }
+    }
+    if (num_timed_out > 0) {
+      auto const num_unsent {tx_queue_.size()};
+      tx_queue_.clear();
+      throw can::TimeoutException(ETIMEDOUT, std::generic_category(), "Timeout waiting for " + std::to_string(num_timed_out) +
+                                  " of " + std::to_string(transfers.size()) + " replies with " + std::to_string(num_unsent) +
+                                  " requests not yet sent");
+    }
+    return;
+  }
+
+  template <std::uint32_t SEND_ID_OFFSET, std::uint32_t RECEIVE_ID_OFFSET>
+  void CanNode<SEND_ID_OFFSET,RECEIVE_ID_OFFSET>::setMaxRetries(std::size_t const max_retries) noexcept {
+    max_retries_ = max_retries;
+    return;
+  }
+
+  template <std::uint32_t SEND_ID_OFFSET, std::uint32_t RECEIVE_ID_OFFSET>
+  std::array<std::uint8_t,8> CanNode<SEND_ID_OFFSET,RECEIVE_ID_OFFSET>::exchange(Transfer const& transfer) {
+    auto const num_attempts {getNumAttempts(transfer)};
+    auto const timeout {(transfer.timeout.count() > 0) ? transfer.timeout : receive_timeout_};
+    for (std::size_t attempt = 1; ; ++attempt) {
+      write(transfer.request_offset + transfer.actuator_id, transfer.request);
+      // Stale frames must not extend the attempt, so all reads share a single deadline
+      auto const deadline {std::chrono::steady_clock::now() + timeout};
+      try {
+        while (true) {
+          if (timeout.count() > 0) {
+            auto const remaining {std::chrono::ceil<std::chrono::microseconds>(deadline - std::chrono::steady_clock::now())};
+            if ((remaining.count() <= 0) || !wait(true, false, remaining).first) {
+              throw can::TimeoutException(ETIMEDOUT, std::generic_category(), "Timeout waiting for the reply of actuator " +
+                                          std::to_string(transfer.actuator_id));
+            }
+          }
+          can::Frame const frame {can::Node::read()};
+          if (isReply(transfer, frame.getId(), frame.getData())) {
+            return frame.getData();
+          }
+          // A late reply to an earlier request would otherwise be taken for the reply to this one
+          ++num_stale_frames_;
+        }
+      } catch (can::TimeoutException const&) {
+        if (attempt >= num_attempts) {
+          ++num_timeouts_;
+          throw;
+        }
+        ++num_retries_;
+      }
+    }
+  }
+
+  template <std::uint32_t SEND_ID_OFFSET, std::uint32_t RECEIVE_ID_OFFSET>
+  bool CanNode<SEND_ID_OFFSET,RECEIVE_ID_OFFSET>::isQueued(can::Frame const& frame) const noexcept {
+    for (std::size_t i = 0; i < tx_queue_.size(); ++i) {
+      auto const& queued {tx_queue_.peek(i)};
+      if ((queued.getId() == frame.getId()) && (queued.getData() == frame.getData())) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  template <std::uint32_t SEND_ID_OFFSET, std::uint32_t RECEIVE_ID_OFFSET>
+  std::size_t CanNode<SEND_ID_OFFSET,RECEIVE_ID_OFFSET>::getNumAttempts(Transfer const& transfer) const noexcept {
+    return isIdempotent(transfer) ? max_retries_ + 1 : 1;
+  }
+
+  template <std::uint32_t SEND_ID_OFFSET, std::uint32_t RECEIVE_ID_OFFSET>
+  constexpr can::TxPriority CanNode<SEND_ID_OFFSET,RECEIVE_ID_OFFSET>::getTxPriority(Transfer const& transfer) noexcept {
+    auto const command {transfer.request[0]};
+    if ((transfer.request_offset == CanAddressOffset::request_motion_control) ||
+        (command == CommandType::SHUTDOWN_MOTOR) || (command == CommandType::STOP_MOTOR) ||
+        (command == CommandType::TORQUE_CLOSED_LOOP_CONTROL) || (command == CommandType::SPEED_CLOSED_LOOP_CONTROL) ||
+        (command == CommandType::ABSOLUTE_POSITION_CLOSED_LOOP_CONTROL)) {
+      return can::TxPriority::CONTROL;
+    }
+    return can::TxPriority::TELEMETRY;
+  }
+
+  template <std::uint32_t SEND_ID_OFFSET, std::uint32_t RECEIVE_ID_OFFSET>
+  DriverStatistics CanNode<SEND_ID_OFFSET,RECEIVE_ID_OFFSET>::getStatistics() const {
+    return DriverStatistics{getNumWrittenFrames(), getNumReadFrames(), getNumDroppedFrames(), getNumSyscalls(),
+                            num_stale_frames_, num_retries_, num_timeouts_, command_skew_, max_command_skew_};
+  }
+
   template <std::uint32_t SEND_ID_OFFSET, std::uint32_t RECEIVE_ID_OFFSET>
   constexpr std::uint32_t CanNode<SEND_ID_OFFSET,RECEIVE_ID_OFFSET>::getCanSendId(std::uint32_t const actuator_id) noexcept {
     return SEND_ID_OFFSET + actuator_id;
@@ -0,0 +1,124 @@
+/**
+ * \file channel_driver.hpp
+ * \mainpage
+ *    Contains a driver that forwards all requests to the I/O thread of a bus
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#ifndef MYACTUATOR_RMD__DRIVER__CHANNEL_DRIVER
+#define MYACTUATOR_RMD__DRIVER__CHANNEL_DRIVER
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "myactuator_rmd/driver/bus_io_thread.hpp"
+#include "myactuator_rmd/driver/driver.hpp"
+#include "myactuator_rmd/driver/transfer.hpp"
+#include "myactuator_rmd/protocol/message.hpp"
+
+
+namespace myactuator_rmd {
+
+  /**\class ChannelDriver
+   * \brief
+   *    Driver that hands all requests to the I/O thread of a bus through its own channel. Every application
+   *    thread creates its own channel driver, so that several threads can command actuators on the same bus
+   *    through the regular actuator interface without any locking. While waiting for a completion the calling
+   *    thread sleeps until the I/O thread wakes it up.
+  */
+  class ChannelDriver: public Driver {
+    public:
+      /**\fn ChannelDriver
+       * \brief
+       *    Class constructor, opens a new channel to the I/O thread
+       *
+       * \param[in] io_thread
+       *    The I/O thread of the bus
+      */
+      ChannelDriver(BusIoThread& io_thread);
+      ChannelDriver() = delete;
+      ChannelDriver(ChannelDriver const&) = delete;
+      ChannelDriver& operator = (ChannelDriver const&) = delete;
+      ChannelDriver(ChannelDriver&&) = delete;
+      ChannelDriver& operator = (ChannelDriver&&) = delete;
+
+      /**\fn addId
+       * \brief
+       *    Registers an actuator id with the driver of the bus
+       *
+       * \param[in] actuator_id
+       *    The id of the actuator [1, 32]
+      */
+      void addId(std::uint32_t const actuator_id) override;
+
+      /**\fn send
+       * \brief
+       *    Sends a message to the given actuator and waits until it was written
+       *
+       * \param[in] msg
+       *    The message that should be sent to the corresponding actuator
+       * \param[in] actuator_id
+       *    The ID of the actuator that the message should be sent to
+      */
+      void send(Message const& msg, std::uint32_t const actuator_id) override;
+      void send(Message const& msg, std::uint32_t const actuator_id, std::uint32_t const base_offset) override;
+
+      /**\fn sendRecv
+       * \brief
+       *    Sends a request to the given actuator through the I/O thread and waits for its reply
+       *
+       * \param[in] request
+       *    Request that should be sent to the corresponding actuator
+       * \param[in] actuator_id
+       *    The ID of the actuator that the message should be sent to
+       * \return
+       *    The response bytes
+      */
+      [[nodiscard]]
+      std::array<std::uint8_t,8> sendRecv(Message const& request, std::uint32_t const actuator_id) override;
+      [[nodiscard]]
+      std::array<std::uint8_t,8> sendRecv(Message const& request, std::uint32_t const actuator_id,
+                                          std::uint32_t const request_offset, std::uint32_t const response_offset) override;
+
+      /**\fn sendRecv
+       * \brief
+       *    Submits all transfers to the I/O thread and waits for their completions. If any transfer fails the
+       *    first error is rethrown after all completions were collected.
+       *
+       * \param[in,out] transfers
+       *    The transfers to be exchanged, their responses are filled in by the driver
+      */
+      void sendRecv(std::vector<Transfer>& transfers) override;
+
+    protected:
+      /**\fn receive
+       * \brief
+       *    Wait for the next completion of the channel
+       *
+       * \return
+       *    The completion
+      */
+      [[nodiscard]]
+      IoCompletion receive();
+
+      /**\fn exchange
+       * \brief
+       *    Submit a single request and wait for its completion
+       *
+       * \param[in] request
+       *    The request to be submitted
+       * \return
+       *    The completed transfer
+      */
+      Transfer exchange(IoRequest const& request);
+
+      BusIoThread& io_thread_;
+      IoChannel& channel_;
+  };
+
+}
+
+#endif // MYACTUATOR_RMD__DRIVER__CHANNEL_DRIVER
@@ -11,9 +11,14 @@
 #pragma once
 
 #include <array>
+#include <chrono>
 #include <cstdint>
+#include <exception>
 #include <vector>
 
+#include "myactuator_rmd/can/exceptions.hpp"
+#include "myactuator_rmd/driver/driver_statistics.hpp"
+#include "myactuator_rmd/driver/transfer.hpp"
 #include "myactuator_rmd/protocol/message.hpp"
 
 
@@ -84,6 +89,28 @@ namespace myactuator_rmd {
       virtual std::array<std::uint8_t,8> sendRecv(Message const& request, std::uint32_t const actuator_id, std::uint32_t const request_offset, std::uint32_t const response_offset) = 0;
       // -----------------------------------------------------------------------
 
+      /**\fn sendRecv
+       * \brief
+       *    Exchanges all given transfers with the corresponding actuators. Drivers may write all requests
+       *    before waiting for any reply, by default the transfers are exchanged one after another.
+       *    Transfers whose reply does not arrive in time are marked as timed out and a TimeoutException is
+       *    thrown after all other transfers were exchanged.
+       * 
+       * \param[in,out] transfers
+       *    The transfers to be exchanged, their responses are filled in by the driver
+      */
+      virtual void sendRecv(std::vector<Transfer>& transfers);
+
+      /**\fn getStatistics
+       * \brief
+       *    Get the frame counters of the driver, drivers that do not access a bus report zeros
+       * 
+       * \return
+       *    The number of sent, received and dropped frames
+      */
+      [[nodiscard]]
+      virtual DriverStatistics getStatistics() const;
+
     protected:
       Driver() = default;
       Driver(Driver const&) = default;
@@ -94,6 +121,36 @@ namespace myactuator_rmd {
       friend ActuatorInterface;
   };
 
+  inline void Driver::sendRecv(std::vector<Transfer>& transfers) {
+    std::exception_ptr error {};
+    for (auto& transfer: transfers) {
+      transfer.is_received = false;
+      transfer.is_timed_out = false;
+    }
+    for (auto& transfer: transfers) {
+      RawMessage const request {transfer.request};
+      try {
+        transfer.response = sendRecv(request, transfer.actuator_id, transfer.request_offset, transfer.response_offset);
+        transfer.is_received = true;
+        transfer.timestamp = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch());
+      } catch (can::TimeoutException const&) {
+        // A single missing reply should not prevent the remaining transfers from being exchanged
+        transfer.is_timed_out = true;
+        if (!error) {
+          error = std::current_exception();
+        }
+      }
+    }
+    if (error) {
+      std::rethrow_exception(error);
+    }
+    return;
+  }
+
+  inline DriverStatistics Driver::getStatistics() const {
+    return DriverStatistics{};
+  }
+
 }
 
 #endif // MYACTUATOR_RMD__DRIVER__DRIVER
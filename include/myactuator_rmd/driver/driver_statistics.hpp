@@ -0,0 +1,113 @@
+/**
+ * \file driver_statistics.hpp
+ * \mainpage
+ *    Contains the frame counters reported by a driver
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#ifndef MYACTUATOR_RMD__DRIVER__DRIVER_STATISTICS
+#define MYACTUATOR_RMD__DRIVER__DRIVER_STATISTICS
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
+
+namespace myactuator_rmd {
+
+  /**\class DriverStatistics
+   * \brief
+   *    Frame counters of a driver since it was opened. A growing number of dropped frames means that the
+   *    receive buffer of the socket overflowed and replies were lost, in this case the receive buffer
+   *    should be enlarged or the polling rate reduced. Stale frames are late replies to earlier requests
+   *    that were discarded, retries and timeouts count the outcomes of requests whose reply did not arrive
+   *    in time. The command skew is the time between writing the first and the last request of a batch,
+   *    the bus itself adds the transmission time of a frame between consecutive requests on top.
+  */
+  class DriverStatistics {
+    public:
+      /**\fn DriverStatistics
+       * \brief
+       *    Class constructor
+       *
+       * \param[in] num_sent_frames_
+       *    The number of frames written to the bus
+       * \param[in] num_received_frames_
+       *    The number of frames read from the bus
+       * \param[in] num_dropped_frames_
+       *    The number of frames the kernel dropped as the receive buffer was full
+       * \param[in] num_syscalls_
+       *    The number of system calls made for reading, writing and waiting on the bus
+       * \param[in] num_stale_frames_
+       *    The number of received frames that did not answer any pending request and were discarded
+       * \param[in] num_retries_
+       *    The number of requests that were sent again as their reply did not arrive in time
+       * \param[in] num_timeouts_
+       *    The number of requests that were given up on as no reply arrived before their deadline
+       * \param[in] command_skew_
+       *    The time between writing the first and the last request of the latest batch
+       * \param[in] max_command_skew_
+       *    The largest command skew of all batches
+      */
+      constexpr DriverStatistics(std::uint64_t const num_sent_frames_ = 0, std::uint64_t const num_received_frames_ = 0,
+                                 std::uint64_t const num_dropped_frames_ = 0, std::uint64_t const num_syscalls_ = 0,
+                                 std::uint64_t const num_stale_frames_ = 0, std::uint64_t const num_retries_ = 0,
+                                 std::uint64_t const num_timeouts_ = 0,
+                                 std::chrono::microseconds const& command_skew_ = std::chrono::microseconds(0),
+                                 std::chrono::microseconds const& max_command_skew_ = std::chrono::microseconds(0)) noexcept;
+      DriverStatistics(DriverStatistics const&) = default;
+      DriverStatistics& operator = (DriverStatistics const&) = default;
+      DriverStatistics(DriverStatistics&&) = default;
+      DriverStatistics& operator = (DriverStatistics&&) = default;
+
+      /**\fn operator +=
+       * \brief
+       *    Accumulate the counters of another driver, e.g. of another bus, the larger command skew is kept
+       *
+       * \param[in] other
+       *    The statistics to be added
+       * \return
+       *    The accumulated statistics
+      */
+      constexpr DriverStatistics& operator += (DriverStatistics const& other) noexcept;
+
+      std::uint64_t num_sent_frames;
+      std::uint64_t num_received_frames;
+      std::uint64_t num_dropped_frames;
+      std::uint64_t num_syscalls;
+      std::uint64_t num_stale_frames;
+      std::uint64_t num_retries;
+      std::uint64_t num_timeouts;
+      std::chrono::microseconds command_skew;
+      std::chrono::microseconds max_command_skew;
+  };
+
+  constexpr DriverStatistics::DriverStatistics(std::uint64_t const num_sent_frames_, std::uint64_t const num_received_frames_,
+                                               std::uint64_t const num_dropped_frames_, std::uint64_t const num_syscalls_,
+                                               std::uint64_t const num_stale_frames_, std::uint64_t const num_retries_,
+                                               std::uint64_t const num_timeouts_, std::chrono::microseconds const& command_skew_,
+                                               std::chrono::microseconds const& max_command_skew_) noexcept
+  : num_sent_frames{num_sent_frames_}, num_received_frames{num_received_frames_}, num_dropped_frames{num_dropped_frames_},
+    num_syscalls{num_syscalls_}, num_stale_frames{num_stale_frames_}, num_retries{num_retries_}, num_timeouts{num_timeouts_},
+    command_skew{command_skew_}, max_command_skew{max_command_skew_} {
+    return;
+  }
+
+  constexpr DriverStatistics& DriverStatistics::operator += (DriverStatistics const& other) noexcept {
+    num_sent_frames += other.num_sent_frames;
+    num_received_frames += other.num_received_frames;
+    num_dropped_frames += other.num_dropped_frames;
+    num_syscalls += other.num_syscalls;
+    num_stale_frames += other.num_stale_frames;
+    num_retries += other.num_retries;
+    num_timeouts += other.num_timeouts;
+    command_skew = std::max(command_skew, other.command_skew);
+    max_command_skew = std::max(max_command_skew, other.max_command_skew);
+    return *this;
+  }
+
+}
+
+#endif // MYACTUATOR_RMD__DRIVER__DRIVER_STATISTICS
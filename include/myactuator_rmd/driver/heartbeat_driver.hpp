@@ -0,0 +1,191 @@
+/**
+ * \file heartbeat_driver.hpp
+ * \mainpage
+ *    Contains a wrapper that keeps the communication with idle actuators alive
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#ifndef MYACTUATOR_RMD__DRIVER__HEARTBEAT_DRIVER
+#define MYACTUATOR_RMD__DRIVER__HEARTBEAT_DRIVER
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "myactuator_rmd/driver/driver.hpp"
+#include "myactuator_rmd/driver/driver_statistics.hpp"
+#include "myactuator_rmd/driver/transfer.hpp"
+#include "myactuator_rmd/protocol/message.hpp"
+
+
+namespace myactuator_rmd {
+
+  /**\class HeartbeatDriver
+   * \brief
+   *    Heartbeat manager wrapping a driver: It tracks when a frame was last sent to each registered actuator
+   *    and lets a dedicated thread send a status request to every actuator that did not receive any frame
+   *    within the given period. This keeps actuators whose communication interruption protection is enabled
+   *    (see ActuatorInterface::setTimeout) from tripping while the application thread stalls, e.g. during
+   *    logging bursts. As long as the application commands the actuators regularly no frames are added.
+   *    The wrapped driver must not be used from any other thread while the heartbeat driver exists. Errors of
+   *    the heartbeat thread other than missing replies are rethrown by the next call of the application.
+  */
+  class HeartbeatDriver: public Driver {
+    public:
+      /**\fn HeartbeatDriver
+       * \brief
+       *    Class constructor, starts the heartbeat thread
+       *
+       * \param[in] driver
+       *    The driver communicating over the network interface
+       * \param[in] period
+       *    The maximum time between two frames sent to an actuator, should be well below the communication
+       *    interruption protection time configured on the actuators. A heartbeat waits for its reply for a
+       *    quarter of the period.
+       * \param[in] priority
+       *    The real-time priority [1, 99] of the heartbeat thread, zero keeps the default scheduling
+      */
+      HeartbeatDriver(Driver& driver, std::chrono::microseconds const& period, int const priority = 0);
+      HeartbeatDriver() = delete;
+      HeartbeatDriver(HeartbeatDriver const&) = delete;
+      HeartbeatDriver& operator = (HeartbeatDriver const&) = delete;
+      HeartbeatDriver(HeartbeatDriver&&) = delete;
+      HeartbeatDriver& operator = (HeartbeatDriver&&) = delete;
+
+      /**\fn ~HeartbeatDriver
+       * \brief
+       *    Class destructor, stops the heartbeat thread
+      */
+      ~HeartbeatDriver();
+
+      /**\fn addId
+       * \brief
+       *    Registers an actuator id with the wrapped driver and starts keeping its communication alive
+       *
+       * \param[in] actuator_id
+       *    The id of the actuator
+      */
+      void addId(std::uint32_t const actuator_id) override;
+
+      /**\fn send
+       * \brief
+       *    Sends a message to the given actuator through the wrapped driver
+       *
+       * \param[in] msg
+       *    The message that should be sent to the corresponding actuator
+       * \param[in] actuator_id
+       *    The ID of the actuator that the message should be sent to
+      */
+      void send(Message const& msg, std::uint32_t const actuator_id) override;
+      void send(Message const& msg, std::uint32_t const actuator_id, std::uint32_t const base_offset) override;
+
+      /**\fn sendRecv
+       * \brief
+       *    Sends a request to the given actuator through the wrapped driver and waits for its reply
+       *
+       * \param[in] request
+       *    Request that should be sent to the corresponding actuator
+       * \param[in] actuator_id
+       *    The ID of the actuator that the message should be sent to
+       * \return
+       *    The response bytes
+      */
+      [[nodiscard]]
+      std::array<std::uint8_t,8> sendRecv(Message const& request, std::uint32_t const actuator_id) override;
+      [[nodiscard]]
+      std::array<std::uint8_t,8> sendRecv(Message const& request, std::uint32_t const actuator_id,
+                                          std::uint32_t const request_offset, std::uint32_t const response_offset) override;
+
+      /**\fn sendRecv
+       * \brief
+       *    Exchanges all given transfers through the wrapped driver
+       *
+       * \param[in,out] transfers
+       *    The transfers to be exchanged, their responses are filled in by the driver
+      */
+      void sendRecv(std::vector<Transfer>& transfers) override;
+
+      /**\fn getStatistics
+       * \brief
+       *    Get the frame counters of the wrapped driver including the frames of the heartbeat
+       *
+       * \return
+       *    The frame counters of the wrapped driver
+      */
+      [[nodiscard]]
+      DriverStatistics getStatistics() const override;
+
+      /**\fn getNumHeartbeats
+       * \brief
+       *    Get the number of status requests sent by the heartbeat thread to actuators that were idle
+       *
+       * \return
+       *    The number of heartbeat frames
+      */
+      [[nodiscard]]
+      std::uint64_t getNumHeartbeats() const;
+
+      /**\fn getNumFailedHeartbeats
+       * \brief
+       *    Get the number of status requests of the heartbeat thread that were not answered, e.g. because the
+       *    actuator is not connected
+       *
+       * \return
+       *    The number of failed heartbeat frames
+      */
+      [[nodiscard]]
+      std::uint64_t getNumFailedHeartbeats() const;
+
+    protected:
+      /**\fn rethrowError
+       * \brief
+       *    Rethrow and clear the last error of the heartbeat thread that was not a missing reply
+      */
+      void rethrowError();
+
+      /**\fn touch
+       * \brief
+       *    Store that a frame was sent to the given actuator
+       *
+       * \param[in] actuator_id
+       *    The ID of the actuator that a frame was sent to
+       * \param[in] time
+       *    The time the frame was sent at
+      */
+      void touch(std::uint32_t const actuator_id, std::chrono::steady_clock::time_point const& time);
+
+      /**\fn run
+       * \brief
+       *    The loop executed by the heartbeat thread
+       *
+       * \param[in] priority
+       *    The real-time priority of the thread, zero keeps the default scheduling
+      */
+      void run(int const priority);
+
+      Driver& driver_;
+      std::chrono::microseconds period_;
+      mutable std::mutex driver_mutex_;
+      mutable std::mutex mutex_;
+      std::condition_variable condition_;
+      std::map<std::uint32_t,std::chrono::steady_clock::time_point> last_sent_;
+      std::vector<Transfer> heartbeats_;
+      std::uint64_t num_heartbeats_;
+      std::uint64_t num_failed_heartbeats_;
+      bool is_running_;
+      bool is_started_;
+      std::exception_ptr error_;
+      std::thread thread_;
+  };
+
+}
+
+#endif // MYACTUATOR_RMD__DRIVER__HEARTBEAT_DRIVER
@@ -0,0 +1,230 @@
+/**
+ * \file multi_bus_driver.hpp
+ * \mainpage
+ *    Contains a driver that shards actuators across several CAN interfaces
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#ifndef MYACTUATOR_RMD__DRIVER__MULTI_BUS_DRIVER
+#define MYACTUATOR_RMD__DRIVER__MULTI_BUS_DRIVER
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "myactuator_rmd/driver/driver.hpp"
+#include "myactuator_rmd/driver/driver_statistics.hpp"
+#include "myactuator_rmd/driver/transfer.hpp"
+#include "myactuator_rmd/protocol/message.hpp"
+
+
+namespace myactuator_rmd {
+
+  /**\class MultiBusDriver
+   * \brief
+   *    Driver for actuators spread over several buses. Actuators are addressed by a handle that encodes the
+   *    bus and the actuator id on that bus, handles [1, 32] correspond to the first bus, [33, 64] to the second
+   *    one and so on. Batches of transfers are split by bus and exchanged on all buses in parallel by one
+   *    thread per bus, so that a control cycle only takes as long as the slowest bus.
+  */
+  class MultiBusDriver: public Driver {
+    public:
+      /**\fn MultiBusDriver
+       * \brief
+       *    Class constructor opening a CAN driver for each interface
+       *
+       * \param[in] ifnames
+       *    The names of the network interfaces, their order defines the bus index
+      */
+      MultiBusDriver(std::vector<std::string> const& ifnames);
+
+      /**\fn MultiBusDriver
+       * \brief
+       *    Class constructor
+       *
+       * \param[in] drivers
+       *    The drivers of the individual buses, their order defines the bus index
+      */
+      MultiBusDriver(std::vector<std::shared_ptr<Driver>> const& drivers);
+      MultiBusDriver() = delete;
+      MultiBusDriver(MultiBusDriver const&) = delete;
+      MultiBusDriver& operator = (MultiBusDriver const&) = delete;
+      MultiBusDriver(MultiBusDriver&&) = delete;
+      MultiBusDriver& operator = (MultiBusDriver&&) = delete;
+      ~MultiBusDriver();
+
+      /**\fn getHandle
+       * \brief
+       *    Get the handle of an actuator on a given bus
+       *
+       * \param[in] bus
+       *    The index of the bus
+       * \param[in] actuator_id
+       *    The id of the actuator on the bus [1, 32]
+       * \return
+       *    The handle used for addressing the actuator through this driver
+      */
+      [[nodiscard]]
+      static constexpr std::uint32_t getHandle(std::size_t const bus, std::uint32_t const actuator_id) noexcept;
+
+      /**\fn getNumBuses
+       * \brief
+       *    Get the number of buses
+       *
+       * \return
+       *    The number of buses
+      */
+      [[nodiscard]]
+      std::size_t getNumBuses() const noexcept;
+
+      /**\fn addId
+       * \brief
+       *    Registers an actuator with the driver of its bus
+       *
+       * \param[in] handle
+       *    The handle of the actuator
+      */
+      void addId(std::uint32_t const handle) override;
+
+      /**\fn send
+       * \brief
+       *    Sends a message to the given actuator without waiting for a reply
+       *
+       * \param[in] msg
+       *    The message that should be sent to the corresponding actuator
+       * \param[in] handle
+       *    The handle of the actuator that the message should be sent to
+      */
+      void send(Message const& msg, std::uint32_t const handle) override;
+      void send(Message const& msg, std::uint32_t const handle, std::uint32_t const base_offset) override;
+
+      /**\fn sendRecv
+       * \brief
+       *    Sends a request to the given actuator and waits for its reply
+       *
+       * \param[in] request
+       *    Request that should be sent to the corresponding actuator
+       * \param[in] handle
+       *    The handle of the actuator that the message should be sent to
+       * \return
+       *    The response bytes
+      */
+      [[nodiscard]]
+      std::array<std::uint8_t,8> sendRecv(Message const& request, std::uint32_t const handle) override;
+      [[nodiscard]]
+      std::array<std::uint8_t,8> sendRecv(Message const& request, std::uint32_t const handle,
+                                          std::uint32_t const request_offset, std::uint32_t const response_offset) override;
+
+      /**\fn sendRecv
+       * \brief
+       *    Splits the transfers by bus and exchanges them on all buses in parallel. If any bus fails the first
+       *    error is rethrown after all buses have finished.
+       *
+       * \param[in,out] transfers
+       *    The transfers addressed by actuator handles, their responses are filled in by the driver
+      */
+      void sendRecv(std::vector<Transfer>& transfers) override;
+
+      /**\fn getStatistics
+       * \brief
+       *    Get the frame counters accumulated over all buses
+       *
+       * \return
+       *    The number of sent, received and dropped frames of all buses
+      */
+      [[nodiscard]]
+      DriverStatistics getStatistics() const override;
+
+    protected:
+      /**\class Bus
+       * \brief
+       *    A single bus together with the thread exchanging its part of a batch
+      */
+      class Bus {
+        public:
+          Bus(std::shared_ptr<Driver> const& driver_);
+          Bus() = delete;
+          Bus(Bus const&) = delete;
+          Bus& operator = (Bus const&) = delete;
+          Bus(Bus&&) = delete;
+          Bus& operator = (Bus&&) = delete;
+
+          std::shared_ptr<Driver> driver;
+          std::mutex driver_mutex;
+          // Part of the current batch addressed by local actuator ids and their position in the batch
+          std::vector<Transfer> transfers;
+          std::vector<std::size_t> indices;
+          std::exception_ptr error;
+          std::mutex mutex;
+          std::condition_variable condition;
+          bool is_requested;
+          bool is_done;
+          std::thread thread;
+      };
+
+      /**\fn getBus
+       * \brief
+       *    Get the bus of the given actuator handle
+       *
+       * \param[in] handle
+       *    The handle of the actuator
+       * \return
+       *    The bus the actuator is connected to
+      */
+      [[nodiscard]]
+      Bus& getBus(std::uint32_t const handle);
+
+      /**\fn getActuatorId
+       * \brief
+       *    Get the actuator id on its bus from the actuator handle
+       *
+       * \param[in] handle
+       *    The handle of the actuator
+       * \return
+       *    The actuator id on its bus [1, 32]
+      */
+      [[nodiscard]]
+      static constexpr std::uint32_t getActuatorId(std::uint32_t const handle) noexcept;
+
+      /**\fn exchange
+       * \brief
+       *    Exchange the part of the current batch of a single bus
+       *
+       * \param[in,out] bus
+       *    The bus whose transfers should be exchanged
+      */
+      static void exchange(Bus& bus) noexcept;
+
+      /**\fn run
+       * \brief
+       *    The loop executed by the thread of a bus
+       *
+       * \param[in,out] bus
+       *    The bus handled by the thread
+      */
+      void run(Bus& bus);
+
+      std::vector<std::unique_ptr<Bus>> buses_;
+      std::atomic<bool> is_running_;
+  };
+
+  constexpr std::uint32_t MultiBusDriver::getHandle(std::size_t const bus, std::uint32_t const actuator_id) noexcept {
+    return static_cast<std::uint32_t>(32*bus) + actuator_id;
+  }
+
+  constexpr std::uint32_t MultiBusDriver::getActuatorId(std::uint32_t const handle) noexcept {
+    return (handle - 1) % 32 + 1;
+  }
+
+}
+
+#endif // MYACTUATOR_RMD__DRIVER__MULTI_BUS_DRIVER
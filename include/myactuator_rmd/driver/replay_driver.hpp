@@ -0,0 +1,227 @@
+/**
+ * \file replay_driver.hpp
+ * \mainpage
+ *    Contains a driver that replays previously recorded CAN traffic
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#ifndef MYACTUATOR_RMD__DRIVER__REPLAY_DRIVER
+#define MYACTUATOR_RMD__DRIVER__REPLAY_DRIVER
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "myactuator_rmd/can/frame.hpp"
+#include "myactuator_rmd/driver/driver.hpp"
+#include "myactuator_rmd/protocol/message.hpp"
+
+
+namespace myactuator_rmd {
+
+  /**\class RecordedFrame
+   * \brief
+   *    A single CAN frame of a recording together with the time it was captured at
+  */
+  class RecordedFrame {
+    public:
+      /**\fn RecordedFrame
+       * \brief
+       *    Class constructor
+       *
+       * \param[in] timestamp_
+       *    The time the frame was captured at (e.g. since the Unix epoch)
+       * \param[in] frame_
+       *    The captured CAN frame
+      */
+      constexpr RecordedFrame(std::chrono::microseconds const& timestamp_, can::Frame const& frame_) noexcept;
+      RecordedFrame() = delete;
+      RecordedFrame(RecordedFrame const&) = default;
+      RecordedFrame& operator = (RecordedFrame const&) = default;
+      RecordedFrame(RecordedFrame&&) = default;
+      RecordedFrame& operator = (RecordedFrame&&) = default;
+
+      std::chrono::microseconds timestamp;
+      can::Frame frame;
+  };
+
+  constexpr RecordedFrame::RecordedFrame(std::chrono::microseconds const& timestamp_, can::Frame const& frame_) noexcept
+  : timestamp{timestamp_}, frame{frame_} {
+    return;
+  }
+
+  /**\fn readCandumpLog
+   * \brief
+   *    Parse a recording in the log file format written by 'candump -l' or 'candump -L', e.g.
+   *    '(1700000000.123456) can0 241#9C1E0A00E8030500'. Lines that can not be parsed as well as
+   *    CAN FD and remote frames are skipped.
+   *
+   * \param[in] is
+   *    The input stream holding the candump log
+   * \return
+   *    The recorded frames in the order of the log
+  */
+  [[nodiscard]]
+  std::vector<RecordedFrame> readCandumpLog(std::istream& is);
+
+  /**\fn readCandumpLog
+   * \brief
+   *    Parse a recording in the log file format written by 'candump -l'
+   *
+   * \param[in] filename
+   *    The path to the candump log file
+   * \return
+   *    The recorded frames in the order of the log
+  */
+  [[nodiscard]]
+  std::vector<RecordedFrame> readCandumpLog(std::string const& filename);
+
+  /**\fn readBinaryLog
+   * \brief
+   *    Parse a recording in the binary format written by \ref writeBinaryLog, a sequence of records consisting
+   *    of a little-endian 64-bit timestamp in microseconds, a 32-bit CAN id and the 8 data bytes
+   *
+   * \param[in] is
+   *    The input stream holding the binary log
+   * \return
+   *    The recorded frames in the order of the log
+  */
+  [[nodiscard]]
+  std::vector<RecordedFrame> readBinaryLog(std::istream& is);
+
+  /**\fn readBinaryLog
+   * \brief
+   *    Parse a recording in the binary format written by \ref writeBinaryLog
+   *
+   * \param[in] filename
+   *    The path to the binary log file
+   * \return
+   *    The recorded frames in the order of the log
+  */
+  [[nodiscard]]
+  std::vector<RecordedFrame> readBinaryLog(std::string const& filename);
+
+  /**\fn writeBinaryLog
+   * \brief
+   *    Write a recording in the compact binary format that can be read with \ref readBinaryLog
+   *
+   * \param[in,out] os
+   *    The output stream the recording should be written to
+   * \param[in] frames
+   *    The recorded frames to be written
+  */
+  void writeBinaryLog(std::ostream& os, std::vector<RecordedFrame> const& frames);
+
+  /**\enum ReplayMode
+   * \brief
+   *    Strongly typed enum for the timing used when replaying a recording
+  */
+  enum class ReplayMode {
+    ORIGINAL_TIMING,
+    AS_FAST_AS_POSSIBLE
+  };
+
+  /**\class ReplayDriver
+   * \brief
+   *    Driver that serves the responses of a previous recording instead of communicating over a network
+   *    interface. Requests are not sent anywhere: each request is answered with the next recorded response
+   *    of the corresponding actuator, which allows re-running control algorithms deterministically on real data.
+  */
+  class ReplayDriver: public Driver {
+    public:
+      /**\fn ReplayDriver
+       * \brief
+       *    Class constructor
+       *
+       * \param[in] frames
+       *    The recorded frames, requests contained in the recording are ignored
+       * \param[in] mode
+       *    The timing used for replaying the responses
+      */
+      ReplayDriver(std::vector<RecordedFrame> const& frames, ReplayMode const mode = ReplayMode::AS_FAST_AS_POSSIBLE);
+      ReplayDriver() = delete;
+      ReplayDriver(ReplayDriver const&) = default;
+      ReplayDriver& operator = (ReplayDriver const&) = default;
+      ReplayDriver(ReplayDriver&&) = default;
+      ReplayDriver& operator = (ReplayDriver&&) = default;
+
+      /**\fn addId
+       * \brief
+       *    Registers an actuator id, only checks if it is in the admittable range
+       *
+       * \param[in] actuator_id
+       *    The id of the actuator [1, 32]
+      */
+      void addId(std::uint32_t const actuator_id) override;
+
+      /**\fn send
+       * \brief
+       *    Requests without reply are discarded
+       *
+       * \param[in] msg
+       *    The message that should be sent to the corresponding actuator
+       * \param[in] actuator_id
+       *    The ID of the actuator that the message should be sent to
+      */
+      void send(Message const& msg, std::uint32_t const actuator_id) override;
+      void send(Message const& msg, std::uint32_t const actuator_id, std::uint32_t const base_offset) override;
+
+      /**\fn sendRecv
+       * \brief
+       *    Returns the next recorded response of the given actuator
+       *
+       * \param[in] request
+       *    Request that should be sent to the corresponding actuator
+       * \param[in] actuator_id
+       *    The ID of the actuator that the message should be sent to
+       * \return
+       *    The recorded response bytes
+      */
+      [[nodiscard]]
+      std::array<std::uint8_t,8> sendRecv(Message const& request, std::uint32_t const actuator_id) override;
+      [[nodiscard]]
+      std::array<std::uint8_t,8> sendRecv(Message const& request, std::uint32_t const actuator_id, std::uint32_t const request_offset, std::uint32_t const response_offset) override;
+      using Driver::sendRecv;
+
+      /**\fn getRemaining
+       * \brief
+       *    Get the number of recorded responses that were not replayed yet
+       *
+       * \return
+       *    The number of remaining responses for all actuators
+      */
+      [[nodiscard]]
+      std::size_t getRemaining() const noexcept;
+
+    protected:
+      /**\fn recv
+       * \brief
+       *    Pop the next recorded frame with the given CAN id, in case of the original timing wait until
+       *    it is due relative to the first replayed frame
+       *
+       * \param[in] can_id
+       *    The CAN id of the response
+       * \return
+       *    The response bytes
+      */
+      [[nodiscard]]
+      std::array<std::uint8_t,8> recv(std::uint32_t const can_id);
+
+      ReplayMode mode_;
+      std::map<std::uint32_t,std::deque<RecordedFrame>> responses_;
+      std::chrono::microseconds first_timestamp_;
+      std::chrono::steady_clock::time_point start_;
+      bool is_started_;
+  };
+
+}
+
+#endif // MYACTUATOR_RMD__DRIVER__REPLAY_DRIVER
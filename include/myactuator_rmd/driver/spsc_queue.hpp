@@ -0,0 +1,142 @@
+/**
+ * \file spsc_queue.hpp
+ * \mainpage
+ *    Contains a wait-free single-producer single-consumer ring buffer
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#ifndef MYACTUATOR_RMD__DRIVER__SPSC_QUEUE
+#define MYACTUATOR_RMD__DRIVER__SPSC_QUEUE
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+
+namespace myactuator_rmd {
+
+  // Assumed size of a cache line, indices written by different threads are kept on separate lines
+  inline constexpr std::size_t cache_line_size {64};
+
+  /**\class SpscQueue
+   * \brief
+   *    Bounded wait-free ring buffer for handing elements from exactly one producer thread to exactly one
+   *    consumer thread. Pushing and popping never block and never allocate.
+   *
+   * \tparam T
+   *    The type of the elements, has to be default-constructible
+   * \tparam N
+   *    The capacity of the queue, has to be a power of two
+  */
+  template <typename T, std::size_t N>
+  class SpscQueue {
+    static_assert((N >= 2) && ((N & (N - 1)) == 0), "Capacity has to be a power of two!");
+
+    public:
+      SpscQueue() = default;
+      SpscQueue(SpscQueue const&) = delete;
+      SpscQueue& operator = (SpscQueue const&) = delete;
+      SpscQueue(SpscQueue&&) = delete;
+      SpscQueue& operator = (SpscQueue&&) = delete;
+
+      /**\fn tryPush
+       * \brief
+       *    Append an element to the queue, may only be called from the producer thread
+       *
+       * \param[in] value
+       *    The element to be appended
+       * \return
+       *    True if the element was appended, false if the queue is full
+      */
+      template <typename U>
+      [[nodiscard]]
+      bool tryPush(U&& value);
+
+      /**\fn tryPop
+       * \brief
+       *    Remove the oldest element from the queue, may only be called from the consumer thread
+       *
+       * \param[out] value
+       *    The removed element
+       * \return
+       *    True if an element was removed, false if the queue is empty
+      */
+      [[nodiscard]]
+      bool tryPop(T& value);
+
+      /**\fn size
+       * \brief
+       *    Get the number of elements in the queue, only a snapshot if called while the other thread is active
+       *
+       * \return
+       *    The number of elements in the queue
+      */
+      [[nodiscard]]
+      std::size_t size() const noexcept;
+
+      /**\fn capacity
+       * \brief
+       *    Get the maximum number of elements the queue can hold
+       *
+       * \return
+       *    The capacity of the queue
+      */
+      [[nodiscard]]
+      static constexpr std::size_t capacity() noexcept;
+
+    protected:
+      // Monotonically increasing indices, the position in the buffer is given by the lower bits
+      alignas(cache_line_size) std::atomic<std::size_t> head_ {0};
+      std::size_t cached_tail_ {0};
+      alignas(cache_line_size) std::atomic<std::size_t> tail_ {0};
+      std::size_t cached_head_ {0};
+      alignas(cache_line_size) std::array<T,N> buffer_ {};
+  };
+
+  template <typename T, std::size_t N>
+  template <typename U>
+  bool SpscQueue<T,N>::tryPush(U&& value) {
+    auto const tail {tail_.load(std::memory_order_relaxed)};
+    if (tail - cached_head_ == N) {
+      cached_head_ = head_.load(std::memory_order_acquire);
+      if (tail - cached_head_ == N) {
+        return false;
+      }
+    }
+    buffer_[tail & (N - 1)] = std::forward<U>(value);
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  template <typename T, std::size_t N>
+  bool SpscQueue<T,N>::tryPop(T& value) {
+    auto const head {head_.load(std::memory_order_relaxed)};
+    if (head == cached_tail_) {
+      cached_tail_ = tail_.load(std::memory_order_acquire);
+      if (head == cached_tail_) {
+        return false;
+      }
+    }
+    value = std::move(buffer_[head & (N - 1)]);
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  template <typename T, std::size_t N>
+  std::size_t SpscQueue<T,N>::size() const noexcept {
+    auto const head {head_.load(std::memory_order_acquire)};
+    auto const tail {tail_.load(std::memory_order_acquire)};
+    return tail - head;
+  }
+
+  template <typename T, std::size_t N>
+  constexpr std::size_t SpscQueue<T,N>::capacity() noexcept {
+    return N;
+  }
+
+}
+
+#endif // MYACTUATOR_RMD__DRIVER__SPSC_QUEUE
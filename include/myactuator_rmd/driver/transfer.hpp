@@ -0,0 +1,139 @@
+/**
+ * \file transfer.hpp
+ * \mainpage
+ *    Contains a single request-response exchange with an actuator
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#ifndef MYACTUATOR_RMD__DRIVER__TRANSFER
+#define MYACTUATOR_RMD__DRIVER__TRANSFER
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+#include "myactuator_rmd/driver/can_address_offset.hpp"
+#include "myactuator_rmd/protocol/command_type.hpp"
+
+
+namespace myactuator_rmd {
+
+  /**\class Transfer
+   * \brief
+   *    A single request-response exchange with an actuator. Several transfers can be handed to a driver at
+   *    once so that all requests are written before any reply is waited for. Each transfer may carry its own
+   *    deadline: A missing reply only marks its own transfer as timed out while the others are still awaited.
+   *    The time a reply was received at is stored in microseconds since the Unix epoch, as stamped by the kernel
+   *    if the driver supports it.
+  */
+  class Transfer {
+    public:
+      /**\fn Transfer
+       * \brief
+       *    Class constructor
+       *
+       * \param[in] actuator_id_
+       *    The ID of the actuator that the request should be sent to
+       * \param[in] request_
+       *    The serialised request
+       * \param[in] request_offset_
+       *    The CAN id offset the request should be sent to
+       * \param[in] response_offset_
+       *    The CAN id offset the response is expected from
+       * \param[in] timeout_
+       *    The time the response may take after the batch was started, zero uses the receive timeout of the driver
+      */
+      constexpr Transfer(std::uint32_t const actuator_id_ = 0, std::array<std::uint8_t,8> const& request_ = {},
+                         std::uint32_t const request_offset_ = CanAddressOffset::request,
+                         std::uint32_t const response_offset_ = CanAddressOffset::response,
+                         std::chrono::microseconds const& timeout_ = std::chrono::microseconds(0)) noexcept;
+      Transfer(Transfer const&) = default;
+      Transfer& operator = (Transfer const&) = default;
+      Transfer(Transfer&&) = default;
+      Transfer& operator = (Transfer&&) = default;
+
+      std::uint32_t actuator_id;
+      std::uint32_t request_offset;
+      std::uint32_t response_offset;
+      std::array<std::uint8_t,8> request;
+      std::array<std::uint8_t,8> response;
+      std::chrono::microseconds timeout;
+      bool is_received;
+      bool is_timed_out;
+      std::chrono::microseconds timestamp;
+  };
+
+  constexpr Transfer::Transfer(std::uint32_t const actuator_id_, std::array<std::uint8_t,8> const& request_,
+                               std::uint32_t const request_offset_, std::uint32_t const response_offset_,
+                               std::chrono::microseconds const& timeout_) noexcept
+  : actuator_id{actuator_id_}, request_offset{request_offset_}, response_offset{response_offset_},
+    request{request_}, response{}, timeout{timeout_}, is_received{false}, is_timed_out{false}, timestamp{0} {
+    return;
+  }
+
+  /**\fn isIdempotent
+   * \brief
+   *    Check if the request of a transfer only reads from the actuator so that it can safely be sent again
+   *    if its reply is lost. Set-points and commands writing to the actuator (e.g. setting the CAN id or the
+   *    encoder zero) are never repeated.
+   * 
+   * \param[in] transfer
+   *    The transfer whose request should be checked
+   * \return
+   *    True if the request may be repeated, false otherwise
+  */
+  [[nodiscard]]
+  constexpr bool isIdempotent(Transfer const& transfer) noexcept {
+    if (transfer.request_offset != CanAddressOffset::request) {
+      return false;
+    }
+    auto const command {transfer.request[0]};
+    // The CAN id is read with the command that also sets it
+    return (command == CommandType::READ_PID_PARAMETERS) || (command == CommandType::READ_ACCELERATION) ||
+           (command == CommandType::READ_MULTI_TURN_ENCODER_POSITION) ||
+           (command == CommandType::READ_MULTI_TURN_ENCODER_ORIGINAL_POSITION) ||
+           (command == CommandType::READ_MULTI_TURN_ENCODER_ZERO_OFFSET) ||
+           (command == CommandType::READ_SINGLE_TURN_ENCODER) || (command == CommandType::READ_MULTI_TURN_ANGLE) ||
+           (command == CommandType::READ_SINGLE_TURN_ANGLE) || (command == CommandType::READ_MOTOR_STATUS_1_AND_ERROR_FLAG) ||
+           (command == CommandType::READ_MOTOR_STATUS_2) || (command == CommandType::READ_MOTOR_STATUS_3) ||
+           (command == CommandType::READ_SYSTEM_OPERATING_MODE) || (command == CommandType::READ_MOTOR_POWER) ||
+           (command == CommandType::READ_SYSTEM_RUNTIME) || (command == CommandType::READ_SYSTEM_SOFTWARE_VERSION_DATE) ||
+           (command == CommandType::READ_MOTOR_MODEL) ||
+           ((command == CommandType::CAN_ID_SETTING) && (transfer.request[2] == 1));
+  }
+
+  /**\fn isReply
+   * \brief
+   *    Check if a received frame answers the request of a transfer. Replies echo the command of the request,
+   *    replies to motion control commands echo the id of the actuator instead. Replies to reading or writing a
+   *    single controller gain additionally echo the gain type so that several of them can be pending at once.
+   * 
+   * \param[in] transfer
+   *    The transfer waiting for its reply
+   * \param[in] can_id
+   *    The CAN id of the received frame
+   * \param[in] data
+   *    The data of the received frame
+   * \return
+   *    True if the frame is the reply to the request, false if it is e.g. a late reply to an earlier request
+  */
+  [[nodiscard]]
+  constexpr bool isReply(Transfer const& transfer, std::uint32_t const can_id, std::array<std::uint8_t,8> const& data) noexcept {
+    if (can_id != transfer.response_offset + transfer.actuator_id) {
+      return false;
+    } else if (transfer.response_offset == CanAddressOffset::response_motion_control) {
+      return data[0] == transfer.actuator_id;
+    }
+    auto const command {transfer.request[0]};
+    // Reading or writing all gains at once leaves the gain type empty
+    if (((command == CommandType::READ_PID_PARAMETERS) || (command == CommandType::WRITE_PID_PARAMETERS_TO_RAM) ||
+         (command == CommandType::WRITE_PID_PARAMETERS_TO_ROM)) && (transfer.request[1] != 0)) {
+      return (data[0] == command) && (data[1] == transfer.request[1]);
+    }
+    return data[0] == command;
+  }
+}
+
+#endif // MYACTUATOR_RMD__DRIVER__TRANSFER
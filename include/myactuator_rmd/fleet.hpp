@@ -0,0 +1,202 @@
+/**
+ * \file fleet.hpp
+ * \mainpage
+ *    Contains functions for discovering and configuring all actuators on a bus in parallel
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#ifndef MYACTUATOR_RMD__FLEET
+#define MYACTUATOR_RMD__FLEET
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "myactuator_rmd/actuator_state/acceleration_type.hpp"
+#include "myactuator_rmd/actuator_state/gain_type.hpp"
+#include "myactuator_rmd/actuator_state/gains.hpp"
+#include "myactuator_rmd/driver/driver.hpp"
+#include "myactuator_rmd/driver/transfer.hpp"
+
+
+namespace myactuator_rmd {
+
+  /**\class ActuatorInfo
+   * \brief
+   *    Inventory entry of an actuator found on the bus
+  */
+  class ActuatorInfo {
+    public:
+      /**\fn ActuatorInfo
+       * \brief
+       *    Class constructor
+       *
+       * \param[in] actuator_id_
+       *    The id of the actuator [1, 32]
+       * \param[in] motor_model_
+       *    The motor model string
+       * \param[in] version_date_
+       *    The version date of the firmware, e.g. 20220206
+       * \param[in] gains_
+       *    The current controller gains
+       * \param[in] acceleration_
+       *    The current acceleration in dps/s
+      */
+      ActuatorInfo(std::uint32_t const actuator_id_ = 0, std::string const& motor_model_ = "",
+                   std::uint32_t const version_date_ = 0, Gains const& gains_ = {}, std::int32_t const acceleration_ = 0);
+      ActuatorInfo(ActuatorInfo const&) = default;
+      ActuatorInfo& operator = (ActuatorInfo const&) = default;
+      ActuatorInfo(ActuatorInfo&&) = default;
+      ActuatorInfo& operator = (ActuatorInfo&&) = default;
+
+      std::uint32_t actuator_id;
+      std::string motor_model;
+      std::uint32_t version_date;
+      Gains gains;
+      std::int32_t acceleration;
+  };
+
+  /**\fn discoverActuators
+   * \brief
+   *    Probe the given actuator ids on the bus all at once and read the inventory of the ones that answer.
+   *    All probes are written before any reply is waited for, so absent actuators only cost the given
+   *    timeout once instead of the receive timeout of the driver each. The ids are added to the driver.
+   *
+   * \param[in] driver
+   *    The driver communicating over the network interface
+   * \param[in] timeout
+   *    The time the actuators may take to reply to the probes and to the following reads
+   * \param[in] actuator_ids
+   *    The ids to be probed, all ids [1, 32] if empty
+   * \return
+   *    The inventory of all actuators that answered, ordered by their id
+  */
+  [[nodiscard]]
+  std::vector<ActuatorInfo> discoverActuators(Driver& driver,
+                                              std::chrono::microseconds const& timeout = std::chrono::milliseconds(20),
+                                              std::vector<std::uint32_t> const& actuator_ids = {});
+
+  /**\fn getAllGains
+   * \brief
+   *    Read the values of all gain types of several actuators with a single batch, throws a TimeoutException
+   *    if an actuator did not answer in time. The ids are added to the driver.
+   *
+   * \param[in] driver
+   *    The driver communicating over the network interface
+   * \param[in] actuator_ids
+   *    The ids of the actuators to be read
+   * \param[in] timeout
+   *    The time the actuators may take to reply
+   * \return
+   *    The gain values by gain type for each actuator id
+  */
+  [[nodiscard]]
+  std::map<std::uint32_t,std::map<GainType,float>> getAllGains(Driver& driver, std::vector<std::uint32_t> const& actuator_ids,
+                                                               std::chrono::microseconds const& timeout = std::chrono::milliseconds(20));
+
+  /**\class FleetConfiguration
+   * \brief
+   *    Collects configuration commands for several actuators that are then sent as a single batch, so that
+   *    configuring all actuators takes about as long as configuring a single one
+  */
+  class FleetConfiguration {
+    public:
+      FleetConfiguration() = default;
+      FleetConfiguration(FleetConfiguration const&) = default;
+      FleetConfiguration& operator = (FleetConfiguration const&) = default;
+      FleetConfiguration(FleetConfiguration&&) = default;
+      FleetConfiguration& operator = (FleetConfiguration&&) = default;
+
+      /**\fn setAcceleration
+       * \brief
+       *    Add setting the acceleration of an actuator
+       *
+       * \param[in] actuator_id
+       *    The id of the actuator
+       * \param[in] acceleration
+       *    The desired acceleration/deceleration in dps with a resolution of 1 dps [100, 60000]
+       * \param[in] mode
+       *    The mode of the desired acceleration/deceleration to be set
+       * \return
+       *    The configuration for chaining further commands
+      */
+      FleetConfiguration& setAcceleration(std::uint32_t const actuator_id, std::uint32_t const acceleration,
+                                          AccelerationType const mode);
+
+      /**\fn setControllerGains
+       * \brief
+       *    Add setting the controller gains of an actuator
+       *
+       * \param[in] actuator_id
+       *    The id of the actuator
+       * \param[in] gains
+       *    The PI-gains for current, speed and position to be set
+       * \param[in] is_persistent
+       *    Whether the gains should be written to the ROM or only to the RAM
+       * \return
+       *    The configuration for chaining further commands
+      */
+      FleetConfiguration& setControllerGains(std::uint32_t const actuator_id, Gains const& gains, bool const is_persistent = false);
+
+      /**\fn setAllGains
+       * \brief
+       *    Add setting the values of several gain types of an actuator
+       *
+       * \param[in] actuator_id
+       *    The id of the actuator
+       * \param[in] gains
+       *    The gain values to be set by gain type
+       * \param[in] is_persistent
+       *    Whether the gains should be written to the ROM or only to the RAM
+       * \return
+       *    The configuration for chaining further commands
+      */
+      FleetConfiguration& setAllGains(std::uint32_t const actuator_id, std::map<GainType,float> const& gains,
+                                      bool const is_persistent = false);
+
+      /**\fn setTimeout
+       * \brief
+       *    Add setting the communication interruption protection time of an actuator
+       *
+       * \param[in] actuator_id
+       *    The id of the actuator
+       * \param[in] timeout
+       *    The time after which the actuator brakes if no command is received, zero disables it
+       * \return
+       *    The configuration for chaining further commands
+      */
+      FleetConfiguration& setTimeout(std::uint32_t const actuator_id, std::chrono::milliseconds const& timeout);
+
+      /**\fn size
+       * \brief
+       *    Get the number of collected commands
+       *
+       * \return
+       *    The number of commands
+      */
+      [[nodiscard]]
+      std::size_t size() const noexcept;
+
+      /**\fn apply
+       * \brief
+       *    Send all collected commands as a single batch, throws a TimeoutException if an actuator did not
+       *    acknowledge its commands in time
+       *
+       * \param[in] driver
+       *    The driver communicating over the network interface
+       * \param[in] timeout
+       *    The time the actuators may take to acknowledge the commands
+      */
+      void apply(Driver& driver, std::chrono::microseconds const& timeout = std::chrono::milliseconds(20));
+
+    protected:
+      std::vector<Transfer> transfers_;
+  };
+
+}
+
+#endif // MYACTUATOR_RMD__FLEET
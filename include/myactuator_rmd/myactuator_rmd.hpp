@@ -10,12 +10,23 @@
 #define MYACTUATOR_RMD__MYACTUATOR_RMD
 #pragma once
 
+#include "myactuator_rmd/driver/async_driver.hpp"
+#include "myactuator_rmd/driver/bus_io_thread.hpp"
 #include "myactuator_rmd/driver/can_driver.hpp"
+#include "myactuator_rmd/driver/channel_driver.hpp"
 #include "myactuator_rmd/driver/driver.hpp"
+#include "myactuator_rmd/driver/driver_statistics.hpp"
+#include "myactuator_rmd/driver/heartbeat_driver.hpp"
+#include "myactuator_rmd/driver/multi_bus_driver.hpp"
+#include "myactuator_rmd/driver/replay_driver.hpp"
 #include "myactuator_rmd/actuator_constants.hpp"
+#include "myactuator_rmd/actuator_group.hpp"
 #include "myactuator_rmd/actuator_interface.hpp"
+#include "myactuator_rmd/async_actuator_interface.hpp"
 #include "myactuator_rmd/exceptions.hpp"
+#include "myactuator_rmd/fleet.hpp"
 #include "myactuator_rmd/io.hpp"
+#include "myactuator_rmd/thread_affinity.hpp"
 #include "myactuator_rmd/version.hpp"
 
 #endif // MYACTUATOR_RMD__MYACTUATOR_RMD
@@ -92,6 +92,31 @@ namespace myactuator_rmd {
     return;
   }
 
+  /**\class RawMessage
+   * \brief
+   *    Message holding arbitrary data, e.g. a request that was already serialised before
+  */
+  class RawMessage: public Message {
+    public:
+      /**\fn RawMessage
+       * \brief
+       *    Class constructor
+       * 
+       * \param[in] data
+       *    The data to be transmitted to the CAN node
+      */
+      constexpr RawMessage(std::array<std::uint8_t,8> const& data = {}) noexcept;
+      RawMessage(RawMessage const&) = default;
+      RawMessage& operator = (RawMessage const&) = default;
+      RawMessage(RawMessage&&) = default;
+      RawMessage& operator = (RawMessage&&) = default;
+  };
+
+  constexpr RawMessage::RawMessage(std::array<std::uint8_t,8> const& data) noexcept
+  : Message{data} {
+    return;
+  }
+
   template <typename T, typename std::enable_if_t<std::is_integral_v<T>>*>
   void Message::setAt(T const val, std::size_t const i) {
     if (i + sizeof(T)/sizeof(std::uint8_t) > data_.size()) {
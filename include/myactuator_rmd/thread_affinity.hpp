@@ -0,0 +1,41 @@
+/**
+ * \file thread_affinity.hpp
+ * \mainpage
+ *    Contains functions for pinning threads to a core and raising their priority
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#ifndef MYACTUATOR_RMD__THREAD_AFFINITY
+#define MYACTUATOR_RMD__THREAD_AFFINITY
+#pragma once
+
+#include <cstdint>
+
+
+namespace myactuator_rmd {
+
+  /**\fn setThreadAffinity
+   * \brief
+   *    Pin the calling thread to a single core. Threads busy polling a socket should run on a core that was
+   *    isolated from the scheduler (e.g. with the kernel parameter 'isolcpus') so that they neither get
+   *    preempted nor slow down other threads.
+   *
+   * \param[in] core
+   *    The index of the core the thread should run on
+  */
+  void setThreadAffinity(std::size_t const core);
+
+  /**\fn setThreadPriority
+   * \brief
+   *    Let the calling thread be scheduled with the given real-time priority (SCHED_FIFO) so that it preempts
+   *    regular threads of the application. This requires CAP_SYS_NICE or a sufficient RLIMIT_RTPRIO.
+   *
+   * \param[in] priority
+   *    The real-time priority of the thread [1, 99]
+  */
+  void setThreadPriority(int const priority);
+
+}
+
+#endif // MYACTUATOR_RMD__THREAD_AFFINITY
@@ -0,0 +1,30 @@
+import asyncio
+import myactuator_rmd_py as rmd
+import time
+
+# Polls the telemetry of several motors on several buses from a single asyncio event loop. Every bus has
+# its own asynchronous driver, so the requests of all buses are in flight at the same time.
+
+# Configuration
+motor_ids = {"can0": [1, 2, 3], "can1": [1, 2, 3]}
+num_cycles = 1000
+
+
+async def main():
+    async_drivers = [rmd.AsyncDriver(rmd.CanDriver(interface_name)) for interface_name in motor_ids]
+    actuators = [rmd.AsyncActuatorInterface(async_driver, motor_id)
+                 for async_driver, ids in zip(async_drivers, motor_ids.values()) for motor_id in ids]
+    print(f"Polling {len(actuators)} motors on {list(motor_ids)}")
+
+    start_time = time.perf_counter()
+    for _ in range(num_cycles):
+        statuses = await asyncio.gather(*(actuator.getMotorStatus2() for actuator in actuators))
+    elapsed = time.perf_counter() - start_time
+
+    for (interface_name, motor_id), status in zip(((i, m) for i in motor_ids for m in motor_ids[i]), statuses):
+        print(f"{interface_name}/{motor_id}: {status.shaft_angle:.2f} deg, {status.temperature} C")
+    print(f"{num_cycles*len(actuators)/elapsed:.0f} requests/s")
+
+
+if __name__ == "__main__":
+    asyncio.run(main())
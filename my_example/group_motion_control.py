@@ -0,0 +1,49 @@
+import myactuator_rmd_py as rmd
+import numpy as np
+import time
+
+# Commands several motors with a single call: the NumPy arrays hold one element per motor in the
+# order of the motor ids and are passed to C++ without copying.
+
+# Configuration
+interface_name = "can2"
+motor_ids = [1, 2, 3]
+
+# Sine Wave Settings
+amplitude = np.deg2rad(45.0)
+frequency_hz = 1.0
+phase = np.linspace(0.0, np.pi, len(motor_ids), dtype=np.float32)
+
+
+try:
+    driver = rmd.CanDriver(interface_name)
+    group = rmd.ActuatorGroup(driver, motor_ids)
+    print(f"Connected to Motors {motor_ids} on {interface_name}")
+
+    n = len(group)
+    kp = np.full(n, 15.0, dtype=np.float32)
+    kd = np.full(n, 1.0, dtype=np.float32)
+    t_ff = np.zeros(n, dtype=np.float32)
+
+    # Pre-allocated output buffers that are filled in place
+    position = np.zeros(n, dtype=np.float32)
+    velocity = np.zeros(n, dtype=np.float32)
+    torque = np.zeros(n, dtype=np.float32)
+
+    omega = 2 * np.pi * frequency_hz
+    start_time = time.time()
+    while True:
+        t_now = time.time() - start_time
+        p_des = (amplitude * np.sin(omega * t_now + phase)).astype(np.float32)
+        v_des = (amplitude * omega * np.cos(omega * t_now + phase)).astype(np.float32)
+
+        group.motionControl(p_des, v_des, kp, kd, t_ff, position, velocity, torque)
+        print(f"Actual: {np.rad2deg(position)} deg | Torque: {torque} Nm")
+
+        # Rate Limiting (1kHz)
+        time.sleep(0.001)
+
+except KeyboardInterrupt:
+    print("\n[!] Ctrl+C Detected. Stopping Motors...")
+    for motor_id in motor_ids:
+        rmd.ActuatorInterface(driver, motor_id).shutdownMotor()
@@ -0,0 +1,44 @@
+import myactuator_rmd_py as rmd
+import argparse
+import threading
+import time
+
+# Measures the telemetry throughput with one Python thread per motor. The bindings release the GIL
+# during the blocking CAN I/O, so the throughput should scale with the number of threads.
+# Each thread uses its own driver: Drivers are not thread-safe but every driver has its own socket
+# and receive filter, so several drivers on the same interface do not interfere with each other.
+
+parser = argparse.ArgumentParser(description="Multi-threaded telemetry benchmark")
+parser.add_argument("--interface", default="can0", help="CAN interface name")
+parser.add_argument("--ids", type=int, nargs="+", default=[1, 2, 3, 4], help="Motor ids, one thread per motor")
+parser.add_argument("--duration", type=float, default=5.0, help="Duration per run in seconds")
+args = parser.parse_args()
+
+
+def poll(interface_name, motor_id, duration, counts, index):
+    driver = rmd.CanDriver(interface_name)
+    actuator = rmd.ActuatorInterface(driver, motor_id)
+    count = 0
+    t_end = time.perf_counter() + duration
+    while time.perf_counter() < t_end:
+        actuator.getMotorStatus2()
+        count += 1
+    counts[index] = count
+
+
+baseline = None
+for n_threads in range(1, len(args.ids) + 1):
+    counts = [0] * n_threads
+    threads = [
+        threading.Thread(target=poll, args=(args.interface, args.ids[i], args.duration, counts, i))
+        for i in range(n_threads)
+    ]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+
+    throughput = sum(counts) / args.duration
+    if baseline is None:
+        baseline = throughput
+    print(f"Threads: {n_threads} | Throughput: {throughput:8.1f} requests/s | Speed-up: {throughput / baseline:4.2f}")
@@ -0,0 +1,49 @@
+import myactuator_rmd_py as rmd
+import numpy as np
+import datetime
+import time
+
+# Uploads a sampled sine wave once and lets a C++ thread send it to the motors at a fixed rate,
+# Python only polls the progress and the recorded feedback.
+
+# Configuration
+interface_name = "can2"
+motor_ids = [1]
+
+# Sine Wave Settings
+amplitude_deg = 45.0
+frequency_hz = 1.0
+duration = 5.0
+rate_hz = 500.0
+
+try:
+    driver = rmd.CanDriver(interface_name)
+    group = rmd.ActuatorGroup(driver, motor_ids)
+    print(f"Connected to Motors {motor_ids} on {interface_name}")
+
+    # Samples of shape (samples, motors) at the rate of the streamer
+    t = np.arange(0.0, duration, 1.0 / rate_hz)
+    position = amplitude_deg * np.sin(2 * np.pi * frequency_hz * t)
+    position = np.repeat(position[:, np.newaxis], len(motor_ids), axis=1)
+
+    streamer = rmd.TrajectoryStreamer(group, datetime.timedelta(seconds=1.0 / rate_hz), rmd.StreamMode.POSITION_SETPOINT)
+    streamer.setTrajectory(position, max_speed=np.full(len(motor_ids), 1000.0))
+    streamer.start()
+
+    while streamer.isRunning() and streamer.getProgress() < streamer.getNumSamples():
+        print(f"Progress: {streamer.getProgress()}/{streamer.getNumSamples()} | Overruns: {streamer.getOverruns()}")
+        time.sleep(0.5)
+    streamer.stop()
+    if streamer.getError():
+        print(f"Error: {streamer.getError()}")
+
+    actual, _, _ = streamer.getFeedback()
+    print(f"Maximum tracking error: {np.max(np.abs(actual - position[:len(actual)])):6.2f} deg")
+
+except KeyboardInterrupt:
+    print("\n[!] Ctrl+C Detected.")
+    streamer.stop()
+
+finally:
+    for motor_id in motor_ids:
+        rmd.ActuatorInterface(driver, motor_id).shutdownMotor()
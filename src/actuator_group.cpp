@@ -0,0 +1,197 @@
+#include "myactuator_rmd/actuator_group.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "myactuator_rmd/actuator_state/feedback.hpp"
+#include "myactuator_rmd/actuator_state/motion_control_status.hpp"
+#include "myactuator_rmd/control/safety_limits.hpp"
+#include "myactuator_rmd/driver/can_address_offset.hpp"
+#include "myactuator_rmd/driver/driver.hpp"
+#include "myactuator_rmd/driver/transfer.hpp"
+#include "myactuator_rmd/protocol/motion_control_request.hpp"
+#include "myactuator_rmd/protocol/motion_control_response.hpp"
+#include "myactuator_rmd/protocol/requests.hpp"
+#include "myactuator_rmd/protocol/responses.hpp"
+#include "myactuator_rmd/exceptions.hpp"
+
+
+namespace myactuator_rmd {
+
+  ActuatorGroup::ActuatorGroup(Driver& driver, std::vector<std::uint32_t> const& actuator_ids)
+  : driver_{driver}, actuator_ids_{actuator_ids}, transfers_{}, halt_transfers_{}, limits_{nullptr},
+    limited_position_(actuator_ids.size()), limited_velocity_(actuator_ids.size()), limited_torque_(actuator_ids.size()),
+    temperature_(actuator_ids.size()) {
+    transfers_.reserve(actuator_ids_.size());
+    for (auto const& id: actuator_ids_) {
+      driver_.addId(id);
+      transfers_.emplace_back(id);
+    }
+    halt_transfers_ = transfers_;
+    return;
+  }
+
+  std::vector<std::uint32_t> const& ActuatorGroup::getActuatorIds() const noexcept {
+    return actuator_ids_;
+  }
+
+  std::size_t ActuatorGroup::size() const noexcept {
+    return actuator_ids_.size();
+  }
+
+  void ActuatorGroup::setTimeout(std::chrono::microseconds const& timeout) noexcept {
+    for (auto& transfer: transfers_) {
+      transfer.timeout = timeout;
+    }
+    for (auto& transfer: halt_transfers_) {
+      transfer.timeout = timeout;
+    }
+    return;
+  }
+
+  void ActuatorGroup::setSafetyLimits(SafetyLimits* const limits) {
+    if ((limits != nullptr) && ((limits->getNumActuators() != size()) || (limits->min_position.size() != size()) ||
+        (limits->max_position.size() != size()) || (limits->max_velocity.size() != size()) ||
+        (limits->max_torque.size() != size()) || (limits->max_current.size() != size()) ||
+        (limits->derating_temperature.size() != size()) || (limits->max_temperature.size() != size()))) {
+      throw ValueRangeException("Safety limits do not match the actuator group (" + std::to_string(size()) + " actuators)!");
+    }
+    limits_ = limits;
+    return;
+  }
+
+  SafetyAction ActuatorGroup::motionControl(float const* p_des, float const* v_des, float const* kp, float const* kd,
+                                            float const* t_ff, float* position, float* velocity, float* torque) {
+    constexpr float deg_to_rad {0.0174532925f};
+    if (limits_ != nullptr) {
+      std::copy(p_des, p_des + size(), limited_position_.begin());
+      std::copy(v_des, v_des + size(), limited_velocity_.begin());
+      std::copy(t_ff, t_ff + size(), limited_torque_.begin());
+      auto const action {limits_->limitMotionControl(limited_position_.data(), limited_velocity_.data(), limited_torque_.data())};
+      if (action != SafetyAction::CLAMP) {
+        halt(action);
+        readStatus();
+        for (std::size_t i = 0; i < halt_transfers_.size(); ++i) {
+          Feedback const feedback {GetMotorStatus2Response{halt_transfers_[i].response}.getStatus()};
+          position[i] = feedback.shaft_angle*deg_to_rad;
+          velocity[i] = feedback.shaft_speed*deg_to_rad;
+          // The status only holds the current and the torque constant of the actuators is unknown
+          torque[i] = std::numeric_limits<float>::quiet_NaN();
+        }
+        return action;
+      }
+      p_des = limited_position_.data();
+      v_des = limited_velocity_.data();
+      t_ff = limited_torque_.data();
+    }
+    for (std::size_t i = 0; i < transfers_.size(); ++i) {
+      MotionControlRequest const request {p_des[i], v_des[i], kp[i], kd[i], t_ff[i]};
+      transfers_[i].request = request.getData();
+      transfers_[i].request_offset = CanAddressOffset::request_motion_control;
+      transfers_[i].response_offset = CanAddressOffset::response_motion_control;
+    }
+    driver_.sendRecv(transfers_);
+    for (std::size_t i = 0; i < transfers_.size(); ++i) {
+      MotionControlResponse const response {transfers_[i].response};
+      position[i] = response.getPosition();
+      velocity[i] = response.getVelocity();
+      torque[i] = response.getTorque();
+    }
+    if (limits_ != nullptr) {
+      auto const action {limits_->checkMotionControlFeedback(position, velocity, torque)};
+      if (action != SafetyAction::CLAMP) {
+        halt(action);
+      }
+      return action;
+    }
+    return SafetyAction::CLAMP;
+  }
+
+  SafetyAction ActuatorGroup::sendPositionAbsoluteSetpoint(float const* position, float const* max_speed,
+                                                           float* shaft_angle, float* shaft_speed, float* current) {
+    if (limits_ != nullptr) {
+      std::copy(position, position + size(), limited_position_.begin());
+      std::copy(max_speed, max_speed + size(), limited_velocity_.begin());
+      auto const action {limits_->limitPositionSetpoint(limited_position_.data(), limited_velocity_.data())};
+      if (action != SafetyAction::CLAMP) {
+        halt(action);
+        readStatus();
+        for (std::size_t i = 0; i < halt_transfers_.size(); ++i) {
+          Feedback const feedback {GetMotorStatus2Response{halt_transfers_[i].response}.getStatus()};
+          shaft_angle[i] = feedback.shaft_angle;
+          shaft_speed[i] = feedback.shaft_speed;
+          current[i] = feedback.current;
+          temperature_[i] = static_cast<float>(feedback.temperature);
+        }
+        return action;
+      }
+      position = limited_position_.data();
+      max_speed = limited_velocity_.data();
+    }
+    for (std::size_t i = 0; i < transfers_.size(); ++i) {
+      SetPositionAbsoluteRequest const request {position[i], max_speed[i]};
+      transfers_[i].request = request.getData();
+      transfers_[i].request_offset = CanAddressOffset::request;
+      transfers_[i].response_offset = CanAddressOffset::response;
+    }
+    driver_.sendRecv(transfers_);
+    for (std::size_t i = 0; i < transfers_.size(); ++i) {
+      SetPositionAbsoluteResponse const response {transfers_[i].response};
+      Feedback const feedback {response.getStatus()};
+      shaft_angle[i] = feedback.shaft_angle;
+      shaft_speed[i] = feedback.shaft_speed;
+      current[i] = feedback.current;
+      temperature_[i] = static_cast<float>(feedback.temperature);
+    }
+    if (limits_ != nullptr) {
+      auto const action {limits_->checkFeedback(shaft_angle, shaft_speed, current, temperature_.data())};
+      if (action != SafetyAction::CLAMP) {
+        halt(action);
+      }
+      return action;
+    }
+    return SafetyAction::CLAMP;
+  }
+
+  void ActuatorGroup::halt(SafetyAction const action) {
+    auto const request {(action == SafetyAction::SHUTDOWN) ? ShutdownMotorRequest{}.getData() : StopMotorRequest{}.getData()};
+    for (auto& transfer: halt_transfers_) {
+      transfer.request = request;
+    }
+    driver_.sendRecv(halt_transfers_);
+    return;
+  }
+
+  void ActuatorGroup::readStatus() {
+    auto const request {GetMotorStatus2Request{}.getData()};
+    for (auto& transfer: halt_transfers_) {
+      transfer.request = request;
+    }
+    driver_.sendRecv(halt_transfers_);
+    return;
+  }
+
+  std::vector<MotionControlStatus> ActuatorGroup::motionControl(std::vector<float> const& p_des, std::vector<float> const& v_des,
+                                                                std::vector<float> const& kp, std::vector<float> const& kd,
+                                                                std::vector<float> const& t_ff) {
+    auto const n {size()};
+    if ((p_des.size() != n) || (v_des.size() != n) || (kp.size() != n) || (kd.size() != n) || (t_ff.size() != n)) {
+      throw ValueRangeException("Expected one command per actuator (" + std::to_string(n) + ")!");
+    }
+    std::vector<float> position(n), velocity(n), torque(n);
+    static_cast<void>(motionControl(p_des.data(), v_des.data(), kp.data(), kd.data(), t_ff.data(),
+                                    position.data(), velocity.data(), torque.data()));
+    // Replies are only accepted from the addressed actuator, so its id also holds for the status read after a halt
+    std::vector<MotionControlStatus> status {};
+    status.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      status.emplace_back(actuator_ids_[i], position[i], velocity[i], torque[i]);
+    }
+    return status;
+  }
+
+}
@@ -2,7 +2,9 @@
 
 #include <chrono>
 #include <cstdint>
+#include <map>
 #include <string>
+#include <vector>
 
 #include "myactuator_rmd/actuator_state/can_baud_rate.hpp"
 #include "myactuator_rmd/actuator_state/control_mode.hpp"
@@ -11,7 +13,9 @@
 #include "myactuator_rmd/actuator_state/motor_status_1.hpp"
 #include "myactuator_rmd/actuator_state/motor_status_2.hpp"
 #include "myactuator_rmd/actuator_state/motor_status_3.hpp"
+#include "myactuator_rmd/control/compensation.hpp"
 #include "myactuator_rmd/driver/driver.hpp"
+#include "myactuator_rmd/driver/transfer.hpp"
 #include "myactuator_rmd/protocol/requests.hpp"
 #include "myactuator_rmd/protocol/responses.hpp"
 #include "myactuator_rmd/exceptions.hpp"
@@ -27,7 +31,8 @@
 namespace myactuator_rmd {
 
   ActuatorInterface::ActuatorInterface(Driver& driver, std::uint32_t const actuator_id)
-  : driver_{driver}, actuator_id_{actuator_id} {
+  : driver_{driver}, actuator_id_{actuator_id}, compensation_{nullptr}, compensation_transfers_{}, encoder_position_{},
+    feedback_{} {
     driver.addId(actuator_id); // Make the actuator listen to the responses
     return;
   }
@@ -63,6 +68,45 @@ namespace myactuator_rmd {
       return response.getValue();
   }
 
+  std::map<GainType,float> ActuatorInterface::getAllGains() {
+    std::vector<Transfer> transfers {};
+    transfers.reserve(gain_types.size());
+    for (auto const& gain_type: gain_types) {
+      transfers.emplace_back(actuator_id_, GetSingleControllerGainRequest{gain_type}.getData());
+    }
+    driver_.sendRecv(transfers);
+    std::map<GainType,float> gains {};
+    for (auto const& transfer: transfers) {
+      GetSingleControllerGainResponse const response {transfer.response};
+      gains[response.getGainType()] = response.getValue();
+    }
+    return gains;
+  }
+
+  std::map<GainType,float> ActuatorInterface::setAllGains(std::map<GainType,float> const& gains, bool const is_persistent) {
+    std::vector<Transfer> transfers {};
+    transfers.reserve(gains.size());
+    for (auto const& [gain_type, value]: gains) {
+      if (is_persistent) {
+        transfers.emplace_back(actuator_id_, SetSingleControllerGainPersistentlyRequest{gain_type, value}.getData());
+      } else {
+        transfers.emplace_back(actuator_id_, SetSingleControllerGainRequest{gain_type, value}.getData());
+      }
+    }
+    driver_.sendRecv(transfers);
+    std::map<GainType,float> echoed_gains {};
+    for (auto const& transfer: transfers) {
+      if (is_persistent) {
+        SetSingleControllerGainPersistentlyResponse const response {transfer.response};
+        echoed_gains[response.getGainType()] = response.getValue();
+      } else {
+        SetSingleControllerGainResponse const response {transfer.response};
+        echoed_gains[response.getGainType()] = response.getValue();
+      }
+    }
+    return echoed_gains;
+  }
+
   std::uint32_t ActuatorInterface::functionControl(FunctionControlType const function_type, std::uint32_t const value) {
     SetFunctionControlRequest const request {function_type, value};
 
@@ -211,8 +255,20 @@ namespace myactuator_rmd {
   }
 
   Feedback ActuatorInterface::sendTorqueSetpoint(float const torque, float const torque_constant) {
-    auto const current {torque/torque_constant};
-    return sendCurrentSetpoint(current);
+    if (compensation_ == nullptr) {
+      auto const current {torque/torque_constant};
+      return sendCurrentSetpoint(current);
+    }
+    // The encoder position is only known from the previous command as reading it takes a request of its own
+    auto const compensated_torque {torque + compensation_->getTorque(encoder_position_, feedback_.shaft_speed)};
+    auto const current {compensated_torque/torque_constant};
+    compensation_transfers_[0].request = SetTorqueRequest{current}.getData();
+    driver_.sendRecv(compensation_transfers_);
+    SetTorqueResponse const torque_response {compensation_transfers_[0].response};
+    GetSingleTurnEncoderPositionResponse const encoder_response {compensation_transfers_[1].response};
+    encoder_position_ = static_cast<float>(static_cast<std::uint16_t>(encoder_response.getPosition()));
+    feedback_ = torque_response.getStatus();
+    return feedback_;
   }
 
   Feedback ActuatorInterface::sendVelocitySetpoint(float const speed) {
@@ -233,6 +289,15 @@ namespace myactuator_rmd {
     return;
   }
 
+  void ActuatorInterface::setCompensation(Compensation const* const compensation) {
+    compensation_ = compensation;
+    compensation_transfers_ = {Transfer{actuator_id_, SetTorqueRequest{0.0f}.getData()},
+                               Transfer{actuator_id_, GetSingleTurnEncoderPositionRequest{}.getData()}};
+    encoder_position_ = 0.0f;
+    feedback_ = Feedback{};
+    return;
+  }
+
   std::int32_t ActuatorInterface::setCurrentPositionAsEncoderZero() {
     SetCurrentPositionAsEncoderZeroRequest const request {};
     SetCurrentPositionAsEncoderZeroResponse const response {driver_.sendRecv(request, actuator_id_)};
@@ -0,0 +1,202 @@
+#include "myactuator_rmd/async_actuator_interface.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <string>
+
+#include "myactuator_rmd/actuator_state/control_mode.hpp"
+#include "myactuator_rmd/actuator_state/feedback.hpp"
+#include "myactuator_rmd/actuator_state/gain_type.hpp"
+#include "myactuator_rmd/actuator_state/gains.hpp"
+#include "myactuator_rmd/actuator_state/motion_control_status.hpp"
+#include "myactuator_rmd/actuator_state/motor_status_1.hpp"
+#include "myactuator_rmd/actuator_state/motor_status_2.hpp"
+#include "myactuator_rmd/actuator_state/motor_status_3.hpp"
+#include "myactuator_rmd/driver/async_driver.hpp"
+#include "myactuator_rmd/driver/can_address_offset.hpp"
+#include "myactuator_rmd/driver/transfer.hpp"
+#include "myactuator_rmd/protocol/message.hpp"
+#include "myactuator_rmd/protocol/motion_control_request.hpp"
+#include "myactuator_rmd/protocol/motion_control_response.hpp"
+#include "myactuator_rmd/protocol/requests.hpp"
+#include "myactuator_rmd/protocol/responses.hpp"
+#include "myactuator_rmd/protocol/single_gain_request.hpp"
+#include "myactuator_rmd/protocol/single_gain_response.hpp"
+
+
+namespace myactuator_rmd {
+
+  template <typename T, typename F>
+  void AsyncActuatorInterface::submit(Message const& request, F const& decode, Completion<T> const& completion,
+                                      std::uint32_t const request_offset, std::uint32_t const response_offset) {
+    Transfer const transfer {actuator_id_, request.getData(), request_offset, response_offset};
+    driver_.submit(transfer, [decode, completion](Transfer const& t, std::exception_ptr error) {
+      T result {};
+      if (!error) {
+        try {
+          result = decode(t.response);
+        } catch (...) {
+          error = std::current_exception();
+        }
+      }
+      completion(error ? T{} : result, error);
+      return;
+    });
+    return;
+  }
+
+  AsyncActuatorInterface::AsyncActuatorInterface(AsyncDriver& driver, std::uint32_t const actuator_id)
+  : driver_{driver}, actuator_id_{actuator_id} {
+    driver.addId(actuator_id);
+    return;
+  }
+
+  void AsyncActuatorInterface::getAcceleration(Completion<std::int32_t> const& completion) {
+    submit(GetAccelerationRequest{}, [](std::array<std::uint8_t,8> const& data) {
+      return GetAccelerationResponse{data}.getAcceleration();
+    }, completion);
+    return;
+  }
+
+  void AsyncActuatorInterface::getControllerGains(Completion<Gains> const& completion) {
+    submit(GetControllerGainsRequest{}, [](std::array<std::uint8_t,8> const& data) {
+      return GetControllerGainsResponse{data}.getGains();
+    }, completion);
+    return;
+  }
+
+  void AsyncActuatorInterface::getControlMode(Completion<ControlMode> const& completion) {
+    submit(GetControlModeRequest{}, [](std::array<std::uint8_t,8> const& data) {
+      return GetControlModeResponse{data}.getMode();
+    }, completion);
+    return;
+  }
+
+  void AsyncActuatorInterface::getMotorModel(Completion<std::string> const& completion) {
+    submit(GetMotorModelRequest{}, [](std::array<std::uint8_t,8> const& data) {
+      return GetMotorModelResponse{data}.getModel();
+    }, completion);
+    return;
+  }
+
+  void AsyncActuatorInterface::getMotorPower(Completion<float> const& completion) {
+    submit(GetMotorPowerRequest{}, [](std::array<std::uint8_t,8> const& data) {
+      return GetMotorPowerResponse{data}.getPower();
+    }, completion);
+    return;
+  }
+
+  void AsyncActuatorInterface::getMotorStatus1(Completion<MotorStatus1> const& completion) {
+    submit(GetMotorStatus1Request{}, [](std::array<std::uint8_t,8> const& data) {
+      return GetMotorStatus1Response{data}.getStatus();
+    }, completion);
+    return;
+  }
+
+  void AsyncActuatorInterface::getMotorStatus2(Completion<MotorStatus2> const& completion) {
+    submit(GetMotorStatus2Request{}, [](std::array<std::uint8_t,8> const& data) {
+      return GetMotorStatus2Response{data}.getStatus();
+    }, completion);
+    return;
+  }
+
+  void AsyncActuatorInterface::getMotorStatus3(Completion<MotorStatus3> const& completion) {
+    submit(GetMotorStatus3Request{}, [](std::array<std::uint8_t,8> const& data) {
+      return GetMotorStatus3Response{data}.getStatus();
+    }, completion);
+    return;
+  }
+
+  void AsyncActuatorInterface::getMultiTurnAngle(Completion<float> const& completion) {
+    submit(GetMultiTurnAngleRequest{}, [](std::array<std::uint8_t,8> const& data) {
+      return GetMultiTurnAngleResponse{data}.getAngle();
+    }, completion);
+    return;
+  }
+
+  void AsyncActuatorInterface::getRuntime(Completion<std::chrono::milliseconds> const& completion) {
+    submit(GetSystemRuntimeRequest{}, [](std::array<std::uint8_t,8> const& data) {
+      return GetSystemRuntimeResponse{data}.getRuntime();
+    }, completion);
+    return;
+  }
+
+  void AsyncActuatorInterface::getSingleGain(GainType const gain_type, Completion<float> const& completion) {
+    submit(GetSingleControllerGainRequest{gain_type}, [](std::array<std::uint8_t,8> const& data) {
+      return GetSingleControllerGainResponse{data}.getValue();
+    }, completion);
+    return;
+  }
+
+  void AsyncActuatorInterface::getSingleTurnAngle(Completion<float> const& completion) {
+    submit(GetSingleTurnAngleRequest{}, [](std::array<std::uint8_t,8> const& data) {
+      return GetSingleTurnAngleResponse{data}.getAngle();
+    }, completion);
+    return;
+  }
+
+  void AsyncActuatorInterface::getVersionDate(Completion<std::uint32_t> const& completion) {
+    submit(GetVersionDateRequest{}, [](std::array<std::uint8_t,8> const& data) {
+      return GetVersionDateResponse{data}.getVersion();
+    }, completion);
+    return;
+  }
+
+  void AsyncActuatorInterface::motionControl(float const p_des, float const v_des, float const kp, float const kd,
+                                             float const t_ff, Completion<MotionControlStatus> const& completion) {
+    submit(MotionControlRequest{p_des, v_des, kp, kd, t_ff}, [](std::array<std::uint8_t,8> const& data) {
+      MotionControlResponse const response {data};
+      return MotionControlStatus{response.getEchoCanId(), response.getPosition(), response.getVelocity(), response.getTorque()};
+    }, completion, CanAddressOffset::request_motion_control, CanAddressOffset::response_motion_control);
+    return;
+  }
+
+  void AsyncActuatorInterface::sendCurrentSetpoint(float const current, Completion<Feedback> const& completion) {
+    submit(SetTorqueRequest{current}, [](std::array<std::uint8_t,8> const& data) {
+      return SetTorqueResponse{data}.getStatus();
+    }, completion);
+    return;
+  }
+
+  void AsyncActuatorInterface::sendPositionAbsoluteSetpoint(float const position, float const max_speed,
+                                                            Completion<Feedback> const& completion) {
+    submit(SetPositionAbsoluteRequest{position, max_speed}, [](std::array<std::uint8_t,8> const& data) {
+      return SetPositionAbsoluteResponse{data}.getStatus();
+    }, completion);
+    return;
+  }
+
+  void AsyncActuatorInterface::sendVelocitySetpoint(float const speed, Completion<Feedback> const& completion) {
+    submit(SetVelocityRequest{speed}, [](std::array<std::uint8_t,8> const& data) {
+      return SetVelocityResponse{data}.getStatus();
+    }, completion);
+    return;
+  }
+
+  void AsyncActuatorInterface::shutdownMotor(StatusCompletion const& completion) {
+    Completion<bool> const acknowledge {[completion](bool const /*result*/, std::exception_ptr error) {
+      completion(error);
+      return;
+    }};
+    submit(ShutdownMotorRequest{}, [](std::array<std::uint8_t,8> const& data) {
+      [[maybe_unused]] ShutdownMotorResponse const response {data};
+      return true;
+    }, acknowledge);
+    return;
+  }
+
+  void AsyncActuatorInterface::stopMotor(StatusCompletion const& completion) {
+    Completion<bool> const acknowledge {[completion](bool const /*result*/, std::exception_ptr error) {
+      completion(error);
+      return;
+    }};
+    submit(StopMotorRequest{}, [](std::array<std::uint8_t,8> const& data) {
+      [[maybe_unused]] StopMotorResponse const response {data};
+      return true;
+    }, acknowledge);
+    return;
+  }
+
+}
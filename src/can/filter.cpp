@@ -0,0 +1,104 @@
+#include "myactuator_rmd/can/filter.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <set>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include <linux/can.h>
+
+#include "myactuator_rmd/can/exceptions.hpp"
+
+
+namespace myactuator_rmd {
+  namespace can {
+
+    std::vector<Filter> computeFilters(std::vector<std::uint32_t> const& can_ids) {
+      // A cube is given by the value of its fixed bits and the bits that are irrelevant
+      using Cube = std::pair<std::uint32_t,std::uint32_t>;
+      auto const covers = [](Cube const& cube, std::uint32_t const can_id) noexcept -> bool {
+        return (can_id & ~cube.second) == cube.first;
+      };
+
+      std::set<std::uint32_t> const minterms {can_ids.begin(), can_ids.end()};
+      for (auto const& can_id: minterms) {
+        if (can_id > CAN_SFF_MASK) {
+          std::ostringstream ss {};
+          ss << std::showbase << std::hex << can_id;
+          throw Exception("CAN id '" + ss.str() + "' is not a standard 11-bit id");
+        }
+      }
+
+      // Merge cubes differing in a single bit until no further merge is possible, the remaining ones are prime
+      std::set<Cube> primes {};
+      std::set<Cube> cubes {};
+      for (auto const& can_id: minterms) {
+        cubes.emplace(can_id, 0);
+      }
+      while (!cubes.empty()) {
+        std::set<Cube> merged_cubes {};
+        std::set<Cube> merged {};
+        for (auto a = cubes.begin(); a != cubes.end(); ++a) {
+          for (auto b = std::next(a); b != cubes.end(); ++b) {
+            auto const difference {a->first ^ b->first};
+            if ((a->second == b->second) && (difference != 0) && ((difference & (difference - 1)) == 0)) {
+              merged_cubes.emplace(a->first & ~difference, a->second | difference);
+              merged.insert(*a);
+              merged.insert(*b);
+            }
+          }
+        }
+        for (auto const& cube: cubes) {
+          if (merged.count(cube) == 0) {
+            primes.insert(cube);
+          }
+        }
+        cubes.swap(merged_cubes);
+      }
+
+      // Select the essential prime cubes first and then greedily the ones covering most of the remaining ids
+      std::vector<Cube> selected {};
+      std::set<std::uint32_t> uncovered {minterms};
+      auto const select = [&selected, &uncovered, &covers](Cube const& cube) {
+        selected.push_back(cube);
+        for (auto it = uncovered.begin(); it != uncovered.end(); ) {
+          it = covers(cube, *it) ? uncovered.erase(it) : std::next(it);
+        }
+        return;
+      };
+      for (auto const& can_id: minterms) {
+        if (uncovered.count(can_id) == 0) {
+          continue;
+        }
+        auto const is_covering = [&covers, can_id](Cube const& cube) { return covers(cube, can_id); };
+        if (std::count_if(primes.begin(), primes.end(), is_covering) == 1) {
+          select(*std::find_if(primes.begin(), primes.end(), is_covering));
+        }
+      }
+      while (!uncovered.empty()) {
+        auto const num_covered = [&uncovered, &covers](Cube const& cube) {
+          return std::count_if(uncovered.begin(), uncovered.end(), [&covers, &cube](std::uint32_t const can_id) {
+            return covers(cube, can_id);
+          });
+        };
+        select(*std::max_element(primes.begin(), primes.end(), [&num_covered](Cube const& a, Cube const& b) {
+          return num_covered(a) < num_covered(b);
+        }));
+      }
+
+      std::vector<Filter> filters {};
+      for (auto const& cube: selected) {
+        // Comparing the flags as well rejects extended and remote frames
+        filters.emplace_back(cube.first, (~cube.second & CAN_SFF_MASK) | CAN_EFF_FLAG | CAN_RTR_FLAG);
+      }
+      std::sort(filters.begin(), filters.end(), [](Filter const& a, Filter const& b) {
+        return a.getId() < b.getId();
+      });
+      return filters;
+    }
+
+  }
+}
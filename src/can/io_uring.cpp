@@ -0,0 +1,370 @@
+#include "myactuator_rmd/can/io_uring.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <linux/can.h>
+#include <linux/io_uring.h>
+#include <linux/time_types.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "myactuator_rmd/can/exceptions.hpp"
+
+
+namespace myactuator_rmd {
+  namespace can {
+
+    namespace {
+      // The kind of request is encoded in the upper bits of the user data, the buffer index in the lower ones
+      constexpr std::uint64_t receive_tag {1ULL << 32};
+      constexpr std::uint64_t provide_tag {2ULL << 32};
+      constexpr std::uint64_t write_tag {3ULL << 32};
+      constexpr std::uint64_t tag_mask {0xFFFFFFFF00000000ULL};
+      constexpr std::uint16_t buffer_group {0};
+
+      template <typename T>
+      T* offset(void* base, std::uint32_t const off) noexcept {
+        return reinterpret_cast<T*>(static_cast<char*>(base) + off);
+      }
+    }
+
+    IoUring::IoUring(int const socket, std::uint16_t const num_buffers)
+    : socket_{socket}, ring_{-1}, ring_memory_{MAP_FAILED}, ring_memory_size_{0}, sqes_{static_cast<struct ::io_uring_sqe*>(MAP_FAILED)},
+      sqes_size_{0}, sq_head_{nullptr}, sq_tail_{nullptr}, sq_mask_{0}, sq_entries_{0}, sq_array_{nullptr}, cq_head_{nullptr},
+      cq_tail_{nullptr}, cq_mask_{0}, cqes_{nullptr}, num_queued_{0}, receive_buffers_(num_buffers), received_{}, num_provided_{0},
+      write_buffers_(num_buffers), free_write_buffers_{}, pending_write_buffers_{}, posted_write_buffers_{},
+      is_write_rejected_(num_buffers), num_posted_writes_{0}, retry_time_{}, is_receive_posted_{false}, is_multishot_{true},
+      error_{0}, num_written_frames_{0}, num_rejected_writes_{0}, num_syscalls_{0} {
+      if (num_buffers == 0) {
+        throw Exception("io_uring requires at least a single buffer");
+      }
+      // Every buffer can be written and handed back within a single submission, the completion queue is
+      // sized generously by the kernel and does not drop completions on overflow
+      struct ::io_uring_params params {};
+      ring_ = static_cast<int>(::syscall(__NR_io_uring_setup, 2U*num_buffers + 2U, &params));
+      if (ring_ < 0) {
+        throw SocketException(errno, std::generic_category(), "Could not set up io_uring");
+      }
+      auto const required_features {IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP | IORING_FEAT_EXT_ARG};
+      if ((params.features & required_features) != required_features) {
+        release();
+        throw SocketException(ENOTSUP, std::generic_category(), "Kernel lacks required io_uring features");
+      }
+      ring_memory_size_ = std::max(params.sq_off.array + params.sq_entries*sizeof(unsigned),
+                                   params.cq_off.cqes + params.cq_entries*sizeof(struct ::io_uring_cqe));
+      ring_memory_ = ::mmap(nullptr, ring_memory_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_, IORING_OFF_SQ_RING);
+      if (ring_memory_ == MAP_FAILED) {
+        int const error {errno};
+        release();
+        throw SocketException(error, std::generic_category(), "Could not map io_uring");
+      }
+      sqes_size_ = params.sq_entries*sizeof(struct ::io_uring_sqe);
+      sqes_ = static_cast<struct ::io_uring_sqe*>(::mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                                         ring_, IORING_OFF_SQES));
+      if (sqes_ == MAP_FAILED) {
+        int const error {errno};
+        release();
+        throw SocketException(error, std::generic_category(), "Could not map io_uring submission entries");
+      }
+      sq_head_ = offset<unsigned>(ring_memory_, params.sq_off.head);
+      sq_tail_ = offset<unsigned>(ring_memory_, params.sq_off.tail);
+      sq_mask_ = *offset<unsigned>(ring_memory_, params.sq_off.ring_mask);
+      sq_entries_ = params.sq_entries;
+      sq_array_ = offset<unsigned>(ring_memory_, params.sq_off.array);
+      cq_head_ = offset<unsigned>(ring_memory_, params.cq_off.head);
+      cq_tail_ = offset<unsigned>(ring_memory_, params.cq_off.tail);
+      cq_mask_ = *offset<unsigned>(ring_memory_, params.cq_off.ring_mask);
+      cqes_ = offset<struct ::io_uring_cqe>(ring_memory_, params.cq_off.cqes);
+
+      free_write_buffers_.reserve(num_buffers);
+      posted_write_buffers_.reserve(num_buffers);
+      for (std::uint16_t i = 0; i < num_buffers; ++i) {
+        free_write_buffers_.push_back(static_cast<std::uint16_t>(num_buffers - 1 - i));
+      }
+      try {
+        auto* const sqe {getSqe()};
+        sqe->opcode = IORING_OP_PROVIDE_BUFFERS;
+        sqe->fd = num_buffers;
+        sqe->addr = reinterpret_cast<std::uint64_t>(receive_buffers_.data());
+        sqe->len = sizeof(struct ::can_frame);
+        sqe->off = 0;
+        sqe->buf_group = buffer_group;
+        sqe->user_data = provide_tag;
+        num_provided_ = num_buffers;
+        postReceive();
+        enter(1, std::chrono::microseconds(0));
+        reap();
+      } catch (...) {
+        release();
+        throw;
+      }
+      return;
+    }
+
+    IoUring::~IoUring() {
+      release();
+      return;
+    }
+
+    bool IoUring::tryRead(struct ::can_frame& frame) {
+      reap();
+      if (received_.empty()) {
+        return false;
+      }
+      auto const buffer {received_.front()};
+      received_.pop_front();
+      frame = receive_buffers_[buffer];
+      provideBuffer(buffer);
+      return true;
+    }
+
+    bool IoUring::tryWrite(struct ::can_frame const& frame) {
+      reap();
+      if (free_write_buffers_.empty()) {
+        return false;
+      }
+      auto const buffer {free_write_buffers_.back()};
+      free_write_buffers_.pop_back();
+      write_buffers_[buffer] = frame;
+      pending_write_buffers_.push_back(buffer);
+      return true;
+    }
+
+    void IoUring::submit() {
+      postWrites();
+      if (num_queued_ > 0) {
+        enter(0, std::chrono::microseconds(0));
+      }
+      return;
+    }
+
+    void IoUring::wait(std::chrono::microseconds const& timeout) {
+      postWrites();
+      auto wait_timeout {timeout};
+      if (!pending_write_buffers_.empty() && (num_posted_writes_ == 0)) {
+        // Frames held back after a rejection are written again once the retry delay has passed
+        auto const remaining {std::chrono::ceil<std::chrono::microseconds>(retry_time_ - std::chrono::steady_clock::now())};
+        auto const retry_timeout {std::max(remaining, std::chrono::microseconds(1))};
+        wait_timeout = (timeout.count() > 0) ? std::min(timeout, retry_timeout) : retry_timeout;
+      }
+      enter(1, wait_timeout);
+      return;
+    }
+
+    bool IoUring::isReadable() {
+      reap();
+      return !received_.empty();
+    }
+
+    bool IoUring::isWritable() {
+      reap();
+      return !free_write_buffers_.empty();
+    }
+
+    std::uint64_t IoUring::getNumWrittenFrames() const noexcept {
+      return num_written_frames_;
+    }
+
+    std::uint64_t IoUring::getNumRejectedWrites() const noexcept {
+      return num_rejected_writes_;
+    }
+
+    std::uint64_t IoUring::getNumSyscalls() const noexcept {
+      return num_syscalls_;
+    }
+
+    struct ::io_uring_sqe* IoUring::getSqe() {
+      auto const tail {*sq_tail_};
+      if (tail - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) >= sq_entries_) {
+        enter(0, std::chrono::microseconds(0));
+      }
+      auto const index {tail & sq_mask_};
+      auto* const sqe {&sqes_[index]};
+      std::memset(sqe, 0, sizeof(struct ::io_uring_sqe));
+      sq_array_[index] = index;
+      // The kernel only reads the submission queue when entering the ring, so the entry can be filled in
+      // after publishing it
+      __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+      ++num_queued_;
+      return sqe;
+    }
+
+    void IoUring::enter(unsigned const min_complete, std::chrono::microseconds const& timeout) {
+      unsigned flags {(min_complete > 0) ? IORING_ENTER_GETEVENTS : 0U};
+      struct ::__kernel_timespec ts {};
+      struct ::io_uring_getevents_arg arg {};
+      void* argp {nullptr};
+      std::size_t argsz {0};
+      if ((min_complete > 0) && (timeout.count() > 0)) {
+        ts.tv_sec = timeout.count()/1000000;
+        ts.tv_nsec = (timeout.count()%1000000)*1000;
+        arg.sigmask_sz = _NSIG/8;
+        arg.ts = reinterpret_cast<std::uint64_t>(&ts);
+        flags |= IORING_ENTER_EXT_ARG;
+        argp = &arg;
+        argsz = sizeof(arg);
+      }
+      ++num_syscalls_;
+      int const result {static_cast<int>(::syscall(__NR_io_uring_enter, ring_, num_queued_, min_complete, flags, argp, argsz))};
+      if (result >= 0) {
+        num_queued_ -= std::min(static_cast<unsigned>(result), num_queued_);
+      } else if ((errno != ETIME) && (errno != EINTR) && (errno != EAGAIN) && (errno != EBUSY)) {
+        throw SocketException(errno, std::generic_category(), "Could not enter io_uring");
+      }
+      return;
+    }
+
+    void IoUring::reap() {
+      auto head {*cq_head_};
+      auto const tail {__atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)};
+      for (; head != tail; ++head) {
+        auto const& cqe {cqes_[head & cq_mask_]};
+        auto const tag {cqe.user_data & tag_mask};
+        if (tag == receive_tag) {
+          if (cqe.flags & IORING_CQE_F_BUFFER) {
+            auto const buffer {static_cast<std::uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT)};
+            --num_provided_;
+            if (cqe.res == sizeof(struct ::can_frame)) {
+              received_.push_back(buffer);
+            } else {
+              provideBuffer(buffer);
+            }
+          }
+          if (!(cqe.flags & IORING_CQE_F_MORE)) {
+            is_receive_posted_ = false;
+          }
+          if ((cqe.res == -EINVAL) && is_multishot_) {
+            // Kernels before 6.0 do not support multishot receives
+            is_multishot_ = false;
+          } else if ((cqe.res < 0) && (cqe.res != -ENOBUFS) && (error_ == 0)) {
+            error_ = -cqe.res;
+          }
+        } else if (tag == write_tag) {
+          auto const buffer {static_cast<std::uint16_t>(cqe.user_data & ~tag_mask)};
+          --num_posted_writes_;
+          if ((cqe.res == -ENOBUFS) || (cqe.res == -EAGAIN)) {
+            // The queue of the network device is full, the frame keeps its buffer and is written again
+            is_write_rejected_[buffer] = true;
+            retry_time_ = std::chrono::steady_clock::now() + retry_delay;
+            ++num_rejected_writes_;
+            continue;
+          } else if (cqe.res == -ECANCELED) {
+            // Linked behind a rejected frame, written again after it to keep the order
+            is_write_rejected_[buffer] = true;
+            continue;
+          }
+          free_write_buffers_.push_back(buffer);
+          if (cqe.res >= 0) {
+            ++num_written_frames_;
+          } else if (error_ == 0) {
+            error_ = -cqe.res;
+          }
+        } else if ((tag == provide_tag) && (cqe.res < 0) && (error_ == 0)) {
+          error_ = -cqe.res;
+        }
+      }
+      __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+      if ((num_posted_writes_ == 0) && !posted_write_buffers_.empty()) {
+        // The rejected frames of a chain are always its tail, they are queued again ahead of newer frames
+        for (auto it {posted_write_buffers_.rbegin()}; it != posted_write_buffers_.rend(); ++it) {
+          if (is_write_rejected_[*it]) {
+            is_write_rejected_[*it] = false;
+            pending_write_buffers_.push_front(*it);
+          }
+        }
+        posted_write_buffers_.clear();
+      }
+      if (!is_receive_posted_ && (num_provided_ > 0)) {
+        postReceive();
+      }
+      if (error_ != 0) {
+        int const error {error_};
+        error_ = 0;
+        throw SocketException(error, std::generic_category(), "io_uring request failed");
+      }
+      return;
+    }
+
+    void IoUring::postWrites() {
+      reap();
+      // Only a single chain is in flight at a time so that frames of a later chain cannot overtake rejected ones
+      if (pending_write_buffers_.empty() || (num_posted_writes_ > 0) || (std::chrono::steady_clock::now() < retry_time_)) {
+        return;
+      }
+      // The chain has to occupy consecutive entries, a link would otherwise extend to a receive
+      auto const num_free {sq_entries_ - (*sq_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE))};
+      auto const num_writes {std::min<std::size_t>(pending_write_buffers_.size(), num_free)};
+      for (std::size_t i = 0; i < num_writes; ++i) {
+        auto const buffer {pending_write_buffers_.front()};
+        pending_write_buffers_.pop_front();
+        auto* const sqe {getSqe()};
+        sqe->opcode = IORING_OP_SEND;
+        sqe->fd = socket_;
+        sqe->addr = reinterpret_cast<std::uint64_t>(&write_buffers_[buffer]);
+        sqe->len = sizeof(struct ::can_frame);
+        // A rejected frame cancels all frames linked behind it
+        sqe->flags = (i + 1 < num_writes) ? IOSQE_IO_LINK : 0;
+        sqe->user_data = write_tag | buffer;
+        posted_write_buffers_.push_back(buffer);
+        ++num_posted_writes_;
+      }
+      return;
+    }
+
+    void IoUring::release() noexcept {
+      if (sqes_ != MAP_FAILED) {
+        ::munmap(sqes_, sqes_size_);
+        sqes_ = static_cast<struct ::io_uring_sqe*>(MAP_FAILED);
+      }
+      if (ring_memory_ != MAP_FAILED) {
+        ::munmap(ring_memory_, ring_memory_size_);
+        ring_memory_ = MAP_FAILED;
+      }
+      if (ring_ >= 0) {
+        ::close(ring_);
+        ring_ = -1;
+      }
+      return;
+    }
+
+    void IoUring::postReceive() {
+      auto* const sqe {getSqe()};
+      sqe->opcode = IORING_OP_RECV;
+      sqe->fd = socket_;
+      sqe->flags = IOSQE_BUFFER_SELECT;
+      sqe->buf_group = buffer_group;
+      sqe->len = sizeof(struct ::can_frame);
+      sqe->ioprio = is_multishot_ ? IORING_RECV_MULTISHOT : 0;
+      sqe->user_data = receive_tag;
+      is_receive_posted_ = true;
+      return;
+    }
+
+    void IoUring::provideBuffer(std::uint16_t const buffer) {
+      auto* const sqe {getSqe()};
+      sqe->opcode = IORING_OP_PROVIDE_BUFFERS;
+      sqe->fd = 1;
+      sqe->addr = reinterpret_cast<std::uint64_t>(&receive_buffers_[buffer]);
+      sqe->len = sizeof(struct ::can_frame);
+      sqe->off = buffer;
+      sqe->buf_group = buffer_group;
+      sqe->user_data = provide_tag;
+      ++num_provided_;
+      if (!is_receive_posted_) {
+        postReceive();
+      }
+      return;
+    }
+
+  }
+}
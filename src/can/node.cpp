@@ -9,32 +9,54 @@
 #include <cerrno>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <system_error>
+#include <utility>
 #include <vector>
 
 #include <linux/can.h>
 #include <linux/can/error.h>
 #include <linux/can/raw.h>
 #include <net/if.h>
+#include <poll.h>
 #include <sys/ioctl.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <sys/time.h>
 #include <sys/types.h>
+#include <time.h>
 #include <unistd.h>
 
 #include "myactuator_rmd/can/exceptions.hpp"
+#include "myactuator_rmd/can/filter.hpp"
 #include "myactuator_rmd/can/frame.hpp"
+#include "myactuator_rmd/can/io_uring.hpp"
+#include "myactuator_rmd/can/tx_queue.hpp"
 #include "myactuator_rmd/can/utilities.hpp"
 
 
 namespace myactuator_rmd {
   namespace can {
 
+    namespace {
+      struct ::can_frame toCanFrame(std::uint32_t const can_id, std::array<std::uint8_t,8> const& data) noexcept {
+        struct ::can_frame frame {};
+        frame.can_id = can_id;
+        frame.len = 8;
+        std::copy(std::begin(data), std::end(data), std::begin(frame.data));
+        return frame;
+      }
+
+      // Maximum number of frames handed to the kernel with a single call to sendmmsg
+      constexpr std::size_t max_burst_size {32};
+    }
+
     Node::Node(std::string const& ifname, std::chrono::microseconds const& send_timeout, std::chrono::microseconds const& receive_timeout,
                bool const is_signal_errors)
-    : ifname_{}, socket_{-1} {
+    : ifname_{}, socket_{-1}, send_timeout_{send_timeout}, receive_timeout_{receive_timeout}, spin_budget_{0}, io_uring_{},
+      num_written_frames_{0}, num_rejected_writes_{0}, num_read_frames_{0}, num_dropped_frames_{0}, timestamp_{0}, num_syscalls_{0} {
       initSocket(ifname);
       setSendTimeout(send_timeout);
       setRecvTimeout(receive_timeout);
@@ -43,6 +65,8 @@ namespace myactuator_rmd {
     }
 
     Node::~Node() {
+      // Cancels the requests of the ring before their socket is closed
+      io_uring_.reset();
       closeSocket();
       return;
     }
@@ -73,11 +97,31 @@ namespace myactuator_rmd {
       return;
     }
 
+    void Node::setRecvFilters(std::vector<Filter> const& filters, bool const is_join_filters) {
+      std::vector<struct ::can_filter> can_filters {};
+      can_filters.reserve(filters.size());
+      for (auto const& filter: filters) {
+        struct ::can_filter f {};
+        f.can_id = filter.getId();
+        f.can_mask = filter.getMask();
+        can_filters.push_back(f);
+      }
+      int const join_filters {static_cast<int>(is_join_filters)};
+      if (::setsockopt(socket_, SOL_CAN_RAW, CAN_RAW_JOIN_FILTERS, &join_filters, sizeof(int)) < 0) {
+        throw SocketException(errno, std::generic_category(), "Interface '" + ifname_ + "' - Could not configure joining read filters");
+      }
+      if (::setsockopt(socket_, SOL_CAN_RAW, CAN_RAW_FILTER, can_filters.data(), sizeof(::can_filter)*can_filters.size()) < 0) {
+        throw SocketException(errno, std::generic_category(), "Interface '" + ifname_ + "' - Could not configure read filter");
+      }
+      return;
+    }
+
     void Node::setSendTimeout(std::chrono::microseconds const& timeout) {
       struct ::timeval const send_timeout {myactuator_rmd::toTimeval(timeout)};
       if (::setsockopt(socket_, SOL_SOCKET, SO_SNDTIMEO, reinterpret_cast<const char*>(&send_timeout), sizeof(struct ::timeval)) < 0) {
         throw SocketException(errno, std::generic_category(), "Interface '" + ifname_ + "' - Error setting socket timeout");
       }
+      send_timeout_ = timeout;
       return;
     }
 
@@ -86,9 +130,96 @@ namespace myactuator_rmd {
       if (::setsockopt(socket_, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&recv_timeout), sizeof(struct ::timeval)) < 0) {
         throw SocketException(errno, std::generic_category(), "Interface '" + ifname_ + "' - Error setting socket timeout");
       }
+      receive_timeout_ = timeout;
+      return;
+    }
+
+    void Node::setRecvBufferSize(int const size) {
+      // Forcing the size exceeds the system-wide limit but requires CAP_NET_ADMIN
+      if (::setsockopt(socket_, SOL_SOCKET, SO_RCVBUFFORCE, &size, sizeof(int)) < 0) {
+        if (::setsockopt(socket_, SOL_SOCKET, SO_RCVBUF, &size, sizeof(int)) < 0) {
+          throw SocketException(errno, std::generic_category(), "Interface '" + ifname_ + "' - Error setting receive buffer size");
+        }
+      }
+      return;
+    }
+
+    void Node::setSendBufferSize(int const size) {
+      if (::setsockopt(socket_, SOL_SOCKET, SO_SNDBUFFORCE, &size, sizeof(int)) < 0) {
+        if (::setsockopt(socket_, SOL_SOCKET, SO_SNDBUF, &size, sizeof(int)) < 0) {
+          throw SocketException(errno, std::generic_category(), "Interface '" + ifname_ + "' - Error setting send buffer size");
+        }
+      }
+      return;
+    }
+
+    int Node::getRecvBufferSize() const {
+      int size {};
+      ::socklen_t length {sizeof(int)};
+      if (::getsockopt(socket_, SOL_SOCKET, SO_RCVBUF, &size, &length) < 0) {
+        throw SocketException(errno, std::generic_category(), "Interface '" + ifname_ + "' - Error getting receive buffer size");
+      }
+      return size;
+    }
+
+    int Node::getSendBufferSize() const {
+      int size {};
+      ::socklen_t length {sizeof(int)};
+      if (::getsockopt(socket_, SOL_SOCKET, SO_SNDBUF, &size, &length) < 0) {
+        throw SocketException(errno, std::generic_category(), "Interface '" + ifname_ + "' - Error getting send buffer size");
+      }
+      return size;
+    }
+
+    void Node::setRxOverflowDetection(bool const is_enabled) {
+      int const rxq_ovfl {static_cast<int>(is_enabled)};
+      if (::setsockopt(socket_, SOL_SOCKET, SO_RXQ_OVFL, &rxq_ovfl, sizeof(int)) < 0) {
+        throw SocketException(errno, std::generic_category(), "Interface '" + ifname_ + "' - Could not configure overflow detection");
+      }
+      return;
+    }
+
+    void Node::setTimestamping(bool const is_enabled) {
+      int const timestamp {static_cast<int>(is_enabled)};
+      if (::setsockopt(socket_, SOL_SOCKET, SO_TIMESTAMP, &timestamp, sizeof(int)) < 0) {
+        throw SocketException(errno, std::generic_category(), "Interface '" + ifname_ + "' - Could not configure timestamping");
+      }
+      return;
+    }
+
+    void Node::setBusyPoll(std::chrono::microseconds const& spin_budget) {
+      spin_budget_ = std::max(spin_budget, std::chrono::microseconds(0));
       return;
     }
 
+    void Node::setKernelBusyPoll(std::chrono::microseconds const& busy_poll) {
+      int const busy_poll_us {static_cast<int>(busy_poll.count())};
+      if (::setsockopt(socket_, SOL_SOCKET, SO_BUSY_POLL, &busy_poll_us, sizeof(int)) < 0) {
+        throw SocketException(errno, std::generic_category(), "Interface '" + ifname_ + "' - Could not configure busy polling");
+      }
+      return;
+    }
+
+    std::uint64_t Node::getNumWrittenFrames() const noexcept {
+      return num_written_frames_ + (io_uring_ ? io_uring_->getNumWrittenFrames() : 0);
+    }
+
+    std::uint64_t Node::getNumRejectedWrites() const noexcept {
+      return num_rejected_writes_ + (io_uring_ ? io_uring_->getNumRejectedWrites() : 0);
+    }
+
+    std::uint64_t Node::getNumReadFrames() const noexcept {
+      return num_read_frames_;
+    }
+
+    std::uint64_t Node::getNumDroppedFrames() const noexcept {
+      return num_dropped_frames_;
+    }
+
+    std::chrono::microseconds Node::getTimestamp() const noexcept {
+      return timestamp_;
+    }
+
     void Node::setErrorFilters(bool const is_signal_errors) {
       // See https://github.com/linux-can/can-utils/blob/master/include/linux/can/error.h
       ::can_err_mask_t err_mask {};
@@ -104,9 +235,13 @@ namespace myactuator_rmd {
 
     Frame Node::read() const {
       struct ::can_frame frame {};
-      if (::read(socket_, &frame, sizeof(struct ::can_frame)) < 0) {
-        throw SocketException(errno, std::generic_category(), "Interface '" + ifname_ + "' - Could not read CAN frame");
+      if (io_uring_) {
+        readIoUring(frame);
+        timestamp_ = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch());
+      } else {
+        readSocket(frame);
       }
+      ++num_read_frames_;
       // We will only receive these frames if the corresponding error mask is set
       // See https://github.com/linux-can/can-utils/blob/master/include/linux/can/error.h
       if (frame.can_id & CAN_ERR_FLAG){
@@ -134,10 +269,7 @@ namespace myactuator_rmd {
           throw Exception("Unknown CAN protocol error: CAN frame '" + ss.str() + "'");
         }
       }
-      std::array<std::uint8_t,8> data {};
-      std::copy(std::begin(frame.data), std::end(frame.data), std::begin(data));
-      Frame const f {frame.can_id, data};
-      return f;
+      return Frame{frame.can_id, frame.data};
     }
 
     void Node::write(Frame const& frame) {
@@ -145,15 +277,243 @@ namespace myactuator_rmd {
     }
 
     void Node::write(std::uint32_t const can_id, std::array<std::uint8_t,8> const& data) {
-      struct ::can_frame frame {};
-      frame.can_id = can_id;
-      frame.len = 8;
-      std::copy(std::begin(data), std::end(data), std::begin(frame.data));
+      struct ::can_frame const frame {toCanFrame(can_id, data)};
+      if (io_uring_) {
+        auto const deadline {std::chrono::steady_clock::now() + send_timeout_};
+        while (!io_uring_->tryWrite(frame)) {
+          // Waits for the kernel to release a write buffer
+          auto const remaining {std::chrono::ceil<std::chrono::microseconds>(deadline - std::chrono::steady_clock::now())};
+          if ((send_timeout_.count() > 0) && (remaining.count() <= 0)) {
+            std::ostringstream ss {};
+            ss << frame;
+            throw SocketException(EAGAIN, std::generic_category(), "Interface '" + ifname_ + "' - Could not write CAN frame '" + ss.str() + "'");
+          }
+          io_uring_->wait((send_timeout_.count() > 0) ? remaining : std::chrono::microseconds(0));
+        }
+        io_uring_->submit();
+        return;
+      }
+      ++num_syscalls_;
       if (::write(socket_, &frame, sizeof(struct ::can_frame)) != sizeof(struct ::can_frame)) {
         std::ostringstream ss {};
         ss << frame;
         throw SocketException(errno, std::generic_category(), "Interface '" + ifname_ + "' - Could not write CAN frame '" + ss.str() + "'");
       }
+      ++num_written_frames_;
+      return;
+    }
+
+    bool Node::tryWrite(Frame const& frame) {
+      return tryWrite(frame.getId(), frame.getData());
+    }
+
+    bool Node::tryWrite(std::uint32_t const can_id, std::array<std::uint8_t,8> const& data) {
+      struct ::can_frame const frame {toCanFrame(can_id, data)};
+      if (io_uring_) {
+        if (!io_uring_->tryWrite(frame)) {
+          return false;
+        }
+        // Counted as written only once the kernel confirmed it, a frame rejected by a full device queue
+        // keeps its write buffer and is written again by the ring
+        io_uring_->submit();
+        return true;
+      }
+      ++num_syscalls_;
+      if (::send(socket_, &frame, sizeof(struct ::can_frame), MSG_DONTWAIT) != sizeof(struct ::can_frame)) {
+        // The socket buffer is full (EAGAIN) or the queue of the network device is full (ENOBUFS)
+        if ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == ENOBUFS)) {
+          ++num_rejected_writes_;
+          return false;
+        }
+        std::ostringstream ss {};
+        ss << frame;
+        throw SocketException(errno, std::generic_category(), "Interface '" + ifname_ + "' - Could not write CAN frame '" + ss.str() + "'");
+      }
+      ++num_written_frames_;
+      return true;
+    }
+
+    std::size_t Node::flush(TxQueue& queue) {
+      std::size_t num_written {0};
+      if (io_uring_) {
+        // Queues as many frames as there are write buffers and submits all of them with a single system call.
+        // Frames rejected by a full device queue hold on to their buffers, so the queue only drains as fast as
+        // the device accepts frames.
+        while (!queue.empty() && io_uring_->tryWrite(toCanFrame(queue.front().getId(), queue.front().getData()))) {
+          queue.pop();
+          ++num_written;
+        }
+        io_uring_->submit();
+        return num_written;
+      }
+      // Writes the frames in bursts so that the requests to different actuators leave back-to-back
+      std::array<struct ::can_frame,max_burst_size> frames {};
+      std::array<struct ::iovec,max_burst_size> iovs {};
+      std::array<struct ::mmsghdr,max_burst_size> msgs {};
+      while (!queue.empty()) {
+        auto const burst_size {std::min(queue.size(), max_burst_size)};
+        for (std::size_t i = 0; i < burst_size; ++i) {
+          auto const& frame {queue.peek(i)};
+          frames[i] = toCanFrame(frame.getId(), frame.getData());
+          iovs[i] = {&frames[i], sizeof(struct ::can_frame)};
+          msgs[i] = {};
+          msgs[i].msg_hdr.msg_iov = &iovs[i];
+          msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+        ++num_syscalls_;
+        int const result {::sendmmsg(socket_, msgs.data(), static_cast<unsigned int>(burst_size), MSG_DONTWAIT)};
+        if (result < 0) {
+          // The socket buffer is full (EAGAIN) or the queue of the network device is full (ENOBUFS)
+          if ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == ENOBUFS)) {
+            ++num_rejected_writes_;
+            break;
+          }
+          std::ostringstream ss {};
+          ss << frames[0];
+          throw SocketException(errno, std::generic_category(), "Interface '" + ifname_ + "' - Could not write CAN frame '" + ss.str() + "'");
+        }
+        for (int i = 0; i < result; ++i) {
+          queue.pop();
+        }
+        num_written += static_cast<std::size_t>(result);
+        num_written_frames_ += static_cast<std::uint64_t>(result);
+        if (static_cast<std::size_t>(result) < burst_size) {
+          break;
+        }
+      }
+      return num_written;
+    }
+
+    std::pair<bool,bool> Node::wait(bool const is_read, bool const is_write, std::chrono::microseconds const& timeout) const {
+      if (io_uring_) {
+        auto const deadline {std::chrono::steady_clock::now() + timeout};
+        while (true) {
+          bool const is_readable {is_read && io_uring_->isReadable()};
+          bool const is_writable {is_write && io_uring_->isWritable()};
+          if (is_readable || is_writable || (!is_read && !is_write)) {
+            return std::make_pair(is_readable, is_writable);
+          }
+          auto const remaining {std::chrono::ceil<std::chrono::microseconds>(deadline - std::chrono::steady_clock::now())};
+          if ((timeout.count() > 0) && (remaining.count() <= 0)) {
+            return std::make_pair(false, false);
+          }
+          io_uring_->wait((timeout.count() > 0) ? remaining : std::chrono::microseconds(0));
+        }
+      }
+      struct ::pollfd fd {};
+      fd.fd = socket_;
+      fd.events = static_cast<short>((is_read ? POLLIN : 0) | (is_write ? POLLOUT : 0));
+      // Deadlines of single requests are often shorter than a millisecond, the resolution of poll
+      auto const seconds {std::chrono::duration_cast<std::chrono::seconds>(timeout)};
+      struct ::timespec const timeout_ts {static_cast<::time_t>(seconds.count()),
+                                          static_cast<long>(std::chrono::nanoseconds(timeout - seconds).count())};
+      int result {};
+      do {
+        ++num_syscalls_;
+        result = ::ppoll(&fd, 1, (timeout.count() > 0) ? &timeout_ts : nullptr, nullptr);
+      } while ((result < 0) && (errno == EINTR));
+      if (result < 0) {
+        throw SocketException(errno, std::generic_category(), "Interface '" + ifname_ + "' - Could not poll socket");
+      }
+      // Errors pending on the socket are reported when reading
+      bool const is_readable {(fd.revents & (POLLIN | POLLERR)) != 0};
+      bool const is_writable {(fd.revents & POLLOUT) != 0};
+      return std::make_pair(is_readable, is_writable);
+    }
+
+    IoBackend Node::setIoBackend(IoBackend const backend) {
+      if ((backend == IoBackend::IO_URING) && !io_uring_) {
+        try {
+          io_uring_ = std::make_unique<IoUring>(socket_);
+        } catch (SocketException const&) {
+          // Kernels without (sufficient) io_uring support fall back to reading and writing the socket
+          io_uring_.reset();
+        }
+      } else if ((backend == IoBackend::READ_WRITE) && io_uring_) {
+        num_syscalls_ += io_uring_->getNumSyscalls();
+        num_written_frames_ += io_uring_->getNumWrittenFrames();
+        num_rejected_writes_ += io_uring_->getNumRejectedWrites();
+        io_uring_.reset();
+      }
+      return getIoBackend();
+    }
+
+    IoBackend Node::getIoBackend() const noexcept {
+      return io_uring_ ? IoBackend::IO_URING : IoBackend::READ_WRITE;
+    }
+
+    std::uint64_t Node::getNumSyscalls() const noexcept {
+      return num_syscalls_ + (io_uring_ ? io_uring_->getNumSyscalls() : 0);
+    }
+
+    void Node::readSocket(struct ::can_frame& frame) const {
+      struct ::iovec iov {&frame, sizeof(struct ::can_frame)};
+      // Receives the drop counter and the receive time as ancillary data if enabled
+      alignas(struct ::cmsghdr) char control[CMSG_SPACE(sizeof(std::uint32_t)) + CMSG_SPACE(sizeof(struct ::timeval))] {};
+      struct ::msghdr msg {};
+      msg.msg_iov = &iov;
+      msg.msg_iovlen = 1;
+      msg.msg_control = control;
+      msg.msg_controllen = sizeof(control);
+      ::ssize_t result {-1};
+      if (spin_budget_.count() > 0) {
+        auto const deadline {std::chrono::steady_clock::now() + spin_budget_};
+        do {
+          ++num_syscalls_;
+          result = ::recvmsg(socket_, &msg, MSG_DONTWAIT);
+        } while ((result < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK)) && (std::chrono::steady_clock::now() < deadline));
+      }
+      // Fall back to a blocking receive if spinning is disabled or its budget was used up
+      if ((result < 0) && ((spin_budget_.count() == 0) || (errno == EAGAIN) || (errno == EWOULDBLOCK))) {
+        ++num_syscalls_;
+        result = ::recvmsg(socket_, &msg, 0);
+      }
+      if ((result < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK))) {
+        throw TimeoutException(errno, std::generic_category(), "Interface '" + ifname_ + "' - Timeout reading CAN frame");
+      } else if (result < 0) {
+        throw SocketException(errno, std::generic_category(), "Interface '" + ifname_ + "' - Could not read CAN frame");
+      }
+      bool is_timestamped {false};
+      for (struct ::cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if ((cmsg->cmsg_level == SOL_SOCKET) && (cmsg->cmsg_type == SO_RXQ_OVFL)) {
+          std::uint32_t num_dropped_frames {};
+          std::memcpy(&num_dropped_frames, CMSG_DATA(cmsg), sizeof(std::uint32_t));
+          num_dropped_frames_ = num_dropped_frames;
+        } else if ((cmsg->cmsg_level == SOL_SOCKET) && (cmsg->cmsg_type == SCM_TIMESTAMP)) {
+          struct ::timeval time {};
+          std::memcpy(&time, CMSG_DATA(cmsg), sizeof(struct ::timeval));
+          timestamp_ = std::chrono::seconds(time.tv_sec) + std::chrono::microseconds(time.tv_usec);
+          is_timestamped = true;
+        }
+      }
+      if (!is_timestamped) {
+        timestamp_ = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch());
+      }
+      return;
+    }
+
+    void Node::readIoUring(struct ::can_frame& frame) const {
+      if (io_uring_->tryRead(frame)) {
+        return;
+      }
+      if (spin_budget_.count() > 0) {
+        // Hands pending writes and buffers to the kernel once and then only polls the completion queue
+        io_uring_->submit();
+        auto const deadline {std::chrono::steady_clock::now() + spin_budget_};
+        while (std::chrono::steady_clock::now() < deadline) {
+          if (io_uring_->tryRead(frame)) {
+            return;
+          }
+        }
+      }
+      auto const deadline {std::chrono::steady_clock::now() + receive_timeout_};
+      while (!io_uring_->tryRead(frame)) {
+        auto const remaining {std::chrono::ceil<std::chrono::microseconds>(deadline - std::chrono::steady_clock::now())};
+        if ((receive_timeout_.count() > 0) && (remaining.count() <= 0)) {
+          throw TimeoutException(EAGAIN, std::generic_category(), "Interface '" + ifname_ + "' - Timeout reading CAN frame");
+        }
+        io_uring_->wait((receive_timeout_.count() > 0) ? remaining : std::chrono::microseconds(0));
+      }
       return;
     }
 
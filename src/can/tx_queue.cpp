@@ -0,0 +1,75 @@
+#include "myactuator_rmd/can/tx_queue.hpp"
+
+#include <cstdint>
+#include <deque>
+
+#include "myactuator_rmd/can/exceptions.hpp"
+#include "myactuator_rmd/can/frame.hpp"
+
+
+namespace myactuator_rmd {
+  namespace can {
+
+    TxQueue::TxQueue(std::size_t const max_size)
+    : max_size_{max_size}, frames_{} {
+      return;
+    }
+
+    bool TxQueue::push(Frame const& frame, TxPriority const priority) {
+      if (size() >= max_size_) {
+        return false;
+      }
+      frames_[static_cast<std::size_t>(priority)].push_back(frame);
+      return true;
+    }
+
+    Frame const& TxQueue::front() const {
+      for (auto const& frames: frames_) {
+        if (!frames.empty()) {
+          return frames.front();
+        }
+      }
+      throw Exception("Transmit queue is empty");
+    }
+
+    Frame const& TxQueue::peek(std::size_t i) const {
+      for (auto const& frames: frames_) {
+        if (i < frames.size()) {
+          return frames[i];
+        }
+        i -= frames.size();
+      }
+      throw Exception("Transmit queue holds less frames than requested");
+    }
+
+    void TxQueue::pop() {
+      for (auto& frames: frames_) {
+        if (!frames.empty()) {
+          frames.pop_front();
+          return;
+        }
+      }
+      throw Exception("Transmit queue is empty");
+    }
+
+    void TxQueue::clear() noexcept {
+      for (auto& frames: frames_) {
+        frames.clear();
+      }
+      return;
+    }
+
+    std::size_t TxQueue::size() const noexcept {
+      std::size_t size {0};
+      for (auto const& frames: frames_) {
+        size += frames.size();
+      }
+      return size;
+    }
+
+    bool TxQueue::empty() const noexcept {
+      return size() == 0;
+    }
+
+  }
+}
@@ -0,0 +1,257 @@
+#include "myactuator_rmd/control/capture.hpp"
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include "myactuator_rmd/actuator_state/feedback.hpp"
+#include "myactuator_rmd/can/exceptions.hpp"
+#include "myactuator_rmd/can/frame.hpp"
+#include "myactuator_rmd/control/periodic_rate.hpp"
+#include "myactuator_rmd/driver/can_address_offset.hpp"
+#include "myactuator_rmd/driver/driver.hpp"
+#include "myactuator_rmd/driver/replay_driver.hpp"
+#include "myactuator_rmd/driver/transfer.hpp"
+#include "myactuator_rmd/protocol/command_type.hpp"
+#include "myactuator_rmd/protocol/requests.hpp"
+#include "myactuator_rmd/protocol/responses.hpp"
+#include "myactuator_rmd/exceptions.hpp"
+
+
+namespace myactuator_rmd {
+
+  namespace {
+    constexpr double two_pi {6.283185307179586};
+
+    /**\class StopGuard
+     * \brief
+     *    Stops the excited actuator when leaving the scope so that it does not keep executing the last set-point
+     *    of the excitation if the capture is aborted by an exception
+    */
+    class StopGuard {
+      public:
+        StopGuard(Driver& driver, Transfer const& transfer)
+        : driver_{driver}, transfer_{transfer}, is_stopped_{false} {
+          return;
+        }
+        StopGuard() = delete;
+        StopGuard(StopGuard const&) = delete;
+        StopGuard& operator = (StopGuard const&) = delete;
+        StopGuard(StopGuard&&) = delete;
+        StopGuard& operator = (StopGuard&&) = delete;
+
+        ~StopGuard() {
+          if (!is_stopped_) {
+            // Best effort only, a failure must not replace the exception that is propagating
+            try {
+              stop();
+            } catch (...) {
+            }
+          }
+          return;
+        }
+
+        /**\fn stop
+         * \brief
+         *    Stop the actuator, propagating any errors
+        */
+        void stop() {
+          is_stopped_ = true;
+          static_cast<void>(driver_.sendRecv(StopMotorRequest{}, transfer_.actuator_id, transfer_.request_offset,
+                                             transfer_.response_offset));
+          return;
+        }
+
+      protected:
+        Driver& driver_;
+        Transfer transfer_;
+        bool is_stopped_;
+    };
+
+    /**\fn decodeSetpoint
+     * \brief
+     *    Decode the set-point of a recorded request
+     *
+     * \param[in] data
+     *    The data of the request
+     * \return
+     *    The set-point in Ampere, degrees per second or degrees
+    */
+    float decodeSetpoint(std::array<std::uint8_t,8> const& data) {
+      if (data[0] == CommandType::TORQUE_CLOSED_LOOP_CONTROL) {
+        return SetTorqueRequest{data}.getTorqueCurrent();
+      } else if (data[0] == CommandType::SPEED_CLOSED_LOOP_CONTROL) {
+        return SetVelocityRequest{data}.getSpeed();
+      }
+      return SetPositionAbsoluteRequest{data}.getPosition();
+    }
+
+    /**\fn decodeFeedback
+     * \brief
+     *    Decode the feedback of a recorded reply
+     *
+     * \param[in] data
+     *    The data of the reply
+     * \return
+     *    The feedback contained in the reply
+    */
+    Feedback decodeFeedback(std::array<std::uint8_t,8> const& data) {
+      if (data[0] == CommandType::TORQUE_CLOSED_LOOP_CONTROL) {
+        return SetTorqueResponse{data}.getStatus();
+      } else if (data[0] == CommandType::SPEED_CLOSED_LOOP_CONTROL) {
+        return SetVelocityResponse{data}.getStatus();
+      }
+      return SetPositionAbsoluteResponse{data}.getStatus();
+    }
+  }
+
+  Capture::Capture(Driver& driver, std::uint32_t const actuator_id, std::size_t const capacity)
+  : mode{CaptureMode::CURRENT}, signal{ExcitationSignal::SINE}, offset{0.0f}, amplitude{0.0f}, frequency{1.0f},
+    end_frequency{1.0f}, max_speed{500.0f}, driver_{driver}, transfers_{Transfer{actuator_id}},
+    requests_(capacity, RecordedFrame{std::chrono::microseconds(0), can::Frame{0, std::array<std::uint8_t,8>{}}}),
+    replies_(capacity, RecordedFrame{std::chrono::microseconds(0), can::Frame{0, std::array<std::uint8_t,8>{}}}),
+    head_{0}, size_{0}, num_overwritten_{0}, num_timeouts_{0} {
+    if (capacity == 0) {
+      throw ValueRangeException("Capacity of the capture has to be positive!");
+    }
+    driver.addId(actuator_id);
+    return;
+  }
+
+  std::size_t Capture::run(std::chrono::microseconds const& duration, std::chrono::microseconds const& period) {
+    auto& transfer {transfers_.front()};
+    std::uint32_t const request_id {transfer.request_offset + transfer.actuator_id};
+    std::uint32_t const reply_id {transfer.response_offset + transfer.actuator_id};
+    std::size_t num_samples {0};
+    auto const start {std::chrono::steady_clock::now()};
+    PeriodicRate rate {period};
+    StopGuard guard {driver_, transfer};
+    while (true) {
+      auto const now {std::chrono::steady_clock::now()};
+      auto const time {std::chrono::duration_cast<std::chrono::microseconds>(now - start)};
+      if (time >= duration) {
+        break;
+      }
+      transfer.request = getRequest(getSetpoint(time, duration));
+      auto const sent {std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch())};
+      try {
+        driver_.sendRecv(transfers_);
+      } catch (can::TimeoutException const&) {
+        ++num_timeouts_;
+      }
+      if (transfer.is_received) {
+        // Overwrites the oldest sample once the buffer is full
+        auto const i {(head_ + size_) % requests_.size()};
+        requests_[i] = RecordedFrame{sent, can::Frame{request_id, transfer.request}};
+        replies_[i] = RecordedFrame{transfer.timestamp, can::Frame{reply_id, transfer.response}};
+        if (size_ < requests_.size()) {
+          ++size_;
+        } else {
+          head_ = (head_ + 1) % requests_.size();
+          ++num_overwritten_;
+        }
+        ++num_samples;
+      }
+      static_cast<void>(rate.sleep());
+    }
+    guard.stop();
+    return num_samples;
+  }
+
+  float Capture::getSetpoint(std::chrono::microseconds const& time, std::chrono::microseconds const& duration) const noexcept {
+    double const t {std::chrono::duration<double>(time).count()};
+    double phase {two_pi*frequency*t};
+    if (signal == ExcitationSignal::CHIRP) {
+      // Sweeps the frequency linearly over the whole duration
+      double const d {std::chrono::duration<double>(duration).count()};
+      double const rate {(d > 0.0) ? (end_frequency - frequency)/d : 0.0};
+      phase = two_pi*(frequency*t + 0.5*rate*t*t);
+    }
+    double const s {std::sin(phase)};
+    if (signal == ExcitationSignal::SQUARE) {
+      return offset + ((s >= 0.0) ? amplitude : -amplitude);
+    }
+    return offset + amplitude*static_cast<float>(s);
+  }
+
+  void Capture::clear() noexcept {
+    head_ = 0;
+    size_ = 0;
+    return;
+  }
+
+  std::size_t Capture::size() const noexcept {
+    return size_;
+  }
+
+  std::uint64_t Capture::getNumOverwritten() const noexcept {
+    return num_overwritten_;
+  }
+
+  std::uint64_t Capture::getNumTimeouts() const noexcept {
+    return num_timeouts_;
+  }
+
+  std::vector<RecordedFrame> Capture::getFrames() const {
+    std::vector<RecordedFrame> frames {};
+    frames.reserve(2*size_);
+    for (std::size_t j = 0; j < size_; ++j) {
+      auto const i {(head_ + j) % requests_.size()};
+      frames.push_back(requests_[i]);
+      frames.push_back(replies_[i]);
+    }
+    return frames;
+  }
+
+  CaptureData Capture::decode() const {
+    CaptureData data {};
+    data.time.reserve(size_);
+    data.setpoint.reserve(size_);
+    data.temperature.reserve(size_);
+    data.current.reserve(size_);
+    data.velocity.reserve(size_);
+    data.position.reserve(size_);
+    for (std::size_t j = 0; j < size_; ++j) {
+      auto const i {(head_ + j) % requests_.size()};
+      auto const& reply {replies_[i]};
+      auto const feedback {decodeFeedback(reply.frame.getData())};
+      data.time.push_back(std::chrono::duration<double>(reply.timestamp - replies_[head_].timestamp).count());
+      data.setpoint.push_back(decodeSetpoint(requests_[i].frame.getData()));
+      data.temperature.push_back(static_cast<float>(feedback.temperature));
+      data.current.push_back(feedback.current);
+      data.velocity.push_back(feedback.shaft_speed);
+      data.position.push_back(feedback.shaft_angle);
+    }
+    return data;
+  }
+
+  void Capture::writeCsv(std::ostream& os) const {
+    auto const data {decode()};
+    auto const precision {os.precision(9)};
+    os << "time,setpoint,temperature,current,velocity,position\n";
+    for (std::size_t i = 0; i < data.time.size(); ++i) {
+      os << data.time[i] << ',' << data.setpoint[i] << ',' << data.temperature[i] << ',' << data.current[i] << ','
+         << data.velocity[i] << ',' << data.position[i] << '\n';
+    }
+    os.precision(precision);
+    return;
+  }
+
+  void Capture::writeBinary(std::ostream& os) const {
+    writeBinaryLog(os, getFrames());
+    return;
+  }
+
+  std::array<std::uint8_t,8> Capture::getRequest(float const setpoint) const {
+    if (mode == CaptureMode::CURRENT) {
+      return SetTorqueRequest{setpoint}.getData();
+    } else if (mode == CaptureMode::VELOCITY) {
+      return SetVelocityRequest{setpoint}.getData();
+    }
+    return SetPositionAbsoluteRequest{setpoint, max_speed}.getData();
+  }
+
+}
@@ -0,0 +1,128 @@
+#include "myactuator_rmd/control/compensation.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "myactuator_rmd/actuator_state/motion_control_status.hpp"
+#include "myactuator_rmd/control/controller.hpp"
+#include "myactuator_rmd/exceptions.hpp"
+
+
+namespace myactuator_rmd {
+
+  float FrictionModel::getTorque(float const speed) const noexcept {
+    if (speed == 0.0f) {
+      return 0.0f;
+    }
+    float friction {coulomb};
+    if (stribeck_speed > 0.0f) {
+      float const ratio {speed/stribeck_speed};
+      friction += (static_friction - coulomb)*std::exp(-ratio*ratio);
+    }
+    return std::copysign(friction, speed) + viscous*speed;
+  }
+
+  Compensation::Compensation(std::uint32_t const encoder_range, float const max_speed, std::size_t const num_friction_bins)
+  : encoder_range_{encoder_range}, max_speed_{max_speed}, cogging_{}, cogging_scale_{}, friction_model_{},
+    friction_(num_friction_bins), friction_scale_{}, reference_encoder_{}, reference_angle_{}, counts_per_degree_{} {
+    if (encoder_range == 0) {
+      throw ValueRangeException("Encoder range has to be positive!");
+    } else if (!(max_speed > 0.0f)) {
+      throw ValueRangeException("Maximum speed of the friction table has to be positive!");
+    } else if (num_friction_bins < 2) {
+      throw ValueRangeException("Friction table requires at least two entries!");
+    }
+    friction_scale_ = static_cast<float>(num_friction_bins - 1)/(2.0f*max_speed);
+    setCoggingTable({0.0f});
+    setFrictionModel(FrictionModel{});
+    setEncoderReference(0, 0.0f, 1.0f);
+    return;
+  }
+
+  std::uint32_t Compensation::getEncoderRange() const noexcept {
+    return encoder_range_;
+  }
+
+  void Compensation::setCoggingTable(std::vector<float> const& torques) {
+    if (torques.empty()) {
+      throw ValueRangeException("Cogging table requires at least one entry!");
+    }
+    // The first entry is repeated at the end so that interpolating the last interval does not have to wrap
+    cogging_.assign(torques.begin(), torques.end());
+    cogging_.push_back(torques.front());
+    cogging_scale_ = static_cast<float>(torques.size())/static_cast<float>(encoder_range_);
+    return;
+  }
+
+  std::vector<float> Compensation::getCoggingTable() const {
+    return std::vector<float>(cogging_.begin(), cogging_.end() - 1);
+  }
+
+  void Compensation::setFrictionModel(FrictionModel const& model) noexcept {
+    friction_model_ = model;
+    for (std::size_t i = 0; i < friction_.size(); ++i) {
+      friction_[i] = model.getTorque(static_cast<float>(i)/friction_scale_ - max_speed_);
+    }
+    return;
+  }
+
+  FrictionModel const& Compensation::getFrictionModel() const noexcept {
+    return friction_model_;
+  }
+
+  void Compensation::setEncoderReference(std::int16_t const encoder_position, float const shaft_angle,
+                                         float const reducer_ratio) noexcept {
+    reference_encoder_ = static_cast<float>(static_cast<std::uint16_t>(encoder_position));
+    reference_angle_ = shaft_angle;
+    counts_per_degree_ = static_cast<double>(reducer_ratio)*static_cast<double>(encoder_range_)/360.0;
+    return;
+  }
+
+  float Compensation::getEncoderPosition(float const shaft_angle) const noexcept {
+    // Computed in double precision as multi-turn angles multiplied by the reducer ratio exceed the mantissa of a float
+    double const position {reference_encoder_ + (shaft_angle - reference_angle_)*counts_per_degree_};
+    double const range {static_cast<double>(encoder_range_)};
+    return static_cast<float>(position - range*std::floor(position/range));
+  }
+
+  float Compensation::getCoggingTorque(float const encoder_position) const noexcept {
+    float const num_bins {static_cast<float>(cogging_.size() - 1)};
+    float x {encoder_position*cogging_scale_};
+    x -= num_bins*std::floor(x/num_bins);
+    auto const i {std::min(static_cast<std::size_t>(x), cogging_.size() - 2)};
+    float const t {x - static_cast<float>(i)};
+    return cogging_[i] + t*(cogging_[i+1] - cogging_[i]);
+  }
+
+  float Compensation::getFrictionTorque(float const speed) const noexcept {
+    float const clamped_speed {std::clamp(speed, -max_speed_, max_speed_)};
+    float const x {(clamped_speed + max_speed_)*friction_scale_};
+    auto const i {std::min(static_cast<std::size_t>(x), friction_.size() - 2)};
+    float const t {x - static_cast<float>(i)};
+    return friction_[i] + t*(friction_[i+1] - friction_[i]) + friction_model_.viscous*(speed - clamped_speed);
+  }
+
+  float Compensation::getTorque(float const encoder_position, float const speed) const noexcept {
+    return getCoggingTorque(encoder_position) + getFrictionTorque(speed);
+  }
+
+  CompensationController::CompensationController(std::vector<Compensation> const& compensations)
+  : compensations_{compensations} {
+    return;
+  }
+
+  void CompensationController::update(std::vector<MotionControlStatus> const& status,
+                                      std::vector<MotionControlCommand>& command) {
+    constexpr float rad_to_deg {57.2957795f};
+    std::size_t const n {std::min({compensations_.size(), status.size(), command.size()})};
+    for (std::size_t i = 0; i < n; ++i) {
+      auto const& compensation {compensations_[i]};
+      float const encoder_position {compensation.getEncoderPosition(status[i].shaft_angle*rad_to_deg)};
+      command[i].t_ff += compensation.getTorque(encoder_position, command[i].v_des*rad_to_deg);
+    }
+    return;
+  }
+
+}
@@ -0,0 +1,218 @@
+#include "myactuator_rmd/control/compensation_calibration.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "myactuator_rmd/control/compensation.hpp"
+#include "myactuator_rmd/control/periodic_rate.hpp"
+#include "myactuator_rmd/actuator_interface.hpp"
+#include "myactuator_rmd/exceptions.hpp"
+
+
+namespace myactuator_rmd {
+
+  namespace {
+
+    /**\class HaltGuard
+     * \brief
+     *    Commands a velocity of zero when leaving the scope so that the actuator does not keep turning if a
+     *    calibration is aborted by an exception
+    */
+    class HaltGuard {
+      public:
+        HaltGuard(ActuatorInterface& actuator)
+        : actuator_{actuator}, is_halted_{false} {
+          return;
+        }
+        HaltGuard() = delete;
+        HaltGuard(HaltGuard const&) = delete;
+        HaltGuard& operator = (HaltGuard const&) = delete;
+        HaltGuard(HaltGuard&&) = delete;
+        HaltGuard& operator = (HaltGuard&&) = delete;
+
+        ~HaltGuard() {
+          if (!is_halted_) {
+            // Best effort only, a failure must not replace the exception that is propagating
+            try {
+              halt();
+            } catch (...) {
+            }
+          }
+          return;
+        }
+
+        /**\fn halt
+         * \brief
+         *    Command a velocity of zero, propagating any errors
+        */
+        void halt() {
+          is_halted_ = true;
+          static_cast<void>(actuator_.sendVelocitySetpoint(0.0f));
+          return;
+        }
+
+      protected:
+        ActuatorInterface& actuator_;
+        bool is_halted_;
+    };
+
+  }
+
+  CompensationCalibration::CompensationCalibration(ActuatorInterface& actuator, float const torque_constant,
+                                                   std::chrono::microseconds const& period)
+  : num_settling_samples{250}, actuator_{actuator}, torque_constant_{torque_constant}, period_{period}, rate_{period},
+    overruns_{0} {
+    if (!(torque_constant > 0.0f)) {
+      throw ValueRangeException("Torque constant has to be positive!");
+    } else if (period.count() <= 0) {
+      throw ValueRangeException("Sampling period has to be positive!");
+    }
+    return;
+  }
+
+  FrictionModel CompensationCalibration::calibrateFriction(Compensation& compensation, std::vector<float> const& speeds,
+                                                           std::size_t const num_samples) {
+    if (num_samples == 0) {
+      throw ValueRangeException("Number of samples has to be positive!");
+    }
+    // Fit the friction f = c + b*v to half the difference of both directions, which cancels constant loads
+    double sum_v {0.0};
+    double sum_f {0.0};
+    double sum_vv {0.0};
+    double sum_vf {0.0};
+    HaltGuard guard {actuator_};
+    rate_.reset();
+    for (auto const& speed: speeds) {
+      double const v {std::fabs(speed)};
+      double const f {0.5*(measureTorque(std::fabs(speed), num_samples) - measureTorque(-std::fabs(speed), num_samples))};
+      sum_v += v;
+      sum_f += f;
+      sum_vv += v*v;
+      sum_vf += v*f;
+    }
+    guard.halt();
+    double const n {static_cast<double>(speeds.size())};
+    double const determinant {n*sum_vv - sum_v*sum_v};
+    if (!(determinant > 1e-9*n*sum_vv)) {
+      throw ValueRangeException("Friction calibration requires at least two different speeds!");
+    }
+    auto const viscous {static_cast<float>((n*sum_vf - sum_v*sum_f)/determinant)};
+    auto const coulomb {static_cast<float>((sum_f - viscous*sum_v)/n)};
+    FrictionModel const model {coulomb, coulomb, compensation.getFrictionModel().stribeck_speed, viscous};
+    compensation.setFrictionModel(model);
+    return model;
+  }
+
+  std::vector<float> CompensationCalibration::calibrateCogging(Compensation& compensation, float const speed,
+                                                               float const reducer_ratio, std::size_t const num_bins) {
+    if (!(std::fabs(speed) > 0.0f)) {
+      throw ValueRangeException("Speed of the cogging calibration has to be non-zero!");
+    } else if (!(reducer_ratio > 0.0f)) {
+      throw ValueRangeException("Reducer ratio has to be positive!");
+    } else if (num_bins == 0) {
+      throw ValueRangeException("Cogging table requires at least one entry!");
+    }
+    std::size_t const encoder_range {compensation.getEncoderRange()};
+    // One revolution of the encoder takes a fraction of a revolution of the output shaft
+    std::chrono::duration<double> const revolution_time {360.0/(static_cast<double>(reducer_ratio)*std::fabs(speed))};
+    auto const num_samples {static_cast<std::size_t>(std::ceil(revolution_time/period_)) + 1};
+    std::vector<double> sums[2] {std::vector<double>(num_bins), std::vector<double>(num_bins)};
+    std::vector<std::size_t> counts[2] {std::vector<std::size_t>(num_bins), std::vector<std::size_t>(num_bins)};
+    HaltGuard guard {actuator_};
+    rate_.reset();
+    for (std::size_t d = 0; d < 2; ++d) {
+      float const setpoint {(d == 0) ? std::fabs(speed) : -std::fabs(speed)};
+      for (std::size_t i = 0; i < num_settling_samples; ++i) {
+        static_cast<void>(actuator_.sendVelocitySetpoint(setpoint));
+        wait();
+      }
+      for (std::size_t i = 0; i < num_samples; ++i) {
+        float const torque {actuator_.sendVelocitySetpoint(setpoint).current*torque_constant_};
+        auto const encoder_position {static_cast<std::uint16_t>(actuator_.getSingleTurnEncoderPosition())};
+        // Every entry of the table averages the samples closest to its encoder position
+        auto const bin {((encoder_position % encoder_range)*num_bins + encoder_range/2)/encoder_range % num_bins};
+        sums[d][bin] += torque;
+        ++counts[d][bin];
+        wait();
+      }
+    }
+    guard.halt();
+    // Averaging both directions cancels the friction, removing the mean cancels constant loads
+    std::vector<float> table(num_bins);
+    std::vector<bool> is_valid(num_bins);
+    double sum {0.0};
+    std::size_t num_valid {0};
+    for (std::size_t b = 0; b < num_bins; ++b) {
+      is_valid[b] = (counts[0][b] > 0) && (counts[1][b] > 0);
+      if (is_valid[b]) {
+        table[b] = static_cast<float>(0.5*(sums[0][b]/counts[0][b] + sums[1][b]/counts[1][b]));
+        sum += table[b];
+        ++num_valid;
+      }
+    }
+    if (num_valid == 0) {
+      throw ValueRangeException("No sample covered both directions, decrease the number of bins!");
+    }
+    for (std::size_t b = 0; b < num_bins; ++b) {
+      if (is_valid[b]) {
+        continue;
+      }
+      // Interpolate between the closest valid entries around the revolution
+      std::size_t before {1};
+      while (!is_valid[(b + num_bins - before) % num_bins]) {
+        ++before;
+      }
+      std::size_t after {1};
+      while (!is_valid[(b + after) % num_bins]) {
+        ++after;
+      }
+      float const lower {table[(b + num_bins - before) % num_bins]};
+      float const upper {table[(b + after) % num_bins]};
+      table[b] = lower + (upper - lower)*static_cast<float>(before)/static_cast<float>(before + after);
+    }
+    // Only removed once all entries were filled as interpolating reads the averages of the neighbouring entries
+    float const mean {static_cast<float>(sum/num_valid)};
+    for (auto& torque: table) {
+      torque -= mean;
+    }
+    compensation.setCoggingTable(table);
+    auto const encoder_position {actuator_.getSingleTurnEncoderPosition()};
+    compensation.setEncoderReference(encoder_position, actuator_.getMultiTurnAngle(), reducer_ratio);
+    return table;
+  }
+
+  void CompensationCalibration::calibrate(Compensation& compensation, std::vector<float> const& speeds,
+                                          float const cogging_speed, float const reducer_ratio) {
+    static_cast<void>(calibrateFriction(compensation, speeds));
+    static_cast<void>(calibrateCogging(compensation, cogging_speed, reducer_ratio));
+    return;
+  }
+
+  std::uint64_t CompensationCalibration::getNumOverruns() const noexcept {
+    return overruns_;
+  }
+
+  float CompensationCalibration::measureTorque(float const speed, std::size_t const num_samples) {
+    for (std::size_t i = 0; i < num_settling_samples; ++i) {
+      static_cast<void>(actuator_.sendVelocitySetpoint(speed));
+      wait();
+    }
+    double sum {0.0};
+    for (std::size_t i = 0; i < num_samples; ++i) {
+      sum += actuator_.sendVelocitySetpoint(speed).current*torque_constant_;
+      wait();
+    }
+    return static_cast<float>(sum/num_samples);
+  }
+
+  void CompensationCalibration::wait() {
+    if (!rate_.sleep()) {
+      ++overruns_;
+    }
+    return;
+  }
+
+}
@@ -0,0 +1,121 @@
+#include "myactuator_rmd/control/gain_tuner.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#include "myactuator_rmd/actuator_state/gain_type.hpp"
+#include "myactuator_rmd/control/periodic_rate.hpp"
+#include "myactuator_rmd/control/step_response.hpp"
+#include "myactuator_rmd/actuator_interface.hpp"
+#include "myactuator_rmd/exceptions.hpp"
+
+
+namespace myactuator_rmd {
+
+  GainTuner::GainTuner(ActuatorInterface& actuator, ExcitationType const type, float const amplitude,
+                       std::chrono::microseconds const& period, std::size_t const num_samples)
+  : overshoot_weight{1.0f}, max_speed{500.0f}, actuator_{actuator}, type_{type}, amplitude_{amplitude}, period_{period},
+    num_samples_{num_samples}, response_{num_samples}, num_experiments_{0}, overruns_{0} {
+    if (period.count() <= 0) {
+      throw ValueRangeException("Sampling period has to be positive!");
+    } else if (num_samples == 0) {
+      throw ValueRangeException("Number of samples has to be positive!");
+    }
+    return;
+  }
+
+  StepResponse const& GainTuner::runStep() {
+    float const initial_setpoint {(type_ == ExcitationType::POSITION_STEP) ? actuator_.getMotorStatus2().shaft_angle : 0.0f};
+    float const target {initial_setpoint + amplitude_};
+    float const initial {command(initial_setpoint)};
+    response_.reset(initial, target);
+    // Samples are taken on a fixed grid, a period that cannot be kept only shifts the following samples
+    PeriodicRate rate {period_};
+    for (std::size_t i = 0; i < 2*num_samples_; ++i) {
+      if (i < num_samples_) {
+        response_.update(i*period_, command(target));
+      } else {
+        static_cast<void>(command(initial_setpoint));
+      }
+      if (!rate.sleep()) {
+        ++overruns_;
+      }
+    }
+    ++num_experiments_;
+    return response_;
+  }
+
+  float GainTuner::evaluate(GainType const gain_type, float const gain) {
+    static_cast<void>(actuator_.setSingleGain(gain_type, gain));
+    return getCost(runStep());
+  }
+
+  float GainTuner::tune(GainType const gain_type, float const min_gain, float const max_gain, std::size_t const num_experiments) {
+    if (!(min_gain < max_gain)) {
+      throw ValueRangeException("Lower bound of the gain has to be below its upper bound!");
+    } else if (num_experiments < 2) {
+      throw ValueRangeException("Tuning requires at least two experiments!");
+    }
+    // Golden-section search reuses one of the two inner points in every iteration
+    constexpr float inv_phi {0.618034f};
+    float lower {min_gain};
+    float upper {max_gain};
+    float c {upper - inv_phi*(upper - lower)};
+    float d {lower + inv_phi*(upper - lower)};
+    float cost_c {evaluate(gain_type, c)};
+    float cost_d {evaluate(gain_type, d)};
+    float best_gain {(cost_c <= cost_d) ? c : d};
+    float best_cost {std::min(cost_c, cost_d)};
+    for (std::size_t i = 2; i < num_experiments; ++i) {
+      float gain {};
+      float cost {};
+      if (cost_c <= cost_d) {
+        upper = d;
+        d = c;
+        cost_d = cost_c;
+        c = upper - inv_phi*(upper - lower);
+        gain = c;
+        cost = cost_c = evaluate(gain_type, c);
+      } else {
+        lower = c;
+        c = d;
+        cost_c = cost_d;
+        d = lower + inv_phi*(upper - lower);
+        gain = d;
+        cost = cost_d = evaluate(gain_type, d);
+      }
+      if (cost < best_cost) {
+        best_gain = gain;
+        best_cost = cost;
+      }
+    }
+    static_cast<void>(actuator_.setSingleGain(gain_type, best_gain));
+    return best_gain;
+  }
+
+  float GainTuner::getCost(StepResponse const& response) const noexcept {
+    float const duration {std::chrono::duration<float>(num_samples_*period_).count()};
+    float const cost {response.getIntegralAbsoluteError()/duration + overshoot_weight*response.getOvershoot()};
+    // An unstable response must never be taken for the best one
+    return std::isfinite(cost) ? cost : std::numeric_limits<float>::max();
+  }
+
+  std::size_t GainTuner::getNumExperiments() const noexcept {
+    return num_experiments_;
+  }
+
+  std::uint64_t GainTuner::getNumOverruns() const noexcept {
+    return overruns_;
+  }
+
+  float GainTuner::command(float const setpoint) {
+    if (type_ == ExcitationType::POSITION_STEP) {
+      return actuator_.sendPositionAbsoluteSetpoint(setpoint, max_speed).shaft_angle;
+    }
+    return actuator_.sendVelocitySetpoint(setpoint).shaft_speed;
+  }
+
+}
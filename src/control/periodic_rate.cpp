@@ -0,0 +1,42 @@
+#include "myactuator_rmd/control/periodic_rate.hpp"
+
+#include <chrono>
+#include <thread>
+
+#include "myactuator_rmd/exceptions.hpp"
+
+
+namespace myactuator_rmd {
+
+  PeriodicRate::PeriodicRate(std::chrono::microseconds const& period)
+  : period_{period}, next_{std::chrono::steady_clock::now()} {
+    if (period.count() < 0) {
+      throw ValueRangeException("Period must not be negative!");
+    }
+    return;
+  }
+
+  void PeriodicRate::reset() noexcept {
+    next_ = std::chrono::steady_clock::now();
+    return;
+  }
+
+  bool PeriodicRate::sleep() {
+    if (period_.count() == 0) {
+      return true;
+    }
+    next_ += period_;
+    auto const now {std::chrono::steady_clock::now()};
+    if (now > next_ + period_) {
+      next_ = now;
+      return false;
+    }
+    std::this_thread::sleep_until(next_);
+    return true;
+  }
+
+  std::chrono::microseconds PeriodicRate::getPeriod() const noexcept {
+    return period_;
+  }
+
+}
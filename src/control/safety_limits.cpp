@@ -0,0 +1,131 @@
+#include "myactuator_rmd/control/safety_limits.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+
+namespace myactuator_rmd {
+
+  namespace {
+    constexpr float rad_to_deg {57.2957795f};
+
+    /**\fn limit
+     * \brief
+     *    Clamp a value to the given range, not-a-number is replaced by the lower bound
+     *
+     * \param[in] value
+     *    The value to be clamped
+     * \param[in] lower
+     *    The lower bound
+     * \param[in] upper
+     *    The upper bound
+     * \return
+     *    The clamped value
+    */
+    inline float limit(float const value, float const lower, float const upper) noexcept {
+      return std::fmin(std::fmax(value, lower), upper);
+    }
+  }
+
+  SafetyLimits::SafetyLimits(std::size_t const num_actuators)
+  : min_position(num_actuators, -12.5f), max_position(num_actuators, 12.5f), max_velocity(num_actuators, 45.0f),
+    max_torque(num_actuators, 24.0f), max_current(num_actuators, std::numeric_limits<float>::max()),
+    derating_temperature(num_actuators, std::numeric_limits<float>::max()),
+    max_temperature(num_actuators, std::numeric_limits<float>::max()),
+    setpoint_action{SafetyAction::CLAMP}, feedback_action{SafetyAction::STOP},
+    num_actuators_{num_actuators}, derating_(num_actuators, 1.0f), num_violations_{0}, trip_{SafetyAction::CLAMP} {
+    return;
+  }
+
+  std::size_t SafetyLimits::getNumActuators() const noexcept {
+    return num_actuators_;
+  }
+
+  std::uint64_t SafetyLimits::getNumViolations() const noexcept {
+    return num_violations_;
+  }
+
+  SafetyAction SafetyLimits::getTrip() const noexcept {
+    return trip_;
+  }
+
+  void SafetyLimits::reset() noexcept {
+    trip_ = SafetyAction::CLAMP;
+    return;
+  }
+
+  SafetyAction SafetyLimits::limitMotionControl(float* p_des, float* v_des, float* t_ff) noexcept {
+    std::size_t num_violations {0};
+    for (std::size_t i = 0; i < num_actuators_; ++i) {
+      float const p {limit(p_des[i], min_position[i], max_position[i])};
+      float const v {limit(v_des[i], -max_velocity[i], max_velocity[i])};
+      float const t {limit(t_ff[i], -max_torque[i]*derating_[i], max_torque[i]*derating_[i])};
+      num_violations += static_cast<std::size_t>(p != p_des[i]) + static_cast<std::size_t>(v != v_des[i]) +
+                        static_cast<std::size_t>(t != t_ff[i]);
+      p_des[i] = p;
+      v_des[i] = v;
+      t_ff[i] = t;
+    }
+    return react(num_violations, setpoint_action);
+  }
+
+  SafetyAction SafetyLimits::limitPositionSetpoint(float* position, float* max_speed) noexcept {
+    std::size_t num_violations {0};
+    for (std::size_t i = 0; i < num_actuators_; ++i) {
+      float const p {limit(position[i], min_position[i]*rad_to_deg, max_position[i]*rad_to_deg)};
+      float const v {limit(max_speed[i], 0.0f, max_velocity[i]*rad_to_deg)};
+      num_violations += static_cast<std::size_t>(p != position[i]) + static_cast<std::size_t>(v != max_speed[i]);
+      position[i] = p;
+      max_speed[i] = v;
+    }
+    return react(num_violations, setpoint_action);
+  }
+
+  SafetyAction SafetyLimits::checkMotionControlFeedback(float const* position, float const* velocity, float const* torque) noexcept {
+    std::size_t num_violations {0};
+    for (std::size_t i = 0; i < num_actuators_; ++i) {
+      // Comparisons with not-a-number are false, so it counts as a violation
+      num_violations += static_cast<std::size_t>(!((position[i] >= min_position[i]) && (position[i] <= max_position[i]))) +
+                        static_cast<std::size_t>(!(std::fabs(velocity[i]) <= max_velocity[i])) +
+                        static_cast<std::size_t>(!(std::fabs(torque[i]) <= max_torque[i]*derating_[i]));
+    }
+    return react(num_violations, feedback_action);
+  }
+
+  SafetyAction SafetyLimits::checkFeedback(float const* shaft_angle, float const* shaft_speed, float const* current,
+                                           float const* temperature) noexcept {
+    std::size_t num_violations {0};
+    for (std::size_t i = 0; i < num_actuators_; ++i) {
+      num_violations += static_cast<std::size_t>(!((shaft_angle[i] >= min_position[i]*rad_to_deg) &&
+                                                   (shaft_angle[i] <= max_position[i]*rad_to_deg))) +
+                        static_cast<std::size_t>(!(std::fabs(shaft_speed[i]) <= max_velocity[i]*rad_to_deg)) +
+                        static_cast<std::size_t>(!(std::fabs(current[i]) <= max_current[i]));
+    }
+    auto const action {react(num_violations, feedback_action)};
+    auto const temperature_action {checkTemperature(temperature)};
+    return std::max(action, temperature_action);
+  }
+
+  SafetyAction SafetyLimits::checkTemperature(float const* temperature) noexcept {
+    std::size_t num_violations {0};
+    for (std::size_t i = 0; i < num_actuators_; ++i) {
+      float const range {std::fmax(max_temperature[i] - derating_temperature[i], std::numeric_limits<float>::epsilon())};
+      derating_[i] = limit((max_temperature[i] - temperature[i])/range, 0.0f, 1.0f);
+      num_violations += static_cast<std::size_t>(!(temperature[i] < max_temperature[i]));
+    }
+    return react(num_violations, feedback_action);
+  }
+
+  SafetyAction SafetyLimits::react(std::size_t const num_violations, SafetyAction const action) noexcept {
+    num_violations_ += num_violations;
+    // A shutdown overrides a stop, neither is released before a reset
+    if (num_violations > 0) {
+      trip_ = std::max(trip_, action);
+    }
+    return trip_;
+  }
+
+}
@@ -0,0 +1,111 @@
+#include "myactuator_rmd/control/step_response.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "myactuator_rmd/exceptions.hpp"
+
+
+namespace myactuator_rmd {
+
+  StepResponse::StepResponse(std::size_t const capacity, float const settling_band)
+  : times_(capacity), values_(capacity), settling_band_{settling_band}, num_samples_{0}, initial_{0.0f}, height_{1.0f},
+    rise_start_{}, rise_end_{}, peak_{}, settling_time_{}, error_{}, integral_error_{}, last_time_{} {
+    reset(0.0f, 1.0f);
+    return;
+  }
+
+  void StepResponse::reset(float const initial, float const target) {
+    if (!(std::fabs(target - initial) > 0.0f)) {
+      throw ValueRangeException("Height of the step has to be non-zero!");
+    }
+    num_samples_ = 0;
+    initial_ = initial;
+    height_ = target - initial;
+    rise_start_ = std::numeric_limits<float>::infinity();
+    rise_end_ = std::numeric_limits<float>::infinity();
+    peak_ = 0.0f;
+    settling_time_ = std::numeric_limits<float>::infinity();
+    error_ = 1.0f;
+    integral_error_ = 0.0f;
+    last_time_ = 0.0f;
+    return;
+  }
+
+  void StepResponse::update(std::chrono::microseconds const& time, float const value) noexcept {
+    if (num_samples_ < times_.size()) {
+      times_[num_samples_] = time;
+      values_[num_samples_] = value;
+    }
+    ++num_samples_;
+    float const t {std::chrono::duration<float>(time).count()};
+    // Normalised so that the step always rises from zero to one
+    float const y {(value - initial_)/height_};
+    if ((y >= 0.1f) && std::isinf(rise_start_)) {
+      rise_start_ = t;
+    }
+    if ((y >= 0.9f) && std::isinf(rise_end_)) {
+      rise_end_ = t;
+    }
+    peak_ = std::fmax(peak_, y);
+    error_ = std::fabs(1.0f - y);
+    if (!(error_ <= settling_band_)) {
+      settling_time_ = std::numeric_limits<float>::infinity();
+    } else if (std::isinf(settling_time_)) {
+      settling_time_ = t;
+    }
+    // Held until the next sample arrives
+    integral_error_ += error_*(t - last_time_);
+    last_time_ = t;
+    return;
+  }
+
+  std::size_t StepResponse::getNumSamples() const noexcept {
+    return std::min(num_samples_, times_.size());
+  }
+
+  std::vector<std::chrono::microseconds> const& StepResponse::getTimes() const noexcept {
+    return times_;
+  }
+
+  std::vector<float> const& StepResponse::getValues() const noexcept {
+    return values_;
+  }
+
+  float StepResponse::getRiseTime() const noexcept {
+    if (std::isinf(rise_end_)) {
+      return std::numeric_limits<float>::infinity();
+    }
+    return rise_end_ - rise_start_;
+  }
+
+  float StepResponse::getOvershoot() const noexcept {
+    return std::fmax(peak_ - 1.0f, 0.0f);
+  }
+
+  float StepResponse::getSettlingTime() const noexcept {
+    return settling_time_;
+  }
+
+  float StepResponse::getSteadyStateError() const noexcept {
+    return error_;
+  }
+
+  float StepResponse::getIntegralAbsoluteError() const noexcept {
+    return integral_error_;
+  }
+
+  float StepResponse::getBandwidth() const noexcept {
+    float const rise_time {getRiseTime()};
+    if (std::isinf(rise_time)) {
+      return 0.0f;
+    }
+    // Rise time of a first-order system is 2.2 time constants
+    return 0.35f/std::fmax(rise_time, std::numeric_limits<float>::epsilon());
+  }
+
+}
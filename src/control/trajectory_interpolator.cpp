@@ -0,0 +1,196 @@
+#include "myactuator_rmd/control/trajectory_interpolator.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "myactuator_rmd/exceptions.hpp"
+
+
+namespace myactuator_rmd {
+
+  TrajectoryInterpolator::TrajectoryInterpolator(std::vector<float> const& position, std::chrono::microseconds const& period,
+                                                 InterpolationType const type, std::size_t const capacity)
+  : kp(position.size()), kd(position.size()), max_speed(position.size(), 500.0f),
+    num_actuators_{position.size()}, period_{period}, type_{type}, capacity_{capacity}, mutex_{},
+    waypoint_positions_(capacity*position.size()), waypoint_durations_(capacity), head_{0}, num_waypoints_{0},
+    start_position_(position.begin(), position.end()), end_position_(position.begin(), position.end()),
+    end_velocity_(position.size()), coefficients_(6*position.size()), duration_{0}, elapsed_{0}, is_moving_{false} {
+    if (period_.count() <= 0) {
+      throw ValueRangeException("Interpolation period has to be positive!");
+    } else if (capacity_ == 0) {
+      throw ValueRangeException("Waypoint capacity has to be positive!");
+    }
+    return;
+  }
+
+  std::size_t TrajectoryInterpolator::getNumActuators() const noexcept {
+    return num_actuators_;
+  }
+
+  std::size_t TrajectoryInterpolator::getNumWaypoints() const {
+    std::lock_guard<std::mutex> const lock {mutex_};
+    return num_waypoints_;
+  }
+
+  bool TrajectoryInterpolator::isMoving() const {
+    std::lock_guard<std::mutex> const lock {mutex_};
+    return is_moving_;
+  }
+
+  bool TrajectoryInterpolator::addWaypoint(std::chrono::microseconds const& duration, float const* position) {
+    if (duration.count() <= 0) {
+      throw ValueRangeException("Duration of a segment has to be positive!");
+    }
+    std::lock_guard<std::mutex> const lock {mutex_};
+    if (num_waypoints_ >= capacity_) {
+      return false;
+    }
+    auto const tail {(head_ + num_waypoints_) % capacity_};
+    std::copy(position, position + num_actuators_, waypoint_positions_.begin() + tail*num_actuators_);
+    waypoint_durations_[tail] = duration;
+    ++num_waypoints_;
+    return true;
+  }
+
+  bool TrajectoryInterpolator::addWaypoint(std::chrono::microseconds const& duration, std::vector<float> const& position) {
+    if (position.size() != num_actuators_) {
+      throw ValueRangeException("Expected one position per actuator (" + std::to_string(num_actuators_) + ")!");
+    }
+    return addWaypoint(duration, position.data());
+  }
+
+  void TrajectoryInterpolator::reset(float const* position) {
+    std::lock_guard<std::mutex> const lock {mutex_};
+    head_ = 0;
+    num_waypoints_ = 0;
+    std::copy(position, position + num_actuators_, end_position_.begin());
+    std::fill(end_velocity_.begin(), end_velocity_.end(), 0.0);
+    elapsed_ = std::chrono::microseconds(0);
+    is_moving_ = false;
+    return;
+  }
+
+  void TrajectoryInterpolator::step(float* position, float* velocity) {
+    std::lock_guard<std::mutex> const lock {mutex_};
+    if (!is_moving_ && (num_waypoints_ > 0)) {
+      startSegment();
+      elapsed_ = std::chrono::microseconds(0);
+    }
+    if (is_moving_) {
+      elapsed_ += period_;
+      // Segments shorter than the period are skipped
+      while (is_moving_ && (elapsed_ >= duration_)) {
+        elapsed_ -= duration_;
+        is_moving_ = false;
+        if (num_waypoints_ > 0) {
+          startSegment();
+        }
+      }
+    }
+    double const t {std::chrono::duration<double>(elapsed_).count()};
+    for (std::size_t i = 0; i < num_actuators_; ++i) {
+      if (is_moving_) {
+        evaluate(i, t, position[i], velocity[i]);
+      } else {
+        position[i] = static_cast<float>(end_position_[i]);
+        velocity[i] = 0.0f;
+      }
+    }
+    return;
+  }
+
+  void TrajectoryInterpolator::startSegment() {
+    float const* const target {&waypoint_positions_[head_*num_actuators_]};
+    duration_ = waypoint_durations_[head_];
+    head_ = (head_ + 1) % capacity_;
+    --num_waypoints_;
+    // The velocity at the waypoint can only be chosen if the following waypoint is known already
+    bool const is_next {(num_waypoints_ > 0) && (type_ != InterpolationType::TRAPEZOIDAL)};
+    float const* const next {&waypoint_positions_[head_*num_actuators_]};
+    double const T {std::chrono::duration<double>(duration_).count()};
+    double const T_next {std::chrono::duration<double>(waypoint_durations_[head_]).count()};
+    for (std::size_t i = 0; i < num_actuators_; ++i) {
+      double const p0 {end_position_[i]};
+      double const v0 {end_velocity_[i]};
+      double const p1 {target[i]};
+      double const h {p1 - p0};
+      double v1 {0.0};
+      if (is_next) {
+        // Average of the neighbouring slopes, zero at extrema so that the waypoint is not overshot
+        double const slope {h/T};
+        double const next_slope {(next[i] - p1)/T_next};
+        v1 = (slope*next_slope > 0.0) ? 0.5*(slope + next_slope) : 0.0;
+      }
+      start_position_[i] = p0;
+      end_position_[i] = p1;
+      end_velocity_[i] = v1;
+      double* const c {&coefficients_[6*i]};
+      switch (type_) {
+        case InterpolationType::CUBIC:
+          c[0] = p0;
+          c[1] = v0;
+          c[2] = (3.0*h/T - 2.0*v0 - v1)/T;
+          c[3] = (-2.0*h/T + v0 + v1)/(T*T);
+          c[4] = 0.0;
+          c[5] = 0.0;
+          break;
+        case InterpolationType::QUINTIC:
+          // Zero acceleration at both waypoints
+          c[0] = p0;
+          c[1] = v0;
+          c[2] = 0.0;
+          c[3] = (20.0*h - (8.0*v1 + 12.0*v0)*T)/(2.0*T*T*T);
+          c[4] = (-30.0*h + (14.0*v1 + 16.0*v0)*T)/(2.0*T*T*T*T);
+          c[5] = (12.0*h - 6.0*(v1 + v0)*T)/(2.0*T*T*T*T*T);
+          break;
+        case InterpolationType::TRAPEZOIDAL: {
+          double const t_acceleration {0.25*T};
+          double const peak_velocity {h/(T - t_acceleration)};
+          c[0] = t_acceleration;
+          c[1] = peak_velocity;
+          c[2] = peak_velocity/t_acceleration;
+          c[3] = T;
+          c[4] = 0.0;
+          c[5] = 0.0;
+          break;
+        }
+      }
+    }
+    is_moving_ = true;
+    return;
+  }
+
+  void TrajectoryInterpolator::evaluate(std::size_t const actuator, double const t, float& position, float& velocity) const noexcept {
+    double const* const c {&coefficients_[6*actuator]};
+    double p {};
+    double v {};
+    if (type_ == InterpolationType::TRAPEZOIDAL) {
+      double const t_acceleration {c[0]};
+      double const peak_velocity {c[1]};
+      double const acceleration {c[2]};
+      double const T {c[3]};
+      if (t < t_acceleration) {
+        p = start_position_[actuator] + 0.5*acceleration*t*t;
+        v = acceleration*t;
+      } else if (t < T - t_acceleration) {
+        p = start_position_[actuator] + 0.5*acceleration*t_acceleration*t_acceleration + peak_velocity*(t - t_acceleration);
+        v = peak_velocity;
+      } else {
+        double const remaining {T - t};
+        p = end_position_[actuator] - 0.5*acceleration*remaining*remaining;
+        v = acceleration*remaining;
+      }
+    } else {
+      p = c[0] + t*(c[1] + t*(c[2] + t*(c[3] + t*(c[4] + t*c[5]))));
+      v = c[1] + t*(2.0*c[2] + t*(3.0*c[3] + t*(4.0*c[4] + t*5.0*c[5])));
+    }
+    position = static_cast<float>(p);
+    velocity = static_cast<float>(v);
+    return;
+  }
+
+}
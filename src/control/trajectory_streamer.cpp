@@ -0,0 +1,259 @@
+#include "myactuator_rmd/control/trajectory_streamer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "myactuator_rmd/actuator_state/motion_control_status.hpp"
+#include "myactuator_rmd/control/controller.hpp"
+#include "myactuator_rmd/control/periodic_rate.hpp"
+#include "myactuator_rmd/control/safety_limits.hpp"
+#include "myactuator_rmd/control/trajectory_interpolator.hpp"
+#include "myactuator_rmd/actuator_group.hpp"
+#include "myactuator_rmd/exceptions.hpp"
+
+
+namespace myactuator_rmd {
+
+  SampledTrajectory::SampledTrajectory(std::size_t const num_samples, std::size_t const num_actuators)
+  : position(num_samples*num_actuators), velocity(num_samples*num_actuators), torque(num_samples*num_actuators),
+    kp(num_actuators), kd(num_actuators), max_speed(num_actuators, 500.0f),
+    num_samples_{num_samples}, num_actuators_{num_actuators} {
+    return;
+  }
+
+  std::size_t SampledTrajectory::getNumSamples() const noexcept {
+    return num_samples_;
+  }
+
+  std::size_t SampledTrajectory::getNumActuators() const noexcept {
+    return num_actuators_;
+  }
+
+  std::size_t SampledTrajectory::index(std::size_t const sample, std::size_t const actuator) const noexcept {
+    return sample*num_actuators_ + actuator;
+  }
+
+  TrajectoryStreamer::TrajectoryStreamer(ActuatorGroup& group, std::chrono::microseconds const& period, StreamMode const mode)
+  : group_{group}, period_{period}, mode_{mode}, mutex_{}, trajectory_{0, group.size()}, pending_trajectory_{},
+    is_pending_{false}, feedback_position_{}, feedback_velocity_{}, feedback_torque_{},
+    pending_feedback_position_{}, pending_feedback_velocity_{}, pending_feedback_torque_{},
+    hold_position_(group.size()), hold_velocity_(group.size()), hold_torque_(group.size()),
+    stage_mutex_{}, interpolator_{nullptr}, controller_{nullptr}, status_{}, commands_(group.size()),
+    command_position_(group.size()), command_velocity_(group.size()), command_kp_(group.size()), command_kd_(group.size()),
+    command_torque_(group.size()), progress_{0}, overruns_{0}, is_running_{false}, error_{}, thread_{} {
+    if (period_.count() <= 0) {
+      throw ValueRangeException("Streaming period has to be positive!");
+    }
+    status_.reserve(group.size());
+    for (auto const& id: group.getActuatorIds()) {
+      status_.emplace_back(static_cast<int>(id));
+    }
+    return;
+  }
+
+  TrajectoryStreamer::~TrajectoryStreamer() {
+    stop();
+    return;
+  }
+
+  void TrajectoryStreamer::setTrajectory(SampledTrajectory const& trajectory) {
+    auto const n {group_.size()};
+    auto const size {trajectory.getNumSamples()*n};
+    if ((trajectory.getNumActuators() != n) || (trajectory.position.size() != size) || (trajectory.velocity.size() != size) ||
+        (trajectory.torque.size() != size) || (trajectory.kp.size() != n) || (trajectory.kd.size() != n) ||
+        (trajectory.max_speed.size() != n)) {
+      throw ValueRangeException("Trajectory does not match the actuator group (" + std::to_string(n) + " actuators)!");
+    }
+    // Allocate the feedback buffers here so that the streaming thread only has to swap them
+    std::lock_guard<std::mutex> const lock {mutex_};
+    pending_trajectory_ = trajectory;
+    pending_feedback_position_.assign(size, 0.0f);
+    pending_feedback_velocity_.assign(size, 0.0f);
+    pending_feedback_torque_.assign(size, 0.0f);
+    is_pending_.store(true, std::memory_order_release);
+    return;
+  }
+
+  void TrajectoryStreamer::setInterpolator(TrajectoryInterpolator* const interpolator) {
+    if (interpolator != nullptr) {
+      auto const n {group_.size()};
+      if ((interpolator->getNumActuators() != n) || (interpolator->kp.size() != n) || (interpolator->kd.size() != n) ||
+          (interpolator->max_speed.size() != n)) {
+        throw ValueRangeException("Interpolator does not match the actuator group (" + std::to_string(n) + " actuators)!");
+      }
+    }
+    // Waits for a sample using the previous interpolator to finish
+    std::lock_guard<std::mutex> const lock {stage_mutex_};
+    interpolator_ = interpolator;
+    return;
+  }
+
+  void TrajectoryStreamer::setController(Controller* const controller) {
+    if ((controller != nullptr) && (mode_ != StreamMode::MOTION_CONTROL)) {
+      throw Exception("Controllers can only be used for streaming motion control commands!");
+    }
+    std::lock_guard<std::mutex> const lock {stage_mutex_};
+    controller_ = controller;
+    return;
+  }
+
+  void TrajectoryStreamer::start() {
+    if (is_running_.load()) {
+      return;
+    }
+    stop();
+    error_.clear();
+    overruns_.store(0);
+    is_running_.store(true);
+    thread_ = std::thread(&TrajectoryStreamer::run, this);
+    return;
+  }
+
+  void TrajectoryStreamer::stop() {
+    is_running_.store(false);
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+    return;
+  }
+
+  bool TrajectoryStreamer::isRunning() const noexcept {
+    return is_running_.load();
+  }
+
+  std::size_t TrajectoryStreamer::getProgress() const noexcept {
+    return progress_.load(std::memory_order_acquire);
+  }
+
+  std::size_t TrajectoryStreamer::getNumSamples() const {
+    std::lock_guard<std::mutex> const lock {mutex_};
+    return trajectory_.getNumSamples();
+  }
+
+  std::size_t TrajectoryStreamer::getOverruns() const noexcept {
+    return overruns_.load();
+  }
+
+  std::string TrajectoryStreamer::getError() const {
+    std::lock_guard<std::mutex> const lock {mutex_};
+    return error_;
+  }
+
+  std::size_t TrajectoryStreamer::getFeedback(std::vector<float>& position, std::vector<float>& velocity,
+                                              std::vector<float>& torque) const {
+    std::lock_guard<std::mutex> const lock {mutex_};
+    // Samples below the progress are not written anymore by the streaming thread
+    auto const progress {progress_.load(std::memory_order_acquire)};
+    auto const size {progress*group_.size()};
+    position.assign(feedback_position_.begin(), feedback_position_.begin() + size);
+    velocity.assign(feedback_velocity_.begin(), feedback_velocity_.begin() + size);
+    torque.assign(feedback_torque_.begin(), feedback_torque_.begin() + size);
+    return progress;
+  }
+
+  void TrajectoryStreamer::run() {
+    PeriodicRate rate {period_};
+    while (is_running_.load()) {
+      try {
+        runOnce();
+      } catch (std::exception const& e) {
+        std::lock_guard<std::mutex> const lock {mutex_};
+        error_ = e.what();
+        is_running_.store(false);
+        break;
+      }
+      if (!rate.sleep()) {
+        overruns_.fetch_add(1);
+      }
+    }
+    return;
+  }
+
+  void TrajectoryStreamer::runOnce() {
+    if (is_pending_.load(std::memory_order_acquire)) {
+      std::lock_guard<std::mutex> const lock {mutex_};
+      std::swap(trajectory_, pending_trajectory_);
+      std::swap(feedback_position_, pending_feedback_position_);
+      std::swap(feedback_velocity_, pending_feedback_velocity_);
+      std::swap(feedback_torque_, pending_feedback_torque_);
+      progress_.store(0, std::memory_order_release);
+      is_pending_.store(false, std::memory_order_release);
+    }
+    auto const num_samples {trajectory_.getNumSamples()};
+    auto const progress {progress_.load(std::memory_order_relaxed)};
+    auto const is_finished {progress >= num_samples};
+    std::lock_guard<std::mutex> const lock {stage_mutex_};
+    bool const is_interpolated {is_finished && (interpolator_ != nullptr)};
+    if (!is_interpolated && (num_samples == 0)) {
+      return;
+    }
+    auto const i {is_interpolated ? 0 : trajectory_.index(std::min(progress, num_samples - 1), 0)};
+    float* const position {is_finished ? hold_position_.data() : &feedback_position_[i]};
+    float* const velocity {is_finished ? hold_velocity_.data() : &feedback_velocity_[i]};
+    float* const torque {is_finished ? hold_torque_.data() : &feedback_torque_[i]};
+    if (is_interpolated) {
+      interpolator_->step(command_position_.data(), command_velocity_.data());
+    }
+    SafetyAction action {SafetyAction::CLAMP};
+    switch (mode_) {
+      case StreamMode::MOTION_CONTROL: {
+        float const* p_des {is_interpolated ? command_position_.data() : &trajectory_.position[i]};
+        float const* v_des {is_interpolated ? command_velocity_.data() : &trajectory_.velocity[i]};
+        float const* kp {is_interpolated ? interpolator_->kp.data() : trajectory_.kp.data()};
+        float const* kd {is_interpolated ? interpolator_->kd.data() : trajectory_.kd.data()};
+        float const* t_ff {is_interpolated ? command_torque_.data() : &trajectory_.torque[i]};
+        if (controller_ != nullptr) {
+          auto const n {commands_.size()};
+          for (std::size_t j = 0; j < n; ++j) {
+            commands_[j] = MotionControlCommand{p_des[j], v_des[j], kp[j], kd[j], t_ff[j]};
+          }
+          controller_->update(status_, commands_);
+          for (std::size_t j = 0; j < n; ++j) {
+            command_position_[j] = commands_[j].p_des;
+            command_velocity_[j] = commands_[j].v_des;
+            command_kp_[j] = commands_[j].kp;
+            command_kd_[j] = commands_[j].kd;
+            command_torque_[j] = commands_[j].t_ff;
+          }
+          p_des = command_position_.data();
+          v_des = command_velocity_.data();
+          kp = command_kp_.data();
+          kd = command_kd_.data();
+          t_ff = command_torque_.data();
+        }
+        action = group_.motionControl(p_des, v_des, kp, kd, t_ff, position, velocity, torque);
+        if ((controller_ != nullptr) && (action == SafetyAction::CLAMP)) {
+          for (std::size_t j = 0; j < status_.size(); ++j) {
+            status_[j].shaft_angle = position[j];
+            status_[j].shaft_speed = velocity[j];
+            status_[j].torque = torque[j];
+          }
+          // Interpolated set-points are sent without feedforward torque
+          std::fill(command_torque_.begin(), command_torque_.end(), 0.0f);
+        }
+        break;
+      }
+      case StreamMode::POSITION_SETPOINT:
+        action = group_.sendPositionAbsoluteSetpoint(is_interpolated ? command_position_.data() : &trajectory_.position[i],
+                                                     is_interpolated ? interpolator_->max_speed.data() : trajectory_.max_speed.data(),
+                                                     position, velocity, torque);
+        break;
+    }
+    if (!is_finished) {
+      progress_.store(progress + 1, std::memory_order_release);
+    }
+    if (action != SafetyAction::CLAMP) {
+      throw Exception("Safety limits halted the actuators!");
+    }
+    return;
+  }
+
+}
@@ -0,0 +1,111 @@
+#include "myactuator_rmd/driver/async_driver.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "myactuator_rmd/driver/driver.hpp"
+#include "myactuator_rmd/driver/transfer.hpp"
+#include "myactuator_rmd/exceptions.hpp"
+
+
+namespace myactuator_rmd {
+
+  AsyncDriver::AsyncDriver(Driver& driver, std::size_t const max_batch_size)
+  : driver_{driver}, max_batch_size_{max_batch_size}, driver_mutex_{}, mutex_{}, condition_{}, queue_{},
+    is_running_{true}, thread_{} {
+    if (max_batch_size_ == 0) {
+      throw ValueRangeException("Maximum batch size has to be positive!");
+    }
+    thread_ = std::thread(&AsyncDriver::run, this);
+    return;
+  }
+
+  AsyncDriver::~AsyncDriver() {
+    std::deque<std::pair<Transfer,Callback>> remaining {};
+    {
+      std::lock_guard<std::mutex> const lock {mutex_};
+      is_running_ = false;
+      remaining.swap(queue_);
+    }
+    condition_.notify_all();
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+    auto const error {std::make_exception_ptr(Exception("Asynchronous driver was destroyed before the transfer was exchanged"))};
+    for (auto const& [transfer, callback]: remaining) {
+      try {
+        callback(transfer, error);
+      } catch (...) {
+      }
+    }
+    return;
+  }
+
+  void AsyncDriver::addId(std::uint32_t const actuator_id) {
+    std::lock_guard<std::mutex> const lock {driver_mutex_};
+    driver_.addId(actuator_id);
+    return;
+  }
+
+  void AsyncDriver::submit(Transfer const& transfer, Callback const& callback) {
+    {
+      std::lock_guard<std::mutex> const lock {mutex_};
+      queue_.emplace_back(transfer, callback);
+    }
+    condition_.notify_one();
+    return;
+  }
+
+  std::size_t AsyncDriver::getPending() const {
+    std::lock_guard<std::mutex> const lock {mutex_};
+    return queue_.size();
+  }
+
+  void AsyncDriver::run() {
+    std::vector<Transfer> transfers {};
+    std::vector<Callback> callbacks {};
+    transfers.reserve(max_batch_size_);
+    callbacks.reserve(max_batch_size_);
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock {mutex_};
+        condition_.wait(lock, [this]() { return !is_running_ || !queue_.empty(); });
+        if (!is_running_) {
+          break;
+        }
+        while (!queue_.empty() && (transfers.size() < max_batch_size_)) {
+          transfers.push_back(queue_.front().first);
+          callbacks.push_back(std::move(queue_.front().second));
+          queue_.pop_front();
+        }
+      }
+      for (auto& transfer: transfers) {
+        transfer.is_received = false;
+      }
+      std::exception_ptr error {};
+      try {
+        std::lock_guard<std::mutex> const lock {driver_mutex_};
+        driver_.sendRecv(transfers);
+      } catch (...) {
+        error = std::current_exception();
+      }
+      // Transfers that were answered before the error occurred still succeed
+      for (std::size_t i = 0; i < transfers.size(); ++i) {
+        try {
+          callbacks[i](transfers[i], transfers[i].is_received ? std::exception_ptr{} : error);
+        } catch (...) {
+        }
+      }
+      transfers.clear();
+      callbacks.clear();
+    }
+    return;
+  }
+
+}
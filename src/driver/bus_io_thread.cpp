@@ -0,0 +1,190 @@
+#include "myactuator_rmd/driver/bus_io_thread.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "myactuator_rmd/driver/driver.hpp"
+#include "myactuator_rmd/driver/transfer.hpp"
+#include "myactuator_rmd/protocol/message.hpp"
+#include "myactuator_rmd/exceptions.hpp"
+
+
+namespace myactuator_rmd {
+
+  IoChannel::IoChannel()
+  : requests_{}, completions_{}, mutex_{}, condition_{}, is_closed_{false} {
+    return;
+  }
+
+  bool IoChannel::trySubmit(IoRequest const& request) {
+    return requests_.tryPush(request);
+  }
+
+  bool IoChannel::tryReceive(IoCompletion& completion) {
+    return completions_.tryPop(completion);
+  }
+
+  bool IoChannel::receive(IoCompletion& completion) {
+    if (completions_.tryPop(completion)) {
+      return true;
+    }
+    bool is_received {false};
+    std::unique_lock<std::mutex> lock {mutex_};
+    condition_.wait(lock, [this, &completion, &is_received]() {
+      is_received = completions_.tryPop(completion);
+      return is_received || is_closed_;
+    });
+    return is_received;
+  }
+
+  void IoChannel::notify() {
+    // Taking the lock orders the push before the check of a client that is about to wait
+    {
+      std::lock_guard<std::mutex> const lock {mutex_};
+    }
+    condition_.notify_one();
+    return;
+  }
+
+  void IoChannel::close() {
+    {
+      std::lock_guard<std::mutex> const lock {mutex_};
+      is_closed_ = true;
+    }
+    condition_.notify_one();
+    return;
+  }
+
+  BusIoThread::BusIoThread(Driver& driver, std::chrono::microseconds const& idle_period, std::size_t const max_batch_size)
+  : driver_{driver}, idle_period_{idle_period}, max_batch_size_{max_batch_size}, driver_mutex_{}, channel_mutex_{},
+    channels_{}, num_channels_{0}, transfers_{}, owners_{}, is_running_{true}, thread_{} {
+    if (max_batch_size_ == 0) {
+      throw ValueRangeException("Maximum batch size has to be positive!");
+    }
+    transfers_.reserve(max_batch_size_);
+    owners_.reserve(max_batch_size_);
+    thread_ = std::thread(&BusIoThread::run, this);
+    return;
+  }
+
+  BusIoThread::~BusIoThread() {
+    is_running_.store(false);
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+    auto const num_channels {num_channels_.load(std::memory_order_acquire)};
+    for (std::size_t i = 0; i < num_channels; ++i) {
+      channels_[i]->close();
+    }
+    return;
+  }
+
+  IoChannel& BusIoThread::openChannel() {
+    std::lock_guard<std::mutex> const lock {channel_mutex_};
+    auto const n {num_channels_.load(std::memory_order_relaxed)};
+    if (n >= max_channels) {
+      throw Exception("I/O thread does not support more than " + std::to_string(max_channels) + " channels!");
+    }
+    channels_[n].reset(new IoChannel{});
+    // Publishes the channel to the I/O thread
+    num_channels_.store(n + 1, std::memory_order_release);
+    return *channels_[n];
+  }
+
+  void BusIoThread::addId(std::uint32_t const actuator_id) {
+    std::lock_guard<std::mutex> const lock {driver_mutex_};
+    driver_.addId(actuator_id);
+    return;
+  }
+
+  bool BusIoThread::isRunning() const noexcept {
+    return is_running_.load();
+  }
+
+  void BusIoThread::run() {
+    std::size_t first_channel {0};
+    while (is_running_.load(std::memory_order_relaxed)) {
+      transfers_.clear();
+      owners_.clear();
+      bool is_idle {true};
+      auto const num_channels {num_channels_.load(std::memory_order_acquire)};
+      // Start at a different channel every cycle so that a busy client can not starve the others
+      for (std::size_t i = 0; i < num_channels; ++i) {
+        auto& channel {*channels_[(first_channel + i) % num_channels]};
+        IoRequest request {};
+        while ((transfers_.size() < max_batch_size_) && channel.requests_.tryPop(request)) {
+          is_idle = false;
+          if (request.is_response_expected) {
+            transfers_.push_back(request.transfer);
+            owners_.emplace_back(&channel, request.tag);
+            continue;
+          }
+          // Requests collected before must go out first, otherwise e.g. a stop could overtake an older set-point
+          flush();
+          std::exception_ptr error {};
+          try {
+            std::lock_guard<std::mutex> const lock {driver_mutex_};
+            driver_.send(RawMessage{request.transfer.request}, request.transfer.actuator_id, request.transfer.request_offset);
+          } catch (...) {
+            error = std::current_exception();
+          }
+          complete(channel, IoCompletion{request.transfer, request.tag, error});
+        }
+      }
+      first_channel = (num_channels > 0) ? (first_channel + 1) % num_channels : 0;
+      if (is_idle) {
+        if (idle_period_.count() > 0) {
+          std::this_thread::sleep_for(idle_period_);
+        } else {
+          std::this_thread::yield();
+        }
+        continue;
+      }
+      flush();
+    }
+    return;
+  }
+
+  void BusIoThread::flush() {
+    if (transfers_.empty()) {
+      return;
+    }
+    for (auto& transfer: transfers_) {
+      transfer.is_received = false;
+    }
+    std::exception_ptr error {};
+    try {
+      std::lock_guard<std::mutex> const lock {driver_mutex_};
+      driver_.sendRecv(transfers_);
+    } catch (...) {
+      error = std::current_exception();
+    }
+    for (std::size_t i = 0; i < transfers_.size(); ++i) {
+      complete(*owners_[i].first, IoCompletion{transfers_[i], owners_[i].second,
+                                               transfers_[i].is_received ? std::exception_ptr{} : error});
+    }
+    transfers_.clear();
+    owners_.clear();
+    return;
+  }
+
+  void BusIoThread::complete(IoChannel& channel, IoCompletion&& completion) {
+    while (!channel.completions_.tryPush(std::move(completion))) {
+      if (!is_running_.load(std::memory_order_relaxed)) {
+        return;
+      }
+      std::this_thread::yield();
+    }
+    channel.notify();
+    return;
+  }
+
+}
@@ -0,0 +1,95 @@
+#include "myactuator_rmd/driver/channel_driver.hpp"
+
+#include <array>
+#include <cstdint>
+#include <exception>
+#include <vector>
+
+#include "myactuator_rmd/driver/bus_io_thread.hpp"
+#include "myactuator_rmd/driver/can_address_offset.hpp"
+#include "myactuator_rmd/driver/transfer.hpp"
+#include "myactuator_rmd/protocol/message.hpp"
+#include "myactuator_rmd/exceptions.hpp"
+
+
+namespace myactuator_rmd {
+
+  ChannelDriver::ChannelDriver(BusIoThread& io_thread)
+  : Driver{}, io_thread_{io_thread}, channel_{io_thread.openChannel()} {
+    return;
+  }
+
+  void ChannelDriver::addId(std::uint32_t const actuator_id) {
+    io_thread_.addId(actuator_id);
+    return;
+  }
+
+  void ChannelDriver::send(Message const& msg, std::uint32_t const actuator_id) {
+    send(msg, actuator_id, CanAddressOffset::request);
+    return;
+  }
+
+  void ChannelDriver::send(Message const& msg, std::uint32_t const actuator_id, std::uint32_t const base_offset) {
+    Transfer const transfer {actuator_id, msg.getData(), base_offset};
+    static_cast<void>(exchange(IoRequest{transfer, 0, false}));
+    return;
+  }
+
+  std::array<std::uint8_t,8> ChannelDriver::sendRecv(Message const& request, std::uint32_t const actuator_id) {
+    return sendRecv(request, actuator_id, CanAddressOffset::request, CanAddressOffset::response);
+  }
+
+  std::array<std::uint8_t,8> ChannelDriver::sendRecv(Message const& request, std::uint32_t const actuator_id,
+                                                     std::uint32_t const request_offset, std::uint32_t const response_offset) {
+    Transfer const transfer {actuator_id, request.getData(), request_offset, response_offset};
+    return exchange(IoRequest{transfer}).response;
+  }
+
+  void ChannelDriver::sendRecv(std::vector<Transfer>& transfers) {
+    // Keeps at most the capacity of the channel in flight, the completions arrive in the order of submission
+    std::size_t num_submitted {0};
+    std::size_t num_received {0};
+    std::exception_ptr error {};
+    while (num_received < transfers.size()) {
+      while ((num_submitted < transfers.size()) && (num_submitted - num_received < IoChannel::capacity) &&
+             channel_.trySubmit(IoRequest{transfers[num_submitted], num_submitted})) {
+        ++num_submitted;
+      }
+      IoCompletion const completion {receive()};
+      auto& transfer {transfers[completion.tag]};
+      transfer.response = completion.transfer.response;
+      transfer.is_received = completion.transfer.is_received;
+      transfer.is_timed_out = completion.transfer.is_timed_out;
+      transfer.timestamp = completion.transfer.timestamp;
+      if (completion.error && !error) {
+        error = completion.error;
+      }
+      ++num_received;
+    }
+    if (error) {
+      std::rethrow_exception(error);
+    }
+    return;
+  }
+
+  IoCompletion ChannelDriver::receive() {
+    IoCompletion completion {};
+    if (!channel_.receive(completion)) {
+      throw Exception("I/O thread of the bus was stopped!");
+    }
+    return completion;
+  }
+
+  Transfer ChannelDriver::exchange(IoRequest const& request) {
+    // The channel always has room as every request is completed before the next one is submitted
+    if (!channel_.trySubmit(request)) {
+      throw Exception("Request queue of the channel is full!");
+    }
+    IoCompletion const completion {receive()};
+    if (completion.error) {
+      std::rethrow_exception(completion.error);
+    }
+    return completion.transfer;
+  }
+
+}
@@ -0,0 +1,208 @@
+#include "myactuator_rmd/driver/heartbeat_driver.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "myactuator_rmd/can/exceptions.hpp"
+#include "myactuator_rmd/driver/can_address_offset.hpp"
+#include "myactuator_rmd/driver/driver.hpp"
+#include "myactuator_rmd/driver/driver_statistics.hpp"
+#include "myactuator_rmd/driver/transfer.hpp"
+#include "myactuator_rmd/protocol/message.hpp"
+#include "myactuator_rmd/protocol/requests.hpp"
+#include "myactuator_rmd/exceptions.hpp"
+#include "myactuator_rmd/thread_affinity.hpp"
+
+
+namespace myactuator_rmd {
+
+  HeartbeatDriver::HeartbeatDriver(Driver& driver, std::chrono::microseconds const& period, int const priority)
+  : Driver{}, driver_{driver}, period_{period}, driver_mutex_{}, mutex_{}, condition_{}, last_sent_{}, heartbeats_{},
+    num_heartbeats_{0}, num_failed_heartbeats_{0}, is_running_{true}, is_started_{false}, error_{}, thread_{} {
+    if (period_.count() <= 0) {
+      throw ValueRangeException("Heartbeat period has to be positive!");
+    }
+    thread_ = std::thread(&HeartbeatDriver::run, this, priority);
+    std::unique_lock<std::mutex> lock {mutex_};
+    condition_.wait(lock, [this]() { return is_started_; });
+    if (error_) {
+      lock.unlock();
+      thread_.join();
+      std::rethrow_exception(error_);
+    }
+    return;
+  }
+
+  HeartbeatDriver::~HeartbeatDriver() {
+    {
+      std::lock_guard<std::mutex> const lock {mutex_};
+      is_running_ = false;
+    }
+    condition_.notify_all();
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+    return;
+  }
+
+  void HeartbeatDriver::addId(std::uint32_t const actuator_id) {
+    rethrowError();
+    {
+      std::lock_guard<std::mutex> const lock {driver_mutex_};
+      driver_.addId(actuator_id);
+    }
+    {
+      std::lock_guard<std::mutex> const lock {mutex_};
+      last_sent_.emplace(actuator_id, std::chrono::steady_clock::now());
+    }
+    condition_.notify_all();
+    return;
+  }
+
+  void HeartbeatDriver::send(Message const& msg, std::uint32_t const actuator_id) {
+    rethrowError();
+    std::lock_guard<std::mutex> const lock {driver_mutex_};
+    touch(actuator_id, std::chrono::steady_clock::now());
+    driver_.send(msg, actuator_id);
+    return;
+  }
+
+  void HeartbeatDriver::send(Message const& msg, std::uint32_t const actuator_id, std::uint32_t const base_offset) {
+    rethrowError();
+    std::lock_guard<std::mutex> const lock {driver_mutex_};
+    touch(actuator_id, std::chrono::steady_clock::now());
+    driver_.send(msg, actuator_id, base_offset);
+    return;
+  }
+
+  std::array<std::uint8_t,8> HeartbeatDriver::sendRecv(Message const& request, std::uint32_t const actuator_id) {
+    rethrowError();
+    std::lock_guard<std::mutex> const lock {driver_mutex_};
+    touch(actuator_id, std::chrono::steady_clock::now());
+    return driver_.sendRecv(request, actuator_id);
+  }
+
+  std::array<std::uint8_t,8> HeartbeatDriver::sendRecv(Message const& request, std::uint32_t const actuator_id,
+                                                       std::uint32_t const request_offset, std::uint32_t const response_offset) {
+    rethrowError();
+    std::lock_guard<std::mutex> const lock {driver_mutex_};
+    touch(actuator_id, std::chrono::steady_clock::now());
+    return driver_.sendRecv(request, actuator_id, request_offset, response_offset);
+  }
+
+  void HeartbeatDriver::sendRecv(std::vector<Transfer>& transfers) {
+    rethrowError();
+    std::lock_guard<std::mutex> const lock {driver_mutex_};
+    auto const now {std::chrono::steady_clock::now()};
+    for (auto const& transfer: transfers) {
+      touch(transfer.actuator_id, now);
+    }
+    driver_.sendRecv(transfers);
+    return;
+  }
+
+  DriverStatistics HeartbeatDriver::getStatistics() const {
+    std::lock_guard<std::mutex> const lock {driver_mutex_};
+    return driver_.getStatistics();
+  }
+
+  std::uint64_t HeartbeatDriver::getNumHeartbeats() const {
+    std::lock_guard<std::mutex> const lock {mutex_};
+    return num_heartbeats_;
+  }
+
+  std::uint64_t HeartbeatDriver::getNumFailedHeartbeats() const {
+    std::lock_guard<std::mutex> const lock {mutex_};
+    return num_failed_heartbeats_;
+  }
+
+  void HeartbeatDriver::rethrowError() {
+    std::exception_ptr error {};
+    {
+      std::lock_guard<std::mutex> const lock {mutex_};
+      std::swap(error, error_);
+    }
+    if (error) {
+      std::rethrow_exception(error);
+    }
+    return;
+  }
+
+  void HeartbeatDriver::touch(std::uint32_t const actuator_id, std::chrono::steady_clock::time_point const& time) {
+    std::lock_guard<std::mutex> const lock {mutex_};
+    auto it {last_sent_.find(actuator_id)};
+    if (it != last_sent_.end()) {
+      it->second = std::max(it->second, time);
+    }
+    return;
+  }
+
+  void HeartbeatDriver::run(int const priority) {
+    std::unique_lock<std::mutex> lock {mutex_};
+    if (priority > 0) {
+      try {
+        setThreadPriority(priority);
+      } catch (...) {
+        error_ = std::current_exception();
+        is_running_ = false;
+      }
+    }
+    is_started_ = true;
+    condition_.notify_all();
+    GetMotorStatus1Request const request {};
+    // An absent actuator must not keep the application from the driver for the receive timeout of the socket
+    auto const timeout {std::max(period_/4, std::chrono::microseconds(1))};
+    while (is_running_) {
+      auto const now {std::chrono::steady_clock::now()};
+      auto next_heartbeat {now + period_};
+      heartbeats_.clear();
+      for (auto const& [actuator_id, last_sent]: last_sent_) {
+        if (last_sent + period_ <= now) {
+          heartbeats_.emplace_back(actuator_id, request.getData(), CanAddressOffset::request, CanAddressOffset::response,
+                                   timeout);
+        } else {
+          next_heartbeat = std::min(next_heartbeat, last_sent + period_);
+        }
+      }
+      if (heartbeats_.empty()) {
+        condition_.wait_until(lock, next_heartbeat);
+        continue;
+      }
+      // The application thread may use the driver while the heartbeat thread waits for it
+      lock.unlock();
+      std::exception_ptr error {};
+      {
+        std::lock_guard<std::mutex> const driver_lock {driver_mutex_};
+        try {
+          driver_.sendRecv(heartbeats_);
+        } catch (can::TimeoutException const&) {
+          // Actuators that did not answer are reported by the number of failed heartbeats
+        } catch (...) {
+          error = std::current_exception();
+        }
+      }
+      lock.lock();
+      if (error) {
+        error_ = error;
+      }
+      for (auto const& heartbeat: heartbeats_) {
+        auto& last_sent {last_sent_[heartbeat.actuator_id]};
+        last_sent = std::max(last_sent, now);
+        ++num_heartbeats_;
+        if (!heartbeat.is_received) {
+          ++num_failed_heartbeats_;
+        }
+      }
+    }
+    return;
+  }
+
+}
@@ -0,0 +1,217 @@
+#include "myactuator_rmd/driver/multi_bus_driver.hpp"
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "myactuator_rmd/driver/can_driver.hpp"
+#include "myactuator_rmd/driver/driver.hpp"
+#include "myactuator_rmd/driver/driver_statistics.hpp"
+#include "myactuator_rmd/driver/transfer.hpp"
+#include "myactuator_rmd/protocol/message.hpp"
+#include "myactuator_rmd/exceptions.hpp"
+
+
+namespace myactuator_rmd {
+
+  namespace {
+
+    std::vector<std::shared_ptr<Driver>> openCanDrivers(std::vector<std::string> const& ifnames) {
+      std::vector<std::shared_ptr<Driver>> drivers {};
+      for (auto const& ifname: ifnames) {
+        drivers.emplace_back(std::make_shared<CanDriver>(ifname));
+      }
+      return drivers;
+    }
+
+  }
+
+  MultiBusDriver::Bus::Bus(std::shared_ptr<Driver> const& driver_)
+  : driver{driver_}, driver_mutex{}, transfers{}, indices{}, error{}, mutex{}, condition{},
+    is_requested{false}, is_done{false}, thread{} {
+    return;
+  }
+
+  MultiBusDriver::MultiBusDriver(std::vector<std::string> const& ifnames)
+  : MultiBusDriver{openCanDrivers(ifnames)} {
+    return;
+  }
+
+  MultiBusDriver::MultiBusDriver(std::vector<std::shared_ptr<Driver>> const& drivers)
+  : Driver{}, buses_{}, is_running_{true} {
+    if (drivers.empty()) {
+      throw Exception("Multi-bus driver requires at least a single bus!");
+    }
+    for (auto const& driver: drivers) {
+      if (!driver) {
+        throw Exception("Multi-bus driver received an invalid bus driver!");
+      }
+      buses_.emplace_back(std::make_unique<Bus>(driver));
+    }
+    for (auto& bus: buses_) {
+      bus->thread = std::thread(&MultiBusDriver::run, this, std::ref(*bus));
+    }
+    return;
+  }
+
+  MultiBusDriver::~MultiBusDriver() {
+    is_running_.store(false);
+    for (auto& bus: buses_) {
+      {
+        std::lock_guard<std::mutex> const lock {bus->mutex};
+      }
+      bus->condition.notify_all();
+      if (bus->thread.joinable()) {
+        bus->thread.join();
+      }
+    }
+    return;
+  }
+
+  std::size_t MultiBusDriver::getNumBuses() const noexcept {
+    return buses_.size();
+  }
+
+  void MultiBusDriver::addId(std::uint32_t const handle) {
+    auto& bus {getBus(handle)};
+    std::lock_guard<std::mutex> const lock {bus.driver_mutex};
+    bus.driver->addId(getActuatorId(handle));
+    return;
+  }
+
+  void MultiBusDriver::send(Message const& msg, std::uint32_t const handle) {
+    auto& bus {getBus(handle)};
+    std::lock_guard<std::mutex> const lock {bus.driver_mutex};
+    bus.driver->send(msg, getActuatorId(handle));
+    return;
+  }
+
+  void MultiBusDriver::send(Message const& msg, std::uint32_t const handle, std::uint32_t const base_offset) {
+    auto& bus {getBus(handle)};
+    std::lock_guard<std::mutex> const lock {bus.driver_mutex};
+    bus.driver->send(msg, getActuatorId(handle), base_offset);
+    return;
+  }
+
+  std::array<std::uint8_t,8> MultiBusDriver::sendRecv(Message const& request, std::uint32_t const handle) {
+    auto& bus {getBus(handle)};
+    std::lock_guard<std::mutex> const lock {bus.driver_mutex};
+    return bus.driver->sendRecv(request, getActuatorId(handle));
+  }
+
+  std::array<std::uint8_t,8> MultiBusDriver::sendRecv(Message const& request, std::uint32_t const handle,
+                                                      std::uint32_t const request_offset, std::uint32_t const response_offset) {
+    auto& bus {getBus(handle)};
+    std::lock_guard<std::mutex> const lock {bus.driver_mutex};
+    return bus.driver->sendRecv(request, getActuatorId(handle), request_offset, response_offset);
+  }
+
+  void MultiBusDriver::sendRecv(std::vector<Transfer>& transfers) {
+    for (auto& bus: buses_) {
+      bus->transfers.clear();
+      bus->indices.clear();
+    }
+    for (std::size_t i = 0; i < transfers.size(); ++i) {
+      auto& bus {getBus(transfers[i].actuator_id)};
+      bus.transfers.push_back(transfers[i]);
+      bus.transfers.back().actuator_id = getActuatorId(transfers[i].actuator_id);
+      bus.indices.push_back(i);
+    }
+    // The calling thread exchanges the first bus itself instead of waiting idle
+    Bus* local_bus {nullptr};
+    for (auto& bus: buses_) {
+      if (bus->transfers.empty()) {
+        continue;
+      } else if (local_bus == nullptr) {
+        local_bus = bus.get();
+        continue;
+      }
+      {
+        std::lock_guard<std::mutex> const lock {bus->mutex};
+        bus->is_done = false;
+        bus->is_requested = true;
+      }
+      bus->condition.notify_all();
+    }
+    if (local_bus != nullptr) {
+      exchange(*local_bus);
+    }
+    std::exception_ptr error {};
+    for (auto& bus: buses_) {
+      if (bus->transfers.empty()) {
+        continue;
+      } else if (bus.get() != local_bus) {
+        std::unique_lock<std::mutex> lock {bus->mutex};
+        bus->condition.wait(lock, [&bus]() { return bus->is_done; });
+      }
+      for (std::size_t j = 0; j < bus->transfers.size(); ++j) {
+        auto& transfer {transfers[bus->indices[j]]};
+        transfer.response = bus->transfers[j].response;
+        transfer.is_received = bus->transfers[j].is_received;
+        transfer.is_timed_out = bus->transfers[j].is_timed_out;
+        transfer.timestamp = bus->transfers[j].timestamp;
+      }
+      if (!error) {
+        error = bus->error;
+      }
+    }
+    if (error) {
+      std::rethrow_exception(error);
+    }
+    return;
+  }
+
+  DriverStatistics MultiBusDriver::getStatistics() const {
+    DriverStatistics statistics {};
+    for (auto const& bus: buses_) {
+      std::lock_guard<std::mutex> const lock {bus->driver_mutex};
+      statistics += bus->driver->getStatistics();
+    }
+    return statistics;
+  }
+
+  MultiBusDriver::Bus& MultiBusDriver::getBus(std::uint32_t const handle) {
+    if ((handle < 1) || ((handle - 1)/32 >= buses_.size())) {
+      throw Exception("Given actuator handle '" + std::to_string(handle) + "' out of admittable range [1, " +
+                      std::to_string(32*buses_.size()) + "]!");
+    }
+    return *buses_[(handle - 1)/32];
+  }
+
+  void MultiBusDriver::exchange(Bus& bus) noexcept {
+    bus.error = nullptr;
+    try {
+      std::lock_guard<std::mutex> const lock {bus.driver_mutex};
+      bus.driver->sendRecv(bus.transfers);
+    } catch (...) {
+      bus.error = std::current_exception();
+    }
+    return;
+  }
+
+  void MultiBusDriver::run(Bus& bus) {
+    std::unique_lock<std::mutex> lock {bus.mutex};
+    while (true) {
+      bus.condition.wait(lock, [this, &bus]() { return bus.is_requested || !is_running_.load(); });
+      if (!is_running_.load()) {
+        break;
+      }
+      bus.is_requested = false;
+      lock.unlock();
+      exchange(bus);
+      lock.lock();
+      bus.is_done = true;
+      bus.condition.notify_all();
+    }
+    return;
+  }
+
+}
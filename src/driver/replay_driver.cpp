@@ -0,0 +1,190 @@
+#include "myactuator_rmd/driver/replay_driver.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "myactuator_rmd/can/frame.hpp"
+#include "myactuator_rmd/driver/can_address_offset.hpp"
+#include "myactuator_rmd/protocol/message.hpp"
+#include "myactuator_rmd/exceptions.hpp"
+
+
+namespace myactuator_rmd {
+
+  std::vector<RecordedFrame> readCandumpLog(std::istream& is) {
+    std::vector<RecordedFrame> frames {};
+    std::string line {};
+    while (std::getline(is, line)) {
+      // Expected format '(<sec>.<usec>) <ifname> <id>#<data>'
+      auto const timestamp_begin {line.find('(')};
+      auto const timestamp_end {line.find(')')};
+      auto const separator {line.find('#')};
+      if ((timestamp_begin == std::string::npos) || (timestamp_end == std::string::npos) ||
+          (separator == std::string::npos) || (timestamp_end > separator)) {
+        continue;
+      }
+      // CAN FD frames use '##' and remote frames 'R' after the separator
+      if ((line.find('#', separator + 1) != std::string::npos) || (line.find('R', separator + 1) != std::string::npos)) {
+        continue;
+      }
+      std::string const timestamp {line.substr(timestamp_begin + 1, timestamp_end - timestamp_begin - 1)};
+      auto const dot {timestamp.find('.')};
+      auto const id_begin {line.rfind(' ', separator)};
+      if ((dot == std::string::npos) || (id_begin == std::string::npos)) {
+        continue;
+      }
+      try {
+        std::string usec {timestamp.substr(dot + 1)};
+        usec.resize(6, '0');
+        std::chrono::microseconds const t {std::chrono::seconds(std::stoll(timestamp.substr(0, dot))) +
+                                           std::chrono::microseconds(std::stoll(usec))};
+        std::uint32_t const can_id {static_cast<std::uint32_t>(std::stoul(line.substr(id_begin + 1, separator - id_begin - 1), nullptr, 16))};
+        std::string data_str {line.substr(separator + 1)};
+        data_str.erase(data_str.find_last_not_of(" \r\n\t") + 1);
+        if ((data_str.size() % 2) || (data_str.size() > 16)) {
+          continue;
+        }
+        std::array<std::uint8_t,8> data {};
+        for (std::size_t i = 0; i < data_str.size()/2; ++i) {
+          data[i] = static_cast<std::uint8_t>(std::stoul(data_str.substr(2*i, 2), nullptr, 16));
+        }
+        frames.emplace_back(t, can::Frame{can_id, data});
+      } catch (std::logic_error const&) {
+        continue;
+      }
+    }
+    return frames;
+  }
+
+  std::vector<RecordedFrame> readCandumpLog(std::string const& filename) {
+    std::ifstream ifs {filename};
+    if (!ifs) {
+      throw Exception("Could not open candump log '" + filename + "'");
+    }
+    return readCandumpLog(ifs);
+  }
+
+  std::vector<RecordedFrame> readBinaryLog(std::istream& is) {
+    std::vector<RecordedFrame> frames {};
+    std::array<std::uint8_t,20> record {};
+    while (is.read(reinterpret_cast<char*>(record.data()), record.size())) {
+      std::uint64_t t {0};
+      for (std::size_t i = 0; i < 8; ++i) {
+        t |= static_cast<std::uint64_t>(record[i]) << (8*i);
+      }
+      std::uint32_t can_id {0};
+      for (std::size_t i = 0; i < 4; ++i) {
+        can_id |= static_cast<std::uint32_t>(record[8 + i]) << (8*i);
+      }
+      std::array<std::uint8_t,8> data {};
+      std::memcpy(data.data(), &record[12], data.size());
+      frames.emplace_back(std::chrono::microseconds(static_cast<std::int64_t>(t)), can::Frame{can_id, data});
+    }
+    if (is.gcount() != 0) {
+      throw Exception("Binary log ends with an incomplete record");
+    }
+    return frames;
+  }
+
+  std::vector<RecordedFrame> readBinaryLog(std::string const& filename) {
+    std::ifstream ifs {filename, std::ios::binary};
+    if (!ifs) {
+      throw Exception("Could not open binary log '" + filename + "'");
+    }
+    return readBinaryLog(ifs);
+  }
+
+  void writeBinaryLog(std::ostream& os, std::vector<RecordedFrame> const& frames) {
+    std::array<std::uint8_t,20> record {};
+    for (auto const& f: frames) {
+      auto const t {static_cast<std::uint64_t>(f.timestamp.count())};
+      for (std::size_t i = 0; i < 8; ++i) {
+        record[i] = static_cast<std::uint8_t>(t >> (8*i));
+      }
+      auto const can_id {f.frame.getId()};
+      for (std::size_t i = 0; i < 4; ++i) {
+        record[8 + i] = static_cast<std::uint8_t>(can_id >> (8*i));
+      }
+      std::memcpy(&record[12], f.frame.getData().data(), 8);
+      os.write(reinterpret_cast<char const*>(record.data()), record.size());
+    }
+    return;
+  }
+
+  ReplayDriver::ReplayDriver(std::vector<RecordedFrame> const& frames, ReplayMode const mode)
+  : Driver{}, mode_{mode}, responses_{}, first_timestamp_{}, start_{}, is_started_{false} {
+    auto const isResponse = [](std::uint32_t const can_id, std::uint32_t const offset) noexcept -> bool {
+      return (can_id > offset) && (can_id <= offset + 32);
+    };
+    for (auto const& f: frames) {
+      auto const can_id {f.frame.getId()};
+      if (isResponse(can_id, CanAddressOffset::response) || isResponse(can_id, CanAddressOffset::response_motion_control)) {
+        responses_[can_id].push_back(f);
+      }
+    }
+    return;
+  }
+
+  void ReplayDriver::addId(std::uint32_t const actuator_id) {
+    if ((actuator_id < 1) || (actuator_id > 32)) {
+      throw Exception("Given actuator id '" + std::to_string(actuator_id) + "' out of admittable range [1, 32]!");
+    }
+    return;
+  }
+
+  void ReplayDriver::send(Message const& /*msg*/, std::uint32_t const /*actuator_id*/) {
+    return;
+  }
+
+  void ReplayDriver::send(Message const& /*msg*/, std::uint32_t const /*actuator_id*/, std::uint32_t const /*base_offset*/) {
+    return;
+  }
+
+  std::array<std::uint8_t,8> ReplayDriver::sendRecv(Message const& /*request*/, std::uint32_t const actuator_id) {
+    return recv(CanAddressOffset::response + actuator_id);
+  }
+
+  std::array<std::uint8_t,8> ReplayDriver::sendRecv(Message const& /*request*/, std::uint32_t const actuator_id,
+                                                    std::uint32_t const /*request_offset*/, std::uint32_t const response_offset) {
+    return recv(response_offset + actuator_id);
+  }
+
+  std::size_t ReplayDriver::getRemaining() const noexcept {
+    std::size_t remaining {0};
+    for (auto const& [can_id, frames]: responses_) {
+      remaining += frames.size();
+    }
+    return remaining;
+  }
+
+  std::array<std::uint8_t,8> ReplayDriver::recv(std::uint32_t const can_id) {
+    auto it {responses_.find(can_id)};
+    if ((it == responses_.end()) || it->second.empty()) {
+      std::ostringstream ss {};
+      ss << std::showbase << std::hex << can_id;
+      throw Exception("Recording does not contain any further responses from CAN id '" + ss.str() + "'");
+    }
+    RecordedFrame const f {it->second.front()};
+    it->second.pop_front();
+    if (mode_ == ReplayMode::ORIGINAL_TIMING) {
+      if (!is_started_) {
+        first_timestamp_ = f.timestamp;
+        start_ = std::chrono::steady_clock::now();
+        is_started_ = true;
+      }
+      std::this_thread::sleep_until(start_ + (f.timestamp - first_timestamp_));
+    }
+    return f.frame.getData();
+  }
+
+}
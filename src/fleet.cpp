@@ -0,0 +1,151 @@
+#include "myactuator_rmd/fleet.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "myactuator_rmd/actuator_state/acceleration_type.hpp"
+#include "myactuator_rmd/actuator_state/gain_type.hpp"
+#include "myactuator_rmd/actuator_state/gains.hpp"
+#include "myactuator_rmd/can/exceptions.hpp"
+#include "myactuator_rmd/driver/driver.hpp"
+#include "myactuator_rmd/driver/transfer.hpp"
+#include "myactuator_rmd/protocol/requests.hpp"
+#include "myactuator_rmd/protocol/responses.hpp"
+#include "myactuator_rmd/protocol/single_gain_request.hpp"
+#include "myactuator_rmd/protocol/single_gain_response.hpp"
+
+
+namespace myactuator_rmd {
+
+  ActuatorInfo::ActuatorInfo(std::uint32_t const actuator_id_, std::string const& motor_model_,
+                             std::uint32_t const version_date_, Gains const& gains_, std::int32_t const acceleration_)
+  : actuator_id{actuator_id_}, motor_model{motor_model_}, version_date{version_date_}, gains{gains_},
+    acceleration{acceleration_} {
+    return;
+  }
+
+  std::vector<ActuatorInfo> discoverActuators(Driver& driver, std::chrono::microseconds const& timeout,
+                                              std::vector<std::uint32_t> const& actuator_ids) {
+    std::vector<std::uint32_t> ids {actuator_ids};
+    if (ids.empty()) {
+      for (std::uint32_t id = 1; id <= 32; ++id) {
+        ids.push_back(id);
+      }
+    }
+    // Probes all ids at once, the ones that do not answer are absent
+    std::vector<Transfer> probes {};
+    probes.reserve(ids.size());
+    for (auto const& id: ids) {
+      driver.addId(id);
+      probes.emplace_back(id, GetVersionDateRequest{}.getData(), CanAddressOffset::request, CanAddressOffset::response, timeout);
+    }
+    try {
+      driver.sendRecv(probes);
+    } catch (can::TimeoutException const&) {
+      // Expected for every id that is not in use
+    }
+    std::vector<ActuatorInfo> inventory {};
+    std::vector<Transfer> reads {};
+    for (auto const& probe: probes) {
+      if (!probe.is_received) {
+        continue;
+      }
+      GetVersionDateResponse const response {probe.response};
+      inventory.emplace_back(probe.actuator_id, "", response.getVersion());
+      reads.emplace_back(probe.actuator_id, GetMotorModelRequest{}.getData(), CanAddressOffset::request,
+                         CanAddressOffset::response, timeout);
+      reads.emplace_back(probe.actuator_id, GetControllerGainsRequest{}.getData(), CanAddressOffset::request,
+                         CanAddressOffset::response, timeout);
+      reads.emplace_back(probe.actuator_id, GetAccelerationRequest{}.getData(), CanAddressOffset::request,
+                         CanAddressOffset::response, timeout);
+    }
+    if (reads.empty()) {
+      return inventory;
+    }
+    // Reads the remaining inventory of all actuators found with a single batch
+    driver.sendRecv(reads);
+    for (std::size_t i = 0; i < inventory.size(); ++i) {
+      auto& info {inventory[i]};
+      info.motor_model = GetMotorModelResponse{reads[3*i].response}.getModel();
+      info.gains = GetControllerGainsResponse{reads[3*i + 1].response}.getGains();
+      info.acceleration = GetAccelerationResponse{reads[3*i + 2].response}.getAcceleration();
+    }
+    return inventory;
+  }
+
+  std::map<std::uint32_t,std::map<GainType,float>> getAllGains(Driver& driver, std::vector<std::uint32_t> const& actuator_ids,
+                                                               std::chrono::microseconds const& timeout) {
+    std::vector<Transfer> transfers {};
+    transfers.reserve(actuator_ids.size()*gain_types.size());
+    for (auto const& id: actuator_ids) {
+      driver.addId(id);
+      for (auto const& gain_type: gain_types) {
+        transfers.emplace_back(id, GetSingleControllerGainRequest{gain_type}.getData(), CanAddressOffset::request,
+                               CanAddressOffset::response, timeout);
+      }
+    }
+    driver.sendRecv(transfers);
+    std::map<std::uint32_t,std::map<GainType,float>> gains {};
+    for (auto const& transfer: transfers) {
+      GetSingleControllerGainResponse const response {transfer.response};
+      gains[transfer.actuator_id][response.getGainType()] = response.getValue();
+    }
+    return gains;
+  }
+
+  FleetConfiguration& FleetConfiguration::setAcceleration(std::uint32_t const actuator_id, std::uint32_t const acceleration,
+                                                          AccelerationType const mode) {
+    SetAccelerationRequest const request {acceleration, mode};
+    transfers_.emplace_back(actuator_id, request.getData());
+    return *this;
+  }
+
+  FleetConfiguration& FleetConfiguration::setControllerGains(std::uint32_t const actuator_id, Gains const& gains,
+                                                             bool const is_persistent) {
+    if (is_persistent) {
+      SetControllerGainsPersistentlyRequest const request {gains};
+      transfers_.emplace_back(actuator_id, request.getData());
+    } else {
+      SetControllerGainsRequest const request {gains};
+      transfers_.emplace_back(actuator_id, request.getData());
+    }
+    return *this;
+  }
+
+  FleetConfiguration& FleetConfiguration::setAllGains(std::uint32_t const actuator_id, std::map<GainType,float> const& gains,
+                                                      bool const is_persistent) {
+    for (auto const& [gain_type, value]: gains) {
+      if (is_persistent) {
+        SetSingleControllerGainPersistentlyRequest const request {gain_type, value};
+        transfers_.emplace_back(actuator_id, request.getData());
+      } else {
+        SetSingleControllerGainRequest const request {gain_type, value};
+        transfers_.emplace_back(actuator_id, request.getData());
+      }
+    }
+    return *this;
+  }
+
+  FleetConfiguration& FleetConfiguration::setTimeout(std::uint32_t const actuator_id, std::chrono::milliseconds const& timeout) {
+    SetTimeoutRequest const request {timeout};
+    transfers_.emplace_back(actuator_id, request.getData());
+    return *this;
+  }
+
+  std::size_t FleetConfiguration::size() const noexcept {
+    return transfers_.size();
+  }
+
+  void FleetConfiguration::apply(Driver& driver, std::chrono::microseconds const& timeout) {
+    for (auto& transfer: transfers_) {
+      driver.addId(transfer.actuator_id);
+      transfer.timeout = timeout;
+    }
+    driver.sendRecv(transfers_);
+    return;
+  }
+
+}
@@ -0,0 +1,46 @@
+#include "myactuator_rmd/thread_affinity.hpp"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include <pthread.h>
+#include <sched.h>
+
+#include "myactuator_rmd/exceptions.hpp"
+
+
+namespace myactuator_rmd {
+
+  void setThreadAffinity(std::size_t const core) {
+    if (core >= CPU_SETSIZE) {
+      throw ValueRangeException("Core '" + std::to_string(core) + "' out of admittable range [0, " + std::to_string(CPU_SETSIZE - 1) + "]!");
+    }
+    ::cpu_set_t cpu_set {};
+    CPU_ZERO(&cpu_set);
+    CPU_SET(core, &cpu_set);
+    int const result {::pthread_setaffinity_np(::pthread_self(), sizeof(::cpu_set_t), &cpu_set)};
+    if (result != 0) {
+      throw Exception("Could not pin thread to core '" + std::to_string(core) + "': " + std::strerror(result));
+    }
+    return;
+  }
+
+  void setThreadPriority(int const priority) {
+    int const min_priority {::sched_get_priority_min(SCHED_FIFO)};
+    int const max_priority {::sched_get_priority_max(SCHED_FIFO)};
+    if ((priority < min_priority) || (priority > max_priority)) {
+      throw ValueRangeException("Priority '" + std::to_string(priority) + "' out of admittable range [" +
+                                std::to_string(min_priority) + ", " + std::to_string(max_priority) + "]!");
+    }
+    struct ::sched_param param {};
+    param.sched_priority = priority;
+    int const result {::pthread_setschedparam(::pthread_self(), SCHED_FIFO, &param)};
+    if (result != 0) {
+      throw Exception("Could not set thread priority to '" + std::to_string(priority) + "': " + std::strerror(result));
+    }
+    return;
+  }
+
+}
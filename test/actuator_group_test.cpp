@@ -0,0 +1,86 @@
+/**
+ * \file actuator_group_test.cpp
+ * \mainpage
+ *    Test commanding a group of actuators with a single call
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "myactuator_rmd/control/safety_limits.hpp"
+#include "myactuator_rmd/driver/replay_driver.hpp"
+#include "myactuator_rmd/actuator_group.hpp"
+#include "myactuator_rmd/exceptions.hpp"
+
+
+namespace myactuator_rmd {
+  namespace test {
+
+    TEST(ActuatorGroupTest, motionControl) {
+      std::vector<myactuator_rmd::RecordedFrame> const frames {
+        {std::chrono::microseconds(0), can::Frame{0x502, {0x02, 0x00, 0x00, 0x00, 0x0F, 0xFF, 0x00, 0x00}}},
+        {std::chrono::microseconds(0), can::Frame{0x501, {0x01, 0xFF, 0xFF, 0xFF, 0xF0, 0x00, 0x00, 0x00}}}
+      };
+      myactuator_rmd::ReplayDriver driver {frames};
+      myactuator_rmd::ActuatorGroup group {driver, {1, 2}};
+      ASSERT_EQ(group.size(), 2);
+      auto const status {group.motionControl({0.0f, 0.0f}, {0.0f, 0.0f}, {10.0f, 10.0f}, {1.0f, 1.0f}, {0.0f, 0.0f})};
+      ASSERT_EQ(status.size(), 2);
+      EXPECT_EQ(status[0].can_id, 1);
+      EXPECT_NEAR(status[0].shaft_angle, 12.5f, 1e-3f);
+      EXPECT_NEAR(status[0].shaft_speed, 45.0f, 1e-3f);
+      EXPECT_NEAR(status[0].torque, -24.0f, 1e-3f);
+      EXPECT_EQ(status[1].can_id, 2);
+      EXPECT_NEAR(status[1].shaft_angle, -12.5f, 1e-3f);
+      EXPECT_NEAR(status[1].shaft_speed, -45.0f, 1e-3f);
+      EXPECT_NEAR(status[1].torque, 24.0f, 1e-3f);
+    }
+
+    TEST(ActuatorGroupTest, safetyLimitsStopGroup) {
+      std::vector<myactuator_rmd::RecordedFrame> const frames {
+        {std::chrono::microseconds(0), can::Frame{0x501, {0x01, 0xFF, 0xFF, 0xFF, 0xF0, 0x00, 0x00, 0x00}}},
+        {std::chrono::microseconds(0), can::Frame{0x241, {0x81, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}},
+        {std::chrono::microseconds(0), can::Frame{0x241, {0x81, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}},
+        {std::chrono::microseconds(0), can::Frame{0x241, {0x9C, 0x28, 0x00, 0x00, 0x00, 0x00, 0x5A, 0x00}}}
+      };
+      myactuator_rmd::ReplayDriver driver {frames};
+      myactuator_rmd::ActuatorGroup group {driver, {1}};
+      myactuator_rmd::SafetyLimits limits {1};
+      limits.max_torque = {10.0f};
+      group.setSafetyLimits(&limits);
+      std::vector<float> const zero {0.0f};
+      std::vector<float> const t_ff {20.0f};
+      float position {};
+      float velocity {};
+      float torque {};
+      // The feedforward torque is clamped, the torque of the feedback stops the actuator within the same call
+      EXPECT_EQ(group.motionControl(zero.data(), zero.data(), zero.data(), zero.data(), t_ff.data(), &position, &velocity, &torque),
+                SafetyAction::STOP);
+      EXPECT_NEAR(torque, -24.0f, 1e-3f);
+      EXPECT_EQ(limits.getTrip(), SafetyAction::STOP);
+      EXPECT_EQ(limits.getNumViolations(), 2);
+      // While latched the command is not sent and the feedback is read from the halted actuator instead
+      EXPECT_EQ(group.motionControl(zero.data(), zero.data(), zero.data(), zero.data(), zero.data(), &position, &velocity, &torque),
+                SafetyAction::STOP);
+      EXPECT_NEAR(position, 1.5707963f, 1e-5f);
+      EXPECT_FLOAT_EQ(velocity, 0.0f);
+      EXPECT_TRUE(std::isnan(torque));
+      EXPECT_EQ(driver.getRemaining(), 0);
+      myactuator_rmd::SafetyLimits mismatching_limits {2};
+      EXPECT_THROW(group.setSafetyLimits(&mismatching_limits), myactuator_rmd::ValueRangeException);
+    }
+
+    TEST(ActuatorGroupTest, wrongNumberOfCommands) {
+      myactuator_rmd::ReplayDriver driver {{}};
+      myactuator_rmd::ActuatorGroup group {driver, {1, 2}};
+      EXPECT_THROW(static_cast<void>(group.motionControl({0.0f}, {0.0f}, {0.0f}, {0.0f}, {0.0f})), myactuator_rmd::ValueRangeException);
+    }
+
+  }
+}
@@ -0,0 +1,69 @@
+/**
+ * \file async_actuator_interface_test.cpp
+ * \mainpage
+ *    Test the non-blocking actuator interface completing requests on a dedicated thread
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#include <chrono>
+#include <exception>
+#include <future>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "myactuator_rmd/actuator_state/motor_status_2.hpp"
+#include "myactuator_rmd/driver/async_driver.hpp"
+#include "myactuator_rmd/driver/replay_driver.hpp"
+#include "myactuator_rmd/async_actuator_interface.hpp"
+#include "myactuator_rmd/exceptions.hpp"
+
+
+namespace myactuator_rmd {
+  namespace test {
+
+    TEST(AsyncActuatorInterfaceTest, completesRequestsOfSeveralActuators) {
+      std::vector<myactuator_rmd::RecordedFrame> const frames {
+        {std::chrono::microseconds(0), can::Frame{0x241, {0x9C, 0x32, 0x64, 0x00, 0xF4, 0x01, 0x2D, 0x00}}},
+        {std::chrono::microseconds(0), can::Frame{0x242, {0x92, 0x00, 0x00, 0x00, 0xA0, 0x8C, 0x00, 0x00}}}
+      };
+      myactuator_rmd::ReplayDriver driver {frames};
+      myactuator_rmd::AsyncDriver async_driver {driver};
+      myactuator_rmd::AsyncActuatorInterface actuator_1 {async_driver, 1};
+      myactuator_rmd::AsyncActuatorInterface actuator_2 {async_driver, 2};
+      std::promise<myactuator_rmd::MotorStatus2> status_promise {};
+      std::promise<float> angle_promise {};
+      actuator_1.getMotorStatus2([&status_promise](myactuator_rmd::MotorStatus2 const& status, std::exception_ptr error) {
+        error ? status_promise.set_exception(error) : status_promise.set_value(status);
+      });
+      actuator_2.getMultiTurnAngle([&angle_promise](float const angle, std::exception_ptr error) {
+        error ? angle_promise.set_exception(error) : angle_promise.set_value(angle);
+      });
+      auto const status {status_promise.get_future().get()};
+      EXPECT_EQ(status.temperature, 50);
+      EXPECT_NEAR(status.shaft_speed, 500.0f, 0.1f);
+      EXPECT_NEAR(angle_promise.get_future().get(), 360.0f, 0.1f);
+    }
+
+    TEST(AsyncActuatorInterfaceTest, reportsErrorsToCompletion) {
+      std::vector<myactuator_rmd::RecordedFrame> const frames {
+        {std::chrono::microseconds(0), can::Frame{0x241, {0x92, 0x00, 0x00, 0x00, 0xA0, 0x8C, 0x00, 0x00}}}
+      };
+      myactuator_rmd::ReplayDriver driver {frames};
+      myactuator_rmd::AsyncDriver async_driver {driver};
+      myactuator_rmd::AsyncActuatorInterface actuator {async_driver, 1};
+      std::promise<void> wrong_response {};
+      std::promise<void> missing_response {};
+      actuator.getMotorStatus2([&wrong_response](myactuator_rmd::MotorStatus2 const& /*status*/, std::exception_ptr error) {
+        error ? wrong_response.set_exception(error) : wrong_response.set_value();
+      });
+      actuator.stopMotor([&missing_response](std::exception_ptr error) {
+        error ? missing_response.set_exception(error) : missing_response.set_value();
+      });
+      EXPECT_THROW(wrong_response.get_future().get(), myactuator_rmd::ProtocolException);
+      EXPECT_THROW(missing_response.get_future().get(), myactuator_rmd::Exception);
+    }
+
+  }
+}
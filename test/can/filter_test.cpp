@@ -0,0 +1,74 @@
+/**
+ * \file filter_test.cpp
+ * \mainpage
+ *    Tests for computing receive filters covering a set of CAN ids
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <linux/can.h>
+
+#include <gtest/gtest.h>
+
+#include "myactuator_rmd/can/exceptions.hpp"
+#include "myactuator_rmd/can/filter.hpp"
+
+
+namespace myactuator_rmd {
+  namespace test {
+
+    /**\fn expectExactCover
+     * \brief
+     *    Check that exactly the given standard CAN ids pass any of the filters
+     *
+     * \param[in] filters
+     *    The receive filters
+     * \param[in] can_ids
+     *    The CAN ids that should pass
+    */
+    void expectExactCover(std::vector<myactuator_rmd::can::Filter> const& filters, std::vector<std::uint32_t> const& can_ids) {
+      for (std::uint32_t can_id = 0; can_id <= CAN_SFF_MASK; ++can_id) {
+        bool const is_accepted {std::any_of(filters.begin(), filters.end(), [can_id](auto const& f) { return f.matches(can_id); })};
+        bool const is_expected {std::find(can_ids.begin(), can_ids.end(), can_id) != can_ids.end()};
+        EXPECT_EQ(is_accepted, is_expected) << "CAN id " << can_id;
+      }
+      return;
+    }
+
+    TEST(ComputeFiltersTest, mergesNeighbouringIds) {
+      std::vector<std::uint32_t> const can_ids {0x241, 0x242, 0x243, 0x244};
+      auto const filters {myactuator_rmd::can::computeFilters(can_ids)};
+      EXPECT_EQ(filters.size(), 3);
+      expectExactCover(filters, can_ids);
+    }
+
+    TEST(ComputeFiltersTest, allActuatorResponses) {
+      std::vector<std::uint32_t> can_ids {};
+      for (std::uint32_t i = 1; i <= 32; ++i) {
+        can_ids.push_back(0x240 + i);
+        can_ids.push_back(0x500 + i);
+      }
+      auto const filters {myactuator_rmd::can::computeFilters(can_ids)};
+      EXPECT_LE(filters.size(), 12);
+      expectExactCover(filters, can_ids);
+    }
+
+    TEST(ComputeFiltersTest, rejectsExtendedAndRemoteFrames) {
+      auto const filters {myactuator_rmd::can::computeFilters({0x241})};
+      ASSERT_EQ(filters.size(), 1);
+      EXPECT_TRUE(filters[0].matches(0x241));
+      EXPECT_FALSE(filters[0].matches(0x241 | CAN_EFF_FLAG));
+      EXPECT_FALSE(filters[0].matches(0x241 | CAN_RTR_FLAG));
+      EXPECT_FALSE(filters[0].matches(0x141));
+    }
+
+    TEST(ComputeFiltersTest, invalidId) {
+      EXPECT_THROW(static_cast<void>(myactuator_rmd::can::computeFilters({0x800})), myactuator_rmd::can::Exception);
+    }
+
+  }
+}
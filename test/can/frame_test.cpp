@@ -0,0 +1,42 @@
+/**
+ * \file frame_test.cpp
+ * \mainpage
+ *    Tests for the CAN frame
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+
+#include <linux/can.h>
+
+#include "myactuator_rmd/can/frame.hpp"
+
+
+namespace myactuator_rmd {
+  namespace test {
+
+    TEST(FrameTest, constructFromSocketCanFrame) {
+      struct ::can_frame frame {};
+      frame.can_id = 0x241;
+      std::array<std::uint8_t,8> const data {0x9C, 0x32, 0x64, 0x00, 0xF4, 0x01, 0x2D, 0x00};
+      for (std::size_t i = 0; i < data.size(); ++i) {
+        frame.data[i] = data[i];
+      }
+      myactuator_rmd::can::Frame const f {frame.can_id, frame.data};
+      EXPECT_EQ(f.getId(), 0x241);
+      EXPECT_EQ(f.getData(), data);
+    }
+
+    TEST(FrameTest, constexprConstructFromBuffer) {
+      constexpr std::uint8_t buffer[8] {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+      constexpr myactuator_rmd::can::Frame frame {0x141, buffer};
+      static_assert(frame.getData()[7] == 0x08);
+      EXPECT_EQ(frame.getId(), 0x141);
+    }
+
+  }
+}
@@ -0,0 +1,110 @@
+/**
+ * \file io_uring_test.cpp
+ * \mainpage
+ *    Tests for the io_uring transport on a pair of connected sockets
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+#include <linux/can.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "myactuator_rmd/can/exceptions.hpp"
+#include "myactuator_rmd/can/io_uring.hpp"
+
+
+namespace myactuator_rmd {
+  namespace test {
+
+    /**\class IoUringTest
+     * \brief
+     *    Fixture connecting the ring to a socket that preserves frame boundaries like a CAN socket
+    */
+    class IoUringTest: public ::testing::Test {
+      protected:
+        void SetUp() override {
+          ASSERT_EQ(::socketpair(AF_UNIX, SOCK_SEQPACKET, 0, sockets_), 0);
+          try {
+            ring_ = std::make_unique<myactuator_rmd::can::IoUring>(sockets_[0], 4);
+          } catch (myactuator_rmd::can::SocketException const& e) {
+            GTEST_SKIP() << "io_uring not supported: " << e.what();
+          }
+          return;
+        }
+
+        void TearDown() override {
+          ring_.reset();
+          ::close(sockets_[0]);
+          ::close(sockets_[1]);
+          return;
+        }
+
+        static struct ::can_frame makeFrame(std::uint32_t const can_id, std::uint8_t const value) noexcept {
+          struct ::can_frame frame {};
+          frame.can_id = can_id;
+          frame.len = 8;
+          frame.data[0] = value;
+          return frame;
+        }
+
+        int sockets_[2];
+        std::unique_ptr<myactuator_rmd::can::IoUring> ring_;
+    };
+
+    TEST_F(IoUringTest, receiveMoreFramesThanBuffers) {
+      for (std::uint8_t i = 0; i < 10; ++i) {
+        auto const frame {makeFrame(0x241, i)};
+        ASSERT_EQ(::send(sockets_[1], &frame, sizeof(frame), 0), static_cast<::ssize_t>(sizeof(frame)));
+      }
+      for (std::uint8_t i = 0; i < 10; ++i) {
+        struct ::can_frame frame {};
+        auto const deadline {std::chrono::steady_clock::now() + std::chrono::seconds(1)};
+        while (!ring_->tryRead(frame)) {
+          ASSERT_LT(std::chrono::steady_clock::now(), deadline);
+          ring_->wait(std::chrono::milliseconds(100));
+        }
+        EXPECT_EQ(frame.can_id, 0x241);
+        EXPECT_EQ(frame.data[0], i);
+      }
+      struct ::can_frame frame {};
+      EXPECT_FALSE(ring_->tryRead(frame));
+    }
+
+    TEST_F(IoUringTest, batchedWrites) {
+      auto const num_syscalls {ring_->getNumSyscalls()};
+      for (std::uint8_t i = 0; i < 4; ++i) {
+        EXPECT_TRUE(ring_->tryWrite(makeFrame(0x141, i)));
+      }
+      // All write buffers are in flight until submitted and completed
+      EXPECT_FALSE(ring_->tryWrite(makeFrame(0x141, 4)));
+      ring_->submit();
+      EXPECT_EQ(ring_->getNumSyscalls(), num_syscalls + 1);
+      for (std::uint8_t i = 0; i < 4; ++i) {
+        struct ::can_frame frame {};
+        ASSERT_EQ(::recv(sockets_[1], &frame, sizeof(frame), 0), static_cast<::ssize_t>(sizeof(frame)));
+        EXPECT_EQ(frame.can_id, 0x141);
+        EXPECT_EQ(frame.data[0], i);
+      }
+      auto const deadline {std::chrono::steady_clock::now() + std::chrono::seconds(1)};
+      while (!ring_->isWritable()) {
+        ASSERT_LT(std::chrono::steady_clock::now(), deadline);
+        ring_->wait(std::chrono::milliseconds(100));
+      }
+    }
+
+    TEST_F(IoUringTest, waitTimeout) {
+      auto const start {std::chrono::steady_clock::now()};
+      ring_->wait(std::chrono::milliseconds(20));
+      EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(15));
+      EXPECT_FALSE(ring_->isReadable());
+    }
+
+  }
+}
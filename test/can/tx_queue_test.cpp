@@ -0,0 +1,59 @@
+/**
+ * \file tx_queue_test.cpp
+ * \mainpage
+ *    Tests for the priority transmit queue
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#include <gtest/gtest.h>
+
+#include "myactuator_rmd/can/exceptions.hpp"
+#include "myactuator_rmd/can/frame.hpp"
+#include "myactuator_rmd/can/tx_queue.hpp"
+
+
+namespace myactuator_rmd {
+  namespace test {
+
+    TEST(TxQueueTest, controlBeforeTelemetry) {
+      myactuator_rmd::can::TxQueue queue {};
+      EXPECT_TRUE(queue.empty());
+      EXPECT_TRUE(queue.push(can::Frame{0x141, {0x9A}}, can::TxPriority::TELEMETRY));
+      EXPECT_TRUE(queue.push(can::Frame{0x401, {0x01}}, can::TxPriority::CONTROL));
+      EXPECT_TRUE(queue.push(can::Frame{0x142, {0x9C}}, can::TxPriority::TELEMETRY));
+      EXPECT_TRUE(queue.push(can::Frame{0x402, {0x02}}, can::TxPriority::CONTROL));
+      ASSERT_EQ(queue.size(), 4);
+      for (auto const can_id: {0x401, 0x402, 0x141, 0x142}) {
+        EXPECT_EQ(queue.front().getId(), can_id);
+        queue.pop();
+      }
+      EXPECT_TRUE(queue.empty());
+      EXPECT_THROW(static_cast<void>(queue.front()), myactuator_rmd::can::Exception);
+      EXPECT_THROW(queue.pop(), myactuator_rmd::can::Exception);
+    }
+
+    TEST(TxQueueTest, peekInSendOrder) {
+      myactuator_rmd::can::TxQueue queue {};
+      EXPECT_TRUE(queue.push(can::Frame{0x141, {0x9A}}, can::TxPriority::TELEMETRY));
+      EXPECT_TRUE(queue.push(can::Frame{0x401, {0x01}}, can::TxPriority::CONTROL));
+      EXPECT_TRUE(queue.push(can::Frame{0x142, {0x9C}}, can::TxPriority::TELEMETRY));
+      EXPECT_EQ(queue.peek(0).getId(), 0x401);
+      EXPECT_EQ(queue.peek(1).getId(), 0x141);
+      EXPECT_EQ(queue.peek(2).getId(), 0x142);
+      EXPECT_THROW(static_cast<void>(queue.peek(3)), myactuator_rmd::can::Exception);
+    }
+
+    TEST(TxQueueTest, bounded) {
+      myactuator_rmd::can::TxQueue queue {2};
+      EXPECT_TRUE(queue.push(can::Frame{0x141, {}}, can::TxPriority::TELEMETRY));
+      EXPECT_TRUE(queue.push(can::Frame{0x142, {}}, can::TxPriority::TELEMETRY));
+      EXPECT_FALSE(queue.push(can::Frame{0x401, {}}, can::TxPriority::CONTROL));
+      EXPECT_EQ(queue.size(), 2);
+      queue.clear();
+      EXPECT_TRUE(queue.empty());
+      EXPECT_TRUE(queue.push(can::Frame{0x401, {}}, can::TxPriority::CONTROL));
+    }
+
+  }
+}
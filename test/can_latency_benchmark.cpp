@@ -0,0 +1,139 @@
+/**
+ * \file can_latency_benchmark.cpp
+ * \mainpage
+ *    Manual benchmark comparing the round-trip latency of blocking and busy-polling reads, e.g. on a virtual
+ *    CAN interface: A responder thread echoes every request and the round trip is measured from the client
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "myactuator_rmd/can/exceptions.hpp"
+#include "myactuator_rmd/can/frame.hpp"
+#include "myactuator_rmd/can/node.hpp"
+#include "myactuator_rmd/thread_affinity.hpp"
+
+
+/**\fn measure
+ * \brief
+ *    Measure the round-trip times between a client and a responder on the given interface
+ * 
+ * \param[in] ifname
+ *    The name of the network interface, e.g. 'vcan0'
+ * \param[in] num_samples
+ *    The number of round trips to be measured
+ * \param[in] spin_budget
+ *    The spin budget of both nodes, zero for blocking reads
+ * \param[in] core
+ *    The first of two cores the client and the responder are pinned to, negative for no pinning
+ * \return
+ *    The sorted round-trip times
+*/
+std::vector<std::chrono::nanoseconds> measure(std::string const& ifname, std::size_t const num_samples,
+                                              std::chrono::microseconds const& spin_budget, int const core) {
+  std::uint32_t const request_id {0x141};
+  std::uint32_t const response_id {0x241};
+  myactuator_rmd::can::Node client {ifname};
+  client.setRecvFilter({response_id});
+  client.setBusyPoll(spin_budget);
+  myactuator_rmd::can::Node responder {ifname};
+  responder.setRecvFilter({request_id});
+  responder.setBusyPoll(spin_budget);
+
+  std::atomic<bool> is_running {true};
+  std::thread responder_thread {[&]() {
+    if (core >= 0) {
+      myactuator_rmd::setThreadAffinity(static_cast<std::size_t>(core + 1));
+    }
+    while (is_running.load()) {
+      try {
+        auto const frame {responder.read()};
+        responder.write(response_id, frame.getData());
+      } catch (myactuator_rmd::can::SocketException const&) {
+        // Receive timeout, check if the benchmark is finished
+      }
+    }
+  }};
+  if (core >= 0) {
+    myactuator_rmd::setThreadAffinity(static_cast<std::size_t>(core));
+  }
+
+  std::vector<std::chrono::nanoseconds> samples {};
+  samples.reserve(num_samples);
+  for (std::size_t i = 0; i < num_samples; ++i) {
+    std::array<std::uint8_t,8> data {};
+    for (std::size_t j = 0; j < sizeof(i); ++j) {
+      data[j] = static_cast<std::uint8_t>(i >> (8*j));
+    }
+    auto const start {std::chrono::steady_clock::now()};
+    client.write(request_id, data);
+    auto const frame {client.read()};
+    auto const stop {std::chrono::steady_clock::now()};
+    if (frame.getData() != data) {
+      std::cerr << "Received unexpected reply" << std::endl;
+    }
+    samples.emplace_back(stop - start);
+  }
+  is_running.store(false);
+  responder_thread.join();
+  std::sort(samples.begin(), samples.end());
+  return samples;
+}
+
+/**\fn print
+ * \brief
+ *    Print the percentiles of the given sorted round-trip times
+ * 
+ * \param[in] name
+ *    The name of the receive mode
+ * \param[in] samples
+ *    The sorted round-trip times
+*/
+void print(std::string const& name, std::vector<std::chrono::nanoseconds> const& samples) {
+  auto const percentile = [&samples](double const p) -> double {
+    auto const i {static_cast<std::size_t>(p*static_cast<double>(samples.size() - 1))};
+    return std::chrono::duration<double,std::micro>(samples[i]).count();
+  };
+  std::cout << std::left << std::setw(12) << name << std::right << std::fixed << std::setprecision(1)
+            << " min " << std::setw(8) << percentile(0.0) << " us, median " << std::setw(8) << percentile(0.5)
+            << " us, p99 " << std::setw(8) << percentile(0.99) << " us, max " << std::setw(8) << percentile(1.0)
+            << " us" << std::endl;
+  return;
+}
+
+
+int main(int argc, char** argv) {
+  if ((argc < 2) || (argc > 5)) {
+    std::cout << "Usage: " << argv[0] << " <ifname> [num_samples = 10000] [spin_budget_us = 200] [core = -1]" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::string const ifname {argv[1]};
+  std::size_t const num_samples {(argc > 2) ? std::stoul(argv[2]) : 10000};
+  std::chrono::microseconds const spin_budget {(argc > 3) ? std::stol(argv[3]) : 200};
+  int const core {(argc > 4) ? std::stoi(argv[4]) : -1};
+  if (num_samples == 0) {
+    std::cerr << "Number of samples has to be positive" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  try {
+    print("blocking", measure(ifname, num_samples, std::chrono::microseconds(0), core));
+    print("busy-poll", measure(ifname, num_samples, spin_budget, core));
+  } catch (std::exception const& e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
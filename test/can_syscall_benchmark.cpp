@@ -0,0 +1,113 @@
+/**
+ * \file can_syscall_benchmark.cpp
+ * \mainpage
+ *    Manual benchmark comparing the system calls per control cycle of the read/write and the io_uring
+ *    backend, e.g. on a virtual CAN interface: A responder thread answers the requests of all actuators
+ *    and the driver exchanges a batch of transfers with all of them every cycle
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "myactuator_rmd/can/exceptions.hpp"
+#include "myactuator_rmd/can/node.hpp"
+#include "myactuator_rmd/driver/can_address_offset.hpp"
+#include "myactuator_rmd/driver/can_driver.hpp"
+#include "myactuator_rmd/driver/driver.hpp"
+#include "myactuator_rmd/driver/transfer.hpp"
+
+
+/**\fn measure
+ * \brief
+ *    Exchange batches of transfers with simulated actuators and print the system calls per cycle
+ * 
+ * \param[in] ifname
+ *    The name of the network interface, e.g. 'vcan0'
+ * \param[in] backend
+ *    The backend of the driver
+ * \param[in] num_actuators
+ *    The number of simulated actuators
+ * \param[in] num_cycles
+ *    The number of control cycles
+*/
+void measure(std::string const& ifname, myactuator_rmd::can::IoBackend const backend, std::uint32_t const num_actuators,
+             std::size_t const num_cycles) {
+  myactuator_rmd::can::Node responder {ifname};
+  std::vector<std::uint32_t> request_ids {};
+  for (std::uint32_t i = 1; i <= num_actuators; ++i) {
+    request_ids.push_back(myactuator_rmd::CanAddressOffset::request + i);
+  }
+  responder.setRecvFilter(request_ids);
+  std::atomic<bool> is_running {true};
+  std::thread responder_thread {[&]() {
+    while (is_running.load()) {
+      try {
+        auto const frame {responder.read()};
+        responder.write(frame.getId() - myactuator_rmd::CanAddressOffset::request + myactuator_rmd::CanAddressOffset::response,
+                        frame.getData());
+      } catch (myactuator_rmd::can::SocketException const&) {
+        // Receive timeout, check if the benchmark is finished
+      }
+    }
+  }};
+
+  myactuator_rmd::CanDriver can_driver {ifname};
+  auto const used_backend {can_driver.setIoBackend(backend)};
+  myactuator_rmd::Driver& driver {can_driver};
+  std::vector<myactuator_rmd::Transfer> transfers {};
+  for (std::uint32_t i = 1; i <= num_actuators; ++i) {
+    driver.addId(i);
+    transfers.emplace_back(i, std::array<std::uint8_t,8>{0x92});
+  }
+  auto const statistics_before {driver.getStatistics()};
+  auto const start {std::chrono::steady_clock::now()};
+  for (std::size_t i = 0; i < num_cycles; ++i) {
+    driver.sendRecv(transfers);
+  }
+  auto const stop {std::chrono::steady_clock::now()};
+  auto const statistics_after {driver.getStatistics()};
+  is_running.store(false);
+  responder_thread.join();
+
+  double const num_syscalls {static_cast<double>(statistics_after.num_syscalls - statistics_before.num_syscalls)};
+  double const cycle_time {std::chrono::duration<double,std::micro>(stop - start).count()};
+  std::cout << std::left << std::setw(12) << ((used_backend == myactuator_rmd::can::IoBackend::IO_URING) ? "io_uring" : "read/write")
+            << std::right << std::fixed << std::setprecision(2) << std::setw(8) << num_syscalls/static_cast<double>(num_cycles)
+            << " syscalls/cycle, " << std::setw(8) << cycle_time/static_cast<double>(num_cycles) << " us/cycle" << std::endl;
+  return;
+}
+
+
+int main(int argc, char** argv) {
+  if ((argc < 2) || (argc > 4)) {
+    std::cout << "Usage: " << argv[0] << " <ifname> [num_actuators = 8] [num_cycles = 10000]" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::string const ifname {argv[1]};
+  std::uint32_t const num_actuators {(argc > 2) ? static_cast<std::uint32_t>(std::stoul(argv[2])) : 8};
+  std::size_t const num_cycles {(argc > 3) ? std::stoul(argv[3]) : 10000};
+  if ((num_actuators < 1) || (num_actuators > 32) || (num_cycles == 0)) {
+    std::cerr << "Number of actuators has to be in [1, 32] and number of cycles positive" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  try {
+    measure(ifname, myactuator_rmd::can::IoBackend::READ_WRITE, num_actuators, num_cycles);
+    measure(ifname, myactuator_rmd::can::IoBackend::IO_URING, num_actuators, num_cycles);
+  } catch (std::exception const& e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,172 @@
+/**
+ * \file capture_test.cpp
+ * \mainpage
+ *    Test capturing the raw replies of an excited actuator and decoding them afterwards
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "myactuator_rmd/control/capture.hpp"
+#include "myactuator_rmd/driver/replay_driver.hpp"
+#include "myactuator_rmd/protocol/command_type.hpp"
+#include "myactuator_rmd/protocol/message.hpp"
+#include "myactuator_rmd/exceptions.hpp"
+#include "../mock/simulated_driver.hpp"
+
+
+namespace myactuator_rmd {
+  namespace test {
+
+    /**\class SetpointEchoDriver
+     * \brief
+     *    Driver simulating an actuator that follows its velocity set-point instantly and counts the replies
+     *    to set-points in its shaft angle
+    */
+    class SetpointEchoDriver: public SimulatedDriver {
+      public:
+        SetpointEchoDriver()
+        : num_replies_{} {
+          return;
+        }
+
+      protected:
+        std::array<std::uint8_t,8> respond(std::array<std::uint8_t,8> const& data, std::uint32_t const /*actuator_id*/) override {
+          if (data[0] == CommandType::STOP_MOTOR) {
+            return data;
+          }
+          std::int32_t setpoint {};
+          std::memcpy(&setpoint, &data[4], sizeof(std::int32_t));
+          auto const speed {static_cast<std::int16_t>(setpoint/100)};
+          auto const angle {static_cast<std::int16_t>(++num_replies_)};
+          std::array<std::uint8_t,8> response {data[0], 30};
+          std::memcpy(&response[4], &speed, sizeof(std::int16_t));
+          std::memcpy(&response[6], &angle, sizeof(std::int16_t));
+          return response;
+        }
+
+        std::uint16_t num_replies_;
+    };
+
+    /**\class FailingDriver
+     * \brief
+     *    Driver simulating an actuator that stops replying properly after a given number of set-points and counts
+     *    the stop requests it receives
+    */
+    class FailingDriver: public SimulatedDriver {
+      public:
+        FailingDriver(std::size_t const num_setpoints)
+        : num_stops{}, num_setpoints_{num_setpoints} {
+          return;
+        }
+
+        std::size_t num_stops;
+
+      protected:
+        std::array<std::uint8_t,8> respond(std::array<std::uint8_t,8> const& data, std::uint32_t const /*actuator_id*/) override {
+          if (data[0] == CommandType::STOP_MOTOR) {
+            ++num_stops;
+          } else if (num_setpoints_-- == 0) {
+            throw myactuator_rmd::ProtocolException("Unexpected reply!");
+          }
+          return data;
+        }
+
+        std::size_t num_setpoints_;
+    };
+
+    TEST(CaptureTest, excitation) {
+      SetpointEchoDriver driver {};
+      myactuator_rmd::Capture capture {driver, 1, 16};
+      capture.offset = 1.0f;
+      capture.amplitude = 2.0f;
+      capture.frequency = 1.0f;
+      EXPECT_NEAR(capture.getSetpoint(std::chrono::milliseconds(250), std::chrono::seconds(1)), 3.0f, 1e-5f);
+      capture.signal = ExcitationSignal::SQUARE;
+      EXPECT_FLOAT_EQ(capture.getSetpoint(std::chrono::milliseconds(600), std::chrono::seconds(1)), -1.0f);
+      // Sweeping from 1 Hz to 3 Hz the phase after one second equals that of a constant 2 Hz
+      capture.signal = ExcitationSignal::CHIRP;
+      capture.end_frequency = 3.0f;
+      EXPECT_NEAR(capture.getSetpoint(std::chrono::milliseconds(1000), std::chrono::seconds(1)), 1.0f, 1e-4f);
+    }
+
+    TEST(CaptureTest, ringBufferKeepsLatestSamples) {
+      SetpointEchoDriver driver {};
+      myactuator_rmd::Capture capture {driver, 1, 8};
+      capture.mode = CaptureMode::VELOCITY;
+      capture.signal = ExcitationSignal::SQUARE;
+      capture.amplitude = 100.0f;
+      capture.frequency = 50.0f;
+      // Captures are repeated until the buffer overflowed so that the test does not depend on the scheduling
+      std::size_t num_samples {0};
+      while (num_samples <= 8) {
+        num_samples += capture.run(std::chrono::milliseconds(5), std::chrono::milliseconds(1));
+      }
+      EXPECT_EQ(capture.size(), 8);
+      EXPECT_EQ(capture.getNumOverwritten(), num_samples - 8);
+      EXPECT_EQ(capture.getNumTimeouts(), 0);
+      auto const data {capture.decode()};
+      ASSERT_EQ(data.time.size(), 8);
+      EXPECT_DOUBLE_EQ(data.time[0], 0.0);
+      for (std::size_t i = 0; i < data.time.size(); ++i) {
+        EXPECT_FLOAT_EQ(data.velocity[i], data.setpoint[i]);
+        EXPECT_FLOAT_EQ(data.temperature[i], 30.0f);
+        // Only the latest samples are kept
+        EXPECT_FLOAT_EQ(data.position[i], static_cast<float>(num_samples - 8 + i + 1));
+        if (i > 0) {
+          EXPECT_GE(data.time[i], data.time[i - 1]);
+        }
+      }
+      capture.clear();
+      EXPECT_EQ(capture.size(), 0);
+    }
+
+    TEST(CaptureTest, export) {
+      SetpointEchoDriver driver {};
+      myactuator_rmd::Capture capture {driver, 2, 4};
+      capture.mode = CaptureMode::VELOCITY;
+      capture.offset = 10.0f;
+      while (capture.size() < 4) {
+        static_cast<void>(capture.run(std::chrono::milliseconds(5), std::chrono::milliseconds(1)));
+      }
+      ASSERT_EQ(capture.size(), 4);
+      std::stringstream csv {};
+      capture.writeCsv(csv);
+      std::string line {};
+      std::getline(csv, line);
+      EXPECT_EQ(line, "time,setpoint,temperature,current,velocity,position");
+      std::getline(csv, line);
+      EXPECT_EQ(line.substr(0, 5), "0,10,");
+      std::stringstream binary {};
+      capture.writeBinary(binary);
+      auto const frames {myactuator_rmd::readBinaryLog(binary)};
+      ASSERT_EQ(frames.size(), 8);
+      EXPECT_EQ(frames[0].frame.getId(), 0x142);
+      EXPECT_EQ(frames[1].frame.getId(), 0x242);
+      EXPECT_LE(frames[0].timestamp, frames[1].timestamp);
+    }
+
+
+    TEST(CaptureTest, stopActuatorOnEveryExit) {
+      FailingDriver driver {100};
+      myactuator_rmd::Capture capture {driver, 1, 16};
+      capture.mode = CaptureMode::VELOCITY;
+      capture.amplitude = 100.0f;
+      static_cast<void>(capture.run(std::chrono::milliseconds(5), std::chrono::milliseconds(1)));
+      EXPECT_EQ(driver.num_stops, 1);
+      // The actuator is also stopped if a reply aborts the capture
+      EXPECT_THROW(static_cast<void>(capture.run(std::chrono::seconds(10))), myactuator_rmd::ProtocolException);
+      EXPECT_EQ(driver.num_stops, 2);
+    }
+
+  }
+}
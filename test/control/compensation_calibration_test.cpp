@@ -0,0 +1,211 @@
+/**
+ * \file compensation_calibration_test.cpp
+ * \mainpage
+ *    Test calibrating the cogging and friction compensation of a simulated actuator
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "myactuator_rmd/control/compensation.hpp"
+#include "myactuator_rmd/control/compensation_calibration.hpp"
+#include "myactuator_rmd/protocol/command_type.hpp"
+#include "myactuator_rmd/protocol/message.hpp"
+#include "myactuator_rmd/actuator_interface.hpp"
+#include "myactuator_rmd/exceptions.hpp"
+#include "../mock/simulated_driver.hpp"
+
+
+namespace myactuator_rmd {
+  namespace test {
+
+    constexpr double simulated_pi {3.141592653589793};
+
+    /**\class CoggingDriver
+     * \brief
+     *    Driver simulating an actuator with a reducer that follows its velocity set-points exactly, advanced by
+     *    a millisecond with every set-point. Its current is made up of Coulomb and viscous friction, a cogging
+     *    torque with six periods per revolution of the encoder and a constant load.
+    */
+    class CoggingDriver: public SimulatedDriver {
+      public:
+        static constexpr double reducer_ratio {6.0};
+        static constexpr double encoder_range {16384.0};
+        static constexpr double coulomb {0.3};
+        static constexpr double viscous {0.001};
+        static constexpr double cogging {0.2};
+        static constexpr double load {0.1};
+
+        CoggingDriver()
+        : angle_{} {
+          return;
+        }
+
+        static double getCoggingTorque(double const encoder_position) noexcept {
+          return cogging*std::sin(6.0*2.0*simulated_pi*encoder_position/encoder_range);
+        }
+
+      protected:
+        std::array<std::uint8_t,8> respond(std::array<std::uint8_t,8> const& request, std::uint32_t const /*actuator_id*/) override {
+          auto response {request};
+          auto const encoder_position {getEncoderPosition()};
+          if (response[0] == CommandType::SPEED_CLOSED_LOOP_CONTROL) {
+            std::int32_t setpoint {};
+            std::memcpy(&setpoint, &response[4], sizeof(std::int32_t));
+            double const speed {static_cast<double>(setpoint)/100.0};
+            angle_ += speed*0.001;
+            double torque {load + getCoggingTorque(encoder_position) + viscous*speed};
+            if (speed != 0.0) {
+              torque += std::copysign(coulomb, speed);
+            }
+            // Torque constant of one Newton metre per Ampere
+            auto const current {static_cast<std::int16_t>(std::lround(torque/0.01))};
+            auto const shaft_speed {static_cast<std::int16_t>(speed)};
+            response.fill(0);
+            response[0] = static_cast<std::uint8_t>(CommandType::SPEED_CLOSED_LOOP_CONTROL);
+            std::memcpy(&response[2], &current, sizeof(std::int16_t));
+            std::memcpy(&response[4], &shaft_speed, sizeof(std::int16_t));
+          } else if (response[0] == CommandType::READ_SINGLE_TURN_ENCODER) {
+            auto const position {static_cast<std::int16_t>(encoder_position)};
+            std::memcpy(&response[2], &position, sizeof(std::int16_t));
+          } else if (response[0] == CommandType::READ_MULTI_TURN_ANGLE) {
+            auto const angle {static_cast<std::int32_t>(std::lround(angle_*100.0))};
+            std::memcpy(&response[4], &angle, sizeof(std::int32_t));
+          }
+          return response;
+        }
+
+        double getEncoderPosition() const noexcept {
+          double const position {angle_*reducer_ratio*encoder_range/360.0};
+          return position - encoder_range*std::floor(position/encoder_range);
+        }
+
+        double angle_;
+    };
+
+    /**\class AbortingCoggingDriver
+     * \brief
+     *    Simulated actuator that stops replying properly after a given number of non-zero velocity set-points
+     *    and records the last velocity set-point
+    */
+    class AbortingCoggingDriver: public CoggingDriver {
+      public:
+        AbortingCoggingDriver(std::size_t const num_setpoints)
+        : last_setpoint{}, num_setpoints_{num_setpoints} {
+          return;
+        }
+
+        std::int32_t last_setpoint;
+
+      protected:
+        std::array<std::uint8_t,8> respond(std::array<std::uint8_t,8> const& request, std::uint32_t const actuator_id) override {
+          if (request[0] == CommandType::SPEED_CLOSED_LOOP_CONTROL) {
+            std::memcpy(&last_setpoint, &request[4], sizeof(std::int32_t));
+            if ((last_setpoint != 0) && (num_setpoints_ == 0)) {
+              throw myactuator_rmd::ProtocolException("Unexpected reply!");
+            } else if (last_setpoint != 0) {
+              --num_setpoints_;
+            }
+          }
+          return CoggingDriver::respond(request, actuator_id);
+        }
+
+        std::size_t num_setpoints_;
+    };
+
+    /**\class LoadedCoggingDriver
+     * \brief
+     *    Simulated actuator with an additional constant load of a Newton metre, e.g. gravity
+    */
+    class LoadedCoggingDriver: public CoggingDriver {
+      public:
+        static constexpr double extra_load {1.0};
+
+      protected:
+        std::array<std::uint8_t,8> respond(std::array<std::uint8_t,8> const& request, std::uint32_t const actuator_id) override {
+          auto response {CoggingDriver::respond(request, actuator_id)};
+          if (response[0] == CommandType::SPEED_CLOSED_LOOP_CONTROL) {
+            std::int16_t current {};
+            std::memcpy(&current, &response[2], sizeof(std::int16_t));
+            current = static_cast<std::int16_t>(current + std::lround(extra_load/0.01));
+            std::memcpy(&response[2], &current, sizeof(std::int16_t));
+          }
+          return response;
+        }
+    };
+
+    TEST(CompensationCalibrationTest, calibrateFriction) {
+      CoggingDriver driver {};
+      myactuator_rmd::ActuatorInterface actuator {driver, 1};
+      myactuator_rmd::CompensationCalibration calibration {actuator, 1.0f, std::chrono::microseconds(10)};
+      calibration.num_settling_samples = 10;
+      myactuator_rmd::Compensation compensation {static_cast<std::uint32_t>(CoggingDriver::encoder_range)};
+      auto const model {calibration.calibrateFriction(compensation, {60.0f, 180.0f, 360.0f}, 360)};
+      EXPECT_NEAR(model.coulomb, CoggingDriver::coulomb, 0.02);
+      EXPECT_NEAR(model.viscous, CoggingDriver::viscous, 1e-4);
+      EXPECT_NEAR(compensation.getFrictionTorque(100.0f), 0.4f, 0.03f);
+      EXPECT_THROW(static_cast<void>(calibration.calibrateFriction(compensation, {60.0f, -60.0f}, 10)),
+                   myactuator_rmd::ValueRangeException);
+    }
+
+    TEST(CompensationCalibrationTest, calibrateCogging) {
+      CoggingDriver driver {};
+      myactuator_rmd::ActuatorInterface actuator {driver, 1};
+      myactuator_rmd::CompensationCalibration calibration {actuator, 1.0f, std::chrono::milliseconds(1)};
+      calibration.num_settling_samples = 10;
+      myactuator_rmd::Compensation compensation {static_cast<std::uint32_t>(CoggingDriver::encoder_range)};
+      // A revolution of the encoder takes 200 set-points and is split into 48 entries
+      auto const table {calibration.calibrateCogging(compensation, 300.0f, CoggingDriver::reducer_ratio, 48)};
+      ASSERT_EQ(table.size(), 48);
+      for (std::size_t b = 0; b < table.size(); ++b) {
+        double const position {b*CoggingDriver::encoder_range/table.size()};
+        EXPECT_NEAR(table[b], CoggingDriver::getCoggingTorque(position), 0.04);
+      }
+      // The encoder reference relates the output shaft angle back to the simulated encoder
+      for (float const angle: {1.0f, 17.5f, -42.0f}) {
+        double const position {std::fmod(angle*CoggingDriver::reducer_ratio*CoggingDriver::encoder_range/360.0 +
+                                         10.0*CoggingDriver::encoder_range, CoggingDriver::encoder_range)};
+        EXPECT_NEAR(compensation.getCoggingTorque(compensation.getEncoderPosition(angle)),
+                    CoggingDriver::getCoggingTorque(position), 0.04);
+      }
+    }
+
+    TEST(CompensationCalibrationTest, interpolateEmptyCoggingBins) {
+      LoadedCoggingDriver driver {};
+      myactuator_rmd::ActuatorInterface actuator {driver, 1};
+      myactuator_rmd::CompensationCalibration calibration {actuator, 1.0f, std::chrono::milliseconds(1)};
+      calibration.num_settling_samples = 10;
+      myactuator_rmd::Compensation compensation {static_cast<std::uint32_t>(CoggingDriver::encoder_range)};
+      // With around 200 samples per revolution of the encoder many of the 480 entries remain empty
+      auto const table {calibration.calibrateCogging(compensation, 300.0f, CoggingDriver::reducer_ratio, 480)};
+      ASSERT_EQ(table.size(), 480);
+      for (std::size_t b = 0; b < table.size(); ++b) {
+        double const position {b*CoggingDriver::encoder_range/table.size()};
+        EXPECT_NEAR(table[b], CoggingDriver::getCoggingTorque(position), 0.04);
+      }
+    }
+
+    TEST(CompensationCalibrationTest, haltOnAbort) {
+      AbortingCoggingDriver driver {20};
+      myactuator_rmd::ActuatorInterface actuator {driver, 1};
+      myactuator_rmd::CompensationCalibration calibration {actuator, 1.0f, std::chrono::microseconds(10)};
+      calibration.num_settling_samples = 10;
+      myactuator_rmd::Compensation compensation {static_cast<std::uint32_t>(CoggingDriver::encoder_range)};
+      EXPECT_THROW(static_cast<void>(calibration.calibrateFriction(compensation, {60.0f, 180.0f}, 100)),
+                   myactuator_rmd::ProtocolException);
+      EXPECT_EQ(driver.last_setpoint, 0);
+      EXPECT_THROW(static_cast<void>(calibration.calibrateCogging(compensation, 300.0f, CoggingDriver::reducer_ratio)),
+                   myactuator_rmd::ProtocolException);
+      EXPECT_EQ(driver.last_setpoint, 0);
+    }
+
+  }
+}
@@ -0,0 +1,131 @@
+/**
+ * \file compensation_test.cpp
+ * \mainpage
+ *    Test the lookup of cogging and friction torques and their application to torque set-points
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "myactuator_rmd/actuator_state/motion_control_status.hpp"
+#include "myactuator_rmd/control/compensation.hpp"
+#include "myactuator_rmd/control/controller.hpp"
+#include "myactuator_rmd/protocol/command_type.hpp"
+#include "myactuator_rmd/protocol/message.hpp"
+#include "myactuator_rmd/actuator_interface.hpp"
+#include "myactuator_rmd/exceptions.hpp"
+#include "../mock/simulated_driver.hpp"
+
+
+namespace myactuator_rmd {
+  namespace test {
+
+    /**\class TorqueRecordingDriver
+     * \brief
+     *    Driver recording the current set-points and replying with a constant velocity and encoder position
+    */
+    class TorqueRecordingDriver: public SimulatedDriver {
+      public:
+        TorqueRecordingDriver(std::int16_t const speed, std::int16_t const encoder_position)
+        : currents{}, speed_{speed}, encoder_position_{encoder_position} {
+          return;
+        }
+
+        std::vector<float> currents;
+
+      protected:
+        std::array<std::uint8_t,8> respond(std::array<std::uint8_t,8> const& request, std::uint32_t const /*actuator_id*/) override {
+          auto response {request};
+          if (response[0] == CommandType::TORQUE_CLOSED_LOOP_CONTROL) {
+            std::int16_t current {};
+            std::memcpy(&current, &response[4], sizeof(std::int16_t));
+            currents.push_back(static_cast<float>(current)*0.01f);
+            std::memcpy(&response[4], &speed_, sizeof(std::int16_t));
+          } else if (response[0] == CommandType::READ_SINGLE_TURN_ENCODER) {
+            std::memcpy(&response[2], &encoder_position_, sizeof(std::int16_t));
+          }
+          return response;
+        }
+
+        std::int16_t speed_;
+        std::int16_t encoder_position_;
+    };
+
+    TEST(CompensationTest, interpolateCoggingTable) {
+      myactuator_rmd::Compensation compensation {400};
+      compensation.setCoggingTable({0.0f, 1.0f, 0.0f, -1.0f});
+      EXPECT_EQ(compensation.getCoggingTable().size(), 4);
+      EXPECT_NEAR(compensation.getCoggingTorque(100.0f), 1.0f, 1e-5f);
+      EXPECT_NEAR(compensation.getCoggingTorque(50.0f), 0.5f, 1e-5f);
+      EXPECT_NEAR(compensation.getCoggingTorque(350.0f), -0.5f, 1e-5f);
+      // Positions beyond a single revolution wrap around
+      EXPECT_NEAR(compensation.getCoggingTorque(450.0f), 0.5f, 1e-5f);
+      EXPECT_NEAR(compensation.getCoggingTorque(-50.0f), -0.5f, 1e-5f);
+      EXPECT_THROW(compensation.setCoggingTable({}), myactuator_rmd::ValueRangeException);
+    }
+
+    TEST(CompensationTest, interpolateFrictionTable) {
+      myactuator_rmd::Compensation compensation {65536, 720.0f, 1441};
+      EXPECT_FLOAT_EQ(compensation.getFrictionTorque(100.0f), 0.0f);
+      myactuator_rmd::FrictionModel const model {0.3f, 0.5f, 10.0f, 0.001f};
+      compensation.setFrictionModel(model);
+      EXPECT_NEAR(compensation.getFrictionTorque(100.0f), model.getTorque(100.0f), 1e-4f);
+      EXPECT_NEAR(compensation.getFrictionTorque(-5.5f), model.getTorque(-5.5f), 5e-3f);
+      EXPECT_NEAR(compensation.getFrictionTorque(0.0f), 0.0f, 1e-5f);
+      EXPECT_NEAR(compensation.getFrictionTorque(1000.0f), model.getTorque(1000.0f), 1e-4f);
+      EXPECT_NEAR(compensation.getFrictionTorque(-1000.0f), -model.getTorque(1000.0f), 1e-4f);
+      EXPECT_THROW((myactuator_rmd::Compensation{65536, 0.0f}), myactuator_rmd::ValueRangeException);
+    }
+
+    TEST(CompensationTest, estimateEncoderPosition) {
+      myactuator_rmd::Compensation compensation {16384};
+      compensation.setEncoderReference(1000, 10.0f, 6.0f);
+      EXPECT_NEAR(compensation.getEncoderPosition(10.0f), 1000.0f, 1e-2f);
+      EXPECT_NEAR(compensation.getEncoderPosition(40.0f), 9192.0f, 1e-2f);
+      EXPECT_NEAR(compensation.getEncoderPosition(70.0f), 1000.0f, 1e-2f);
+      EXPECT_NEAR(compensation.getEncoderPosition(10.0f - 360.0f*100.0f), 1000.0f, 1e-1f);
+    }
+
+    TEST(CompensationTest, compensateTorqueSetpoint) {
+      TorqueRecordingDriver driver {100, 100};
+      myactuator_rmd::ActuatorInterface actuator {driver, 1};
+      myactuator_rmd::Compensation compensation {400};
+      compensation.setCoggingTable({0.0f, 1.0f, 0.0f, -1.0f});
+      compensation.setFrictionModel(myactuator_rmd::FrictionModel{0.2f, 0.2f, 1.0f, 0.001f});
+      static_cast<void>(actuator.sendTorqueSetpoint(1.0f, 2.0f));
+      actuator.setCompensation(&compensation);
+      // Before the first reply the actuator is assumed to rest at encoder position zero
+      EXPECT_FLOAT_EQ(actuator.sendTorqueSetpoint(1.0f, 2.0f).shaft_speed, 100.0f);
+      static_cast<void>(actuator.sendTorqueSetpoint(1.0f, 2.0f));
+      actuator.setCompensation(nullptr);
+      static_cast<void>(actuator.sendTorqueSetpoint(1.0f, 2.0f));
+      ASSERT_EQ(driver.currents.size(), 4);
+      EXPECT_NEAR(driver.currents[0], 0.5f, 0.011f);
+      EXPECT_NEAR(driver.currents[1], 0.5f, 0.011f);
+      EXPECT_NEAR(driver.currents[2], (1.0f + 1.0f + 0.3f)/2.0f, 0.011f);
+      EXPECT_NEAR(driver.currents[3], 0.5f, 0.011f);
+    }
+
+    TEST(CompensationTest, compensateFeedforwardTorque) {
+      myactuator_rmd::Compensation compensation {360};
+      compensation.setCoggingTable({0.0f, 1.0f, 0.0f, -1.0f});
+      compensation.setFrictionModel(myactuator_rmd::FrictionModel{0.2f, 0.2f, 1.0f, 0.0f});
+      compensation.setEncoderReference(0, 0.0f, 1.0f);
+      myactuator_rmd::CompensationController controller {{compensation, myactuator_rmd::Compensation{}}};
+      std::vector<MotionControlStatus> const status {MotionControlStatus{1, 1.5707963f, 0.0f, 0.0f},
+                                                     MotionControlStatus{2, 1.0f, 0.0f, 0.0f}};
+      std::vector<MotionControlCommand> command {MotionControlCommand{0.0f, -1.0f, 0.0f, 0.0f, 0.5f},
+                                                 MotionControlCommand{0.0f, 1.0f, 0.0f, 0.0f, 0.5f}};
+      controller.update(status, command);
+      EXPECT_NEAR(command[0].t_ff, 0.5f + 1.0f - 0.2f, 1e-4f);
+      EXPECT_FLOAT_EQ(command[1].t_ff, 0.5f);
+    }
+
+  }
+}
@@ -0,0 +1,92 @@
+/**
+ * \file gain_tuner_test.cpp
+ * \mainpage
+ *    Test tuning a single controller gain of a simulated actuator
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+#include <gtest/gtest.h>
+
+#include "myactuator_rmd/actuator_state/gain_type.hpp"
+#include "myactuator_rmd/control/gain_tuner.hpp"
+#include "myactuator_rmd/protocol/command_type.hpp"
+#include "myactuator_rmd/protocol/message.hpp"
+#include "myactuator_rmd/actuator_interface.hpp"
+#include "myactuator_rmd/exceptions.hpp"
+#include "../mock/simulated_driver.hpp"
+
+
+namespace myactuator_rmd {
+  namespace test {
+
+    /**\class SpeedLoopDriver
+     * \brief
+     *    Driver simulating the speed loop of an actuator as a discrete second-order system whose damping
+     *    decreases with its proportional gain, advanced by one step with every velocity set-point
+    */
+    class SpeedLoopDriver: public SimulatedDriver {
+      public:
+        SpeedLoopDriver()
+        : gain_{}, speed_{}, acceleration_{} {
+          return;
+        }
+
+      protected:
+        std::array<std::uint8_t,8> respond(std::array<std::uint8_t,8> const& request, std::uint32_t const /*actuator_id*/) override {
+          auto response {request};
+          if (response[0] == CommandType::WRITE_PID_PARAMETERS_TO_RAM) {
+            std::memcpy(&gain_, &response[4], sizeof(float));
+          } else if (response[0] == CommandType::SPEED_CLOSED_LOOP_CONTROL) {
+            std::int32_t setpoint {};
+            std::memcpy(&setpoint, &response[4], sizeof(std::int32_t));
+            acceleration_ = 0.5f*acceleration_ + gain_*(static_cast<float>(setpoint)/100.0f - speed_);
+            speed_ += acceleration_;
+            auto const speed {static_cast<std::int16_t>(speed_)};
+            response.fill(0);
+            response[0] = static_cast<std::uint8_t>(CommandType::SPEED_CLOSED_LOOP_CONTROL);
+            std::memcpy(&response[4], &speed, sizeof(std::int16_t));
+          }
+          return response;
+        }
+
+        float gain_;
+        float speed_;
+        float acceleration_;
+    };
+
+    TEST(GainTunerTest, tuneSpeedLoop) {
+      SpeedLoopDriver driver {};
+      myactuator_rmd::ActuatorInterface actuator {driver, 1};
+      myactuator_rmd::GainTuner tuner {actuator, ExcitationType::VELOCITY_STEP, 1000.0f, std::chrono::microseconds(50), 60};
+      float const cost_low {tuner.evaluate(GainType::SPEED_LOOP_KP, 0.02f)};
+      EXPECT_GT(tuner.runStep().getRiseTime(), 0.001f);
+      float const cost_high {tuner.evaluate(GainType::SPEED_LOOP_KP, 1.0f)};
+      EXPECT_GT(tuner.runStep().getOvershoot(), 0.1f);
+      EXPECT_EQ(tuner.getNumExperiments(), 4);
+      float const gain {tuner.tune(GainType::SPEED_LOOP_KP, 0.02f, 1.0f, 10)};
+      EXPECT_EQ(tuner.getNumExperiments(), 14);
+      EXPECT_GT(gain, 0.02f);
+      EXPECT_LT(gain, 1.0f);
+      float const cost {tuner.getCost(tuner.runStep())};
+      EXPECT_LT(cost, cost_low);
+      EXPECT_LT(cost, cost_high);
+    }
+
+    TEST(GainTunerTest, invalidRange) {
+      SpeedLoopDriver driver {};
+      myactuator_rmd::ActuatorInterface actuator {driver, 1};
+      myactuator_rmd::GainTuner tuner {actuator, ExcitationType::VELOCITY_STEP, 100.0f, std::chrono::microseconds(50), 10};
+      EXPECT_THROW(static_cast<void>(tuner.tune(GainType::SPEED_LOOP_KP, 1.0f, 0.5f)), myactuator_rmd::ValueRangeException);
+      EXPECT_THROW(static_cast<void>(tuner.tune(GainType::SPEED_LOOP_KP, 0.5f, 1.0f, 1)), myactuator_rmd::ValueRangeException);
+      EXPECT_THROW((myactuator_rmd::GainTuner{actuator, ExcitationType::VELOCITY_STEP, 100.0f, std::chrono::microseconds(0)}),
+                   myactuator_rmd::ValueRangeException);
+    }
+
+  }
+}
@@ -0,0 +1,47 @@
+/**
+ * \file periodic_rate_test.cpp
+ * \mainpage
+ *    Test running loops at a fixed rate
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#include <chrono>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "myactuator_rmd/control/periodic_rate.hpp"
+#include "myactuator_rmd/exceptions.hpp"
+
+
+namespace myactuator_rmd {
+  namespace test {
+
+    TEST(PeriodicRateTest, keepPeriod) {
+      myactuator_rmd::PeriodicRate rate {std::chrono::milliseconds(2)};
+      auto const start {std::chrono::steady_clock::now()};
+      for (int i = 0; i < 5; ++i) {
+        static_cast<void>(rate.sleep());
+      }
+      EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(10));
+    }
+
+    TEST(PeriodicRateTest, restartAfterOverrun) {
+      myactuator_rmd::PeriodicRate rate {std::chrono::milliseconds(2)};
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      EXPECT_FALSE(rate.sleep());
+      // The grid starts over instead of catching up on the missed periods
+      auto const start {std::chrono::steady_clock::now()};
+      EXPECT_TRUE(rate.sleep());
+      EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(1));
+    }
+
+    TEST(PeriodicRateTest, zeroPeriod) {
+      myactuator_rmd::PeriodicRate rate {std::chrono::microseconds(0)};
+      EXPECT_TRUE(rate.sleep());
+      EXPECT_THROW((myactuator_rmd::PeriodicRate{std::chrono::microseconds(-1)}), myactuator_rmd::ValueRangeException);
+    }
+
+  }
+}
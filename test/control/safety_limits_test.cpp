@@ -0,0 +1,88 @@
+/**
+ * \file safety_limits_test.cpp
+ * \mainpage
+ *    Test checking set-points and feedback against per-actuator limits
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#include <limits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "myactuator_rmd/control/safety_limits.hpp"
+
+
+namespace myactuator_rmd {
+  namespace test {
+
+    TEST(SafetyLimitsTest, clampsMotionControl) {
+      myactuator_rmd::SafetyLimits limits {2};
+      limits.max_position = {1.0f, 1.0f};
+      limits.max_torque = {5.0f, 5.0f};
+      std::vector<float> p_des {2.0f, std::numeric_limits<float>::quiet_NaN()};
+      std::vector<float> v_des {0.0f, -50.0f};
+      std::vector<float> t_ff {-6.0f, 4.0f};
+      EXPECT_EQ(limits.limitMotionControl(p_des.data(), v_des.data(), t_ff.data()), SafetyAction::CLAMP);
+      EXPECT_FLOAT_EQ(p_des[0], 1.0f);
+      EXPECT_FLOAT_EQ(p_des[1], -12.5f);
+      EXPECT_FLOAT_EQ(v_des[1], -45.0f);
+      EXPECT_FLOAT_EQ(t_ff[0], -5.0f);
+      EXPECT_FLOAT_EQ(t_ff[1], 4.0f);
+      EXPECT_EQ(limits.getNumViolations(), 4);
+      EXPECT_EQ(limits.getTrip(), SafetyAction::CLAMP);
+    }
+
+    TEST(SafetyLimitsTest, clampsPositionSetpointInDegree) {
+      myactuator_rmd::SafetyLimits limits {1};
+      limits.max_position = {1.0f};
+      limits.max_velocity = {1.0f};
+      std::vector<float> position {90.0f};
+      std::vector<float> max_speed {30.0f};
+      EXPECT_EQ(limits.limitPositionSetpoint(position.data(), max_speed.data()), SafetyAction::CLAMP);
+      EXPECT_NEAR(position[0], 57.29578f, 1e-3f);
+      EXPECT_FLOAT_EQ(max_speed[0], 30.0f);
+      EXPECT_EQ(limits.getNumViolations(), 1);
+    }
+
+    TEST(SafetyLimitsTest, deratesTorqueWithTemperature) {
+      myactuator_rmd::SafetyLimits limits {1};
+      limits.max_torque = {10.0f};
+      limits.derating_temperature = {60.0f};
+      limits.max_temperature = {80.0f};
+      std::vector<float> temperature {70.0f};
+      EXPECT_EQ(limits.checkTemperature(temperature.data()), SafetyAction::CLAMP);
+      std::vector<float> p_des {0.0f};
+      std::vector<float> v_des {0.0f};
+      std::vector<float> t_ff {8.0f};
+      static_cast<void>(limits.limitMotionControl(p_des.data(), v_des.data(), t_ff.data()));
+      EXPECT_FLOAT_EQ(t_ff[0], 5.0f);
+      temperature[0] = 80.0f;
+      EXPECT_EQ(limits.checkTemperature(temperature.data()), SafetyAction::STOP);
+    }
+
+    TEST(SafetyLimitsTest, feedbackTripIsLatched) {
+      myactuator_rmd::SafetyLimits limits {1};
+      limits.feedback_action = SafetyAction::SHUTDOWN;
+      std::vector<float> position {0.0f};
+      std::vector<float> velocity {0.0f};
+      std::vector<float> torque {0.0f};
+      EXPECT_EQ(limits.checkMotionControlFeedback(position.data(), velocity.data(), torque.data()), SafetyAction::CLAMP);
+      velocity[0] = 46.0f;
+      EXPECT_EQ(limits.checkMotionControlFeedback(position.data(), velocity.data(), torque.data()), SafetyAction::SHUTDOWN);
+      velocity[0] = 0.0f;
+      EXPECT_EQ(limits.checkMotionControlFeedback(position.data(), velocity.data(), torque.data()), SafetyAction::SHUTDOWN);
+      // A stop does not release a shutdown
+      limits.setpoint_action = SafetyAction::STOP;
+      std::vector<float> p_des {20.0f};
+      std::vector<float> v_des {0.0f};
+      std::vector<float> t_ff {0.0f};
+      EXPECT_EQ(limits.limitMotionControl(p_des.data(), v_des.data(), t_ff.data()), SafetyAction::SHUTDOWN);
+      limits.reset();
+      EXPECT_EQ(limits.getTrip(), SafetyAction::CLAMP);
+      EXPECT_EQ(limits.checkMotionControlFeedback(position.data(), velocity.data(), torque.data()), SafetyAction::CLAMP);
+    }
+
+  }
+}
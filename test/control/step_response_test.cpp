@@ -0,0 +1,59 @@
+/**
+ * \file step_response_test.cpp
+ * \mainpage
+ *    Test analysing step responses incrementally
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#include <chrono>
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "myactuator_rmd/control/step_response.hpp"
+#include "myactuator_rmd/exceptions.hpp"
+
+
+namespace myactuator_rmd {
+  namespace test {
+
+    TEST(StepResponseTest, firstOrderResponse) {
+      myactuator_rmd::StepResponse response {100};
+      response.reset(10.0f, 20.0f);
+      // Time constant of 10 ms sampled every millisecond
+      for (int i = 0; i < 200; ++i) {
+        float const t {static_cast<float>(i)*1e-3f};
+        response.update(std::chrono::milliseconds(i), 10.0f + 10.0f*(1.0f - std::exp(-t/0.01f)));
+      }
+      EXPECT_EQ(response.getNumSamples(), 100);
+      EXPECT_FLOAT_EQ(response.getValues()[0], 10.0f);
+      EXPECT_EQ(response.getTimes()[99], std::chrono::milliseconds(99));
+      EXPECT_NEAR(response.getRiseTime(), 0.022f, 1e-3f);
+      EXPECT_FLOAT_EQ(response.getOvershoot(), 0.0f);
+      EXPECT_NEAR(response.getSettlingTime(), 0.040f, 1e-3f);
+      EXPECT_NEAR(response.getSteadyStateError(), 0.0f, 1e-3f);
+      EXPECT_NEAR(response.getIntegralAbsoluteError(), 0.01f, 1e-3f);
+      EXPECT_NEAR(response.getBandwidth(), 0.35f/0.022f, 1.0f);
+    }
+
+    TEST(StepResponseTest, overshootOfNegativeStep) {
+      myactuator_rmd::StepResponse response {};
+      response.reset(0.0f, -100.0f);
+      response.update(std::chrono::milliseconds(0), 0.0f);
+      response.update(std::chrono::milliseconds(1), -50.0f);
+      response.update(std::chrono::milliseconds(2), -120.0f);
+      EXPECT_FLOAT_EQ(response.getRiseTime(), 0.001f);
+      EXPECT_NEAR(response.getOvershoot(), 0.2f, 1e-5f);
+      EXPECT_TRUE(std::isinf(response.getSettlingTime()));
+      response.update(std::chrono::milliseconds(3), -101.0f);
+      EXPECT_FLOAT_EQ(response.getSettlingTime(), 0.003f);
+      response.reset(0.0f, 1.0f);
+      EXPECT_EQ(response.getNumSamples(), 0);
+      EXPECT_TRUE(std::isinf(response.getRiseTime()));
+      EXPECT_FLOAT_EQ(response.getBandwidth(), 0.0f);
+      EXPECT_THROW(response.reset(1.0f, 1.0f), myactuator_rmd::ValueRangeException);
+    }
+
+  }
+}
@@ -0,0 +1,101 @@
+/**
+ * \file trajectory_interpolator_test.cpp
+ * \mainpage
+ *    Test generating set-points from sparse waypoints
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "myactuator_rmd/control/trajectory_interpolator.hpp"
+#include "myactuator_rmd/exceptions.hpp"
+
+
+namespace myactuator_rmd {
+  namespace test {
+
+    TEST(TrajectoryInterpolatorTest, quinticReachesWaypointAtRest) {
+      myactuator_rmd::TrajectoryInterpolator interpolator {{0.0f}, std::chrono::milliseconds(1), InterpolationType::QUINTIC};
+      ASSERT_TRUE(interpolator.addWaypoint(std::chrono::milliseconds(100), {90.0f}));
+      float position {};
+      float velocity {};
+      for (int i = 0; i < 50; ++i) {
+        interpolator.step(&position, &velocity);
+      }
+      EXPECT_NEAR(position, 45.0f, 1e-3f);
+      EXPECT_GT(velocity, 0.0f);
+      for (int i = 0; i < 49; ++i) {
+        interpolator.step(&position, &velocity);
+      }
+      EXPECT_TRUE(interpolator.isMoving());
+      EXPECT_NEAR(position, 90.0f, 1e-2f);
+      EXPECT_NEAR(velocity, 0.0f, 5.0f);
+      interpolator.step(&position, &velocity);
+      EXPECT_FALSE(interpolator.isMoving());
+      EXPECT_FLOAT_EQ(position, 90.0f);
+      EXPECT_FLOAT_EQ(velocity, 0.0f);
+    }
+
+    TEST(TrajectoryInterpolatorTest, trapezoidalPeakVelocity) {
+      myactuator_rmd::TrajectoryInterpolator interpolator {{10.0f}, std::chrono::milliseconds(1), InterpolationType::TRAPEZOIDAL};
+      ASSERT_TRUE(interpolator.addWaypoint(std::chrono::milliseconds(400), {-50.0f}));
+      float position {};
+      float velocity {};
+      for (int i = 0; i < 200; ++i) {
+        interpolator.step(&position, &velocity);
+      }
+      EXPECT_NEAR(position, -20.0f, 1e-3f);
+      EXPECT_NEAR(velocity, -60.0f/0.3f, 1e-2f);
+    }
+
+    TEST(TrajectoryInterpolatorTest, cubicPassesThroughWaypoint) {
+      myactuator_rmd::TrajectoryInterpolator interpolator {{0.0f}, std::chrono::milliseconds(1), InterpolationType::CUBIC};
+      ASSERT_TRUE(interpolator.addWaypoint(std::chrono::milliseconds(100), {10.0f}));
+      ASSERT_TRUE(interpolator.addWaypoint(std::chrono::milliseconds(100), {30.0f}));
+      float position {};
+      float velocity {};
+      float previous_velocity {};
+      for (int i = 0; i < 100; ++i) {
+        previous_velocity = velocity;
+        interpolator.step(&position, &velocity);
+      }
+      // Neighbouring slopes of 100 and 200 dps
+      EXPECT_NEAR(position, 10.0f, 1e-3f);
+      EXPECT_NEAR(velocity, 150.0f, 1e-2f);
+      EXPECT_NEAR(previous_velocity, velocity, 5.0f);
+      EXPECT_EQ(interpolator.getNumWaypoints(), 0);
+    }
+
+    TEST(TrajectoryInterpolatorTest, rejectsWaypointsIfFull) {
+      myactuator_rmd::TrajectoryInterpolator interpolator {{0.0f, 0.0f}, std::chrono::milliseconds(1), InterpolationType::QUINTIC, 2};
+      EXPECT_TRUE(interpolator.addWaypoint(std::chrono::milliseconds(10), {1.0f, 2.0f}));
+      EXPECT_TRUE(interpolator.addWaypoint(std::chrono::milliseconds(10), {3.0f, 4.0f}));
+      EXPECT_FALSE(interpolator.addWaypoint(std::chrono::milliseconds(10), {5.0f, 6.0f}));
+      EXPECT_EQ(interpolator.getNumWaypoints(), 2);
+      EXPECT_THROW(static_cast<void>(interpolator.addWaypoint(std::chrono::milliseconds(10), {1.0f})), myactuator_rmd::ValueRangeException);
+      EXPECT_THROW(static_cast<void>(interpolator.addWaypoint(std::chrono::milliseconds(0), {1.0f, 2.0f})), myactuator_rmd::ValueRangeException);
+    }
+
+    TEST(TrajectoryInterpolatorTest, holdsPositionWhenIdle) {
+      myactuator_rmd::TrajectoryInterpolator interpolator {{5.0f, -5.0f}, std::chrono::milliseconds(1)};
+      std::vector<float> position(2);
+      std::vector<float> velocity(2);
+      interpolator.step(position.data(), velocity.data());
+      EXPECT_FALSE(interpolator.isMoving());
+      EXPECT_FLOAT_EQ(position[0], 5.0f);
+      EXPECT_FLOAT_EQ(position[1], -5.0f);
+      std::vector<float> const reset {1.0f, 2.0f};
+      interpolator.reset(reset.data());
+      interpolator.step(position.data(), velocity.data());
+      EXPECT_FLOAT_EQ(position[0], 1.0f);
+      EXPECT_FLOAT_EQ(position[1], 2.0f);
+      EXPECT_FLOAT_EQ(velocity[0], 0.0f);
+    }
+
+  }
+}
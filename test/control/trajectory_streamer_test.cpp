@@ -0,0 +1,148 @@
+/**
+ * \file trajectory_streamer_test.cpp
+ * \mainpage
+ *    Test streaming an uploaded trajectory to a group of actuators
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "myactuator_rmd/actuator_state/motion_control_status.hpp"
+#include "myactuator_rmd/control/controller.hpp"
+#include "myactuator_rmd/control/trajectory_interpolator.hpp"
+#include "myactuator_rmd/control/trajectory_streamer.hpp"
+#include "myactuator_rmd/driver/replay_driver.hpp"
+#include "myactuator_rmd/actuator_group.hpp"
+#include "myactuator_rmd/exceptions.hpp"
+
+
+namespace myactuator_rmd {
+  namespace test {
+
+    TEST(TrajectoryStreamerTest, streamsAllSamples) {
+      std::vector<myactuator_rmd::RecordedFrame> frames {};
+      for (int i = 0; i < 3; ++i) {
+        frames.emplace_back(std::chrono::microseconds(0), can::Frame{0x501, {0x01, 0xFF, 0xFF, 0xFF, 0xF0, 0x00, 0x00, 0x00}});
+      }
+      myactuator_rmd::ReplayDriver driver {frames};
+      myactuator_rmd::ActuatorGroup group {driver, {1}};
+      myactuator_rmd::TrajectoryStreamer streamer {group, std::chrono::milliseconds(1)};
+      myactuator_rmd::SampledTrajectory trajectory {3, 1};
+      streamer.setTrajectory(trajectory);
+      streamer.start();
+      // The replay driver runs out of responses after the last sample and terminates the streamer
+      auto const start {std::chrono::steady_clock::now()};
+      while (streamer.isRunning() && (std::chrono::steady_clock::now() - start < std::chrono::seconds(1))) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      streamer.stop();
+      EXPECT_EQ(streamer.getProgress(), 3);
+      EXPECT_FALSE(streamer.getError().empty());
+      std::vector<float> position {};
+      std::vector<float> velocity {};
+      std::vector<float> torque {};
+      ASSERT_EQ(streamer.getFeedback(position, velocity, torque), 3);
+      ASSERT_EQ(position.size(), 3);
+      EXPECT_NEAR(position[2], 12.5f, 1e-3f);
+      EXPECT_NEAR(velocity[2], 45.0f, 1e-3f);
+      EXPECT_NEAR(torque[2], -24.0f, 1e-3f);
+    }
+
+    TEST(TrajectoryStreamerTest, streamsInterpolatedSetpoints) {
+      std::vector<myactuator_rmd::RecordedFrame> frames {};
+      for (int i = 0; i < 5; ++i) {
+        frames.emplace_back(std::chrono::microseconds(0), can::Frame{0x501, {0x01, 0xFF, 0xFF, 0xFF, 0xF0, 0x00, 0x00, 0x00}});
+      }
+      myactuator_rmd::ReplayDriver driver {frames};
+      myactuator_rmd::ActuatorGroup group {driver, {1}};
+      myactuator_rmd::TrajectoryStreamer streamer {group, std::chrono::milliseconds(1)};
+      myactuator_rmd::TrajectoryInterpolator interpolator {{0.0f}, std::chrono::milliseconds(1)};
+      ASSERT_TRUE(interpolator.addWaypoint(std::chrono::milliseconds(100), {10.0f}));
+      streamer.setInterpolator(&interpolator);
+      streamer.start();
+      auto const start {std::chrono::steady_clock::now()};
+      while (streamer.isRunning() && (std::chrono::steady_clock::now() - start < std::chrono::seconds(1))) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      streamer.stop();
+      // Every response was consumed by a set-point of the interpolator
+      EXPECT_FALSE(streamer.getError().empty());
+      EXPECT_EQ(streamer.getProgress(), 0);
+      EXPECT_TRUE(interpolator.isMoving());
+      EXPECT_EQ(interpolator.getNumWaypoints(), 0);
+    }
+
+    /**\class TorqueObserver
+     * \brief
+     *    Controller that records the feedback it is given and feeds the measured torque forward
+    */
+    class TorqueObserver: public myactuator_rmd::Controller {
+      public:
+        void update(std::vector<MotionControlStatus> const& status, std::vector<MotionControlCommand>& command) override {
+          torques.push_back(status.at(0).torque);
+          command.at(0).t_ff = -status.at(0).torque;
+          return;
+        }
+
+        std::vector<float> torques;
+    };
+
+    TEST(TrajectoryStreamerTest, controllerReceivesFeedback) {
+      std::vector<myactuator_rmd::RecordedFrame> frames {};
+      for (int i = 0; i < 3; ++i) {
+        frames.emplace_back(std::chrono::microseconds(0), can::Frame{0x501, {0x01, 0xFF, 0xFF, 0xFF, 0xF0, 0x00, 0x00, 0x00}});
+      }
+      myactuator_rmd::ReplayDriver driver {frames};
+      myactuator_rmd::ActuatorGroup group {driver, {1}};
+      myactuator_rmd::TrajectoryStreamer streamer {group, std::chrono::milliseconds(1)};
+      TorqueObserver controller {};
+      streamer.setController(&controller);
+      streamer.setTrajectory(myactuator_rmd::SampledTrajectory{3, 1});
+      streamer.start();
+      auto const start {std::chrono::steady_clock::now()};
+      while (streamer.isRunning() && (std::chrono::steady_clock::now() - start < std::chrono::seconds(1))) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      streamer.stop();
+      EXPECT_EQ(streamer.getProgress(), 3);
+      // The fourth command fails as the replay driver ran out of responses
+      ASSERT_EQ(controller.torques.size(), 4);
+      EXPECT_FLOAT_EQ(controller.torques[0], 0.0f);
+      for (std::size_t i = 1; i < controller.torques.size(); ++i) {
+        EXPECT_NEAR(controller.torques[i], -24.0f, 1e-3f);
+      }
+    }
+
+    TEST(TrajectoryStreamerTest, controllerRequiresMotionControl) {
+      myactuator_rmd::ReplayDriver driver {{}};
+      myactuator_rmd::ActuatorGroup group {driver, {1}};
+      myactuator_rmd::TrajectoryStreamer streamer {group, std::chrono::milliseconds(1), myactuator_rmd::StreamMode::POSITION_SETPOINT};
+      TorqueObserver controller {};
+      EXPECT_THROW(streamer.setController(&controller), myactuator_rmd::Exception);
+      EXPECT_NO_THROW(streamer.setController(nullptr));
+    }
+
+    TEST(TrajectoryStreamerTest, rejectsMismatchingInterpolator) {
+      myactuator_rmd::ReplayDriver driver {{}};
+      myactuator_rmd::ActuatorGroup group {driver, {1, 2}};
+      myactuator_rmd::TrajectoryStreamer streamer {group, std::chrono::milliseconds(1)};
+      myactuator_rmd::TrajectoryInterpolator interpolator {{0.0f}, std::chrono::milliseconds(1)};
+      EXPECT_THROW(streamer.setInterpolator(&interpolator), myactuator_rmd::ValueRangeException);
+      EXPECT_NO_THROW(streamer.setInterpolator(nullptr));
+    }
+
+    TEST(TrajectoryStreamerTest, rejectsMismatchingTrajectory) {
+      myactuator_rmd::ReplayDriver driver {{}};
+      myactuator_rmd::ActuatorGroup group {driver, {1, 2}};
+      myactuator_rmd::TrajectoryStreamer streamer {group, std::chrono::milliseconds(1)};
+      EXPECT_THROW(streamer.setTrajectory(myactuator_rmd::SampledTrajectory{3, 1}), myactuator_rmd::ValueRangeException);
+    }
+
+  }
+}
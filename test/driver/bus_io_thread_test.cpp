@@ -0,0 +1,105 @@
+/**
+ * \file bus_io_thread_test.cpp
+ * \mainpage
+ *    Test several client threads sharing a bus through its I/O thread
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "myactuator_rmd/driver/bus_io_thread.hpp"
+#include "myactuator_rmd/driver/channel_driver.hpp"
+#include "myactuator_rmd/driver/replay_driver.hpp"
+#include "myactuator_rmd/driver/transfer.hpp"
+#include "myactuator_rmd/protocol/command_type.hpp"
+#include "myactuator_rmd/protocol/requests.hpp"
+#include "myactuator_rmd/actuator_interface.hpp"
+#include "myactuator_rmd/exceptions.hpp"
+#include "../mock/simulated_driver.hpp"
+
+
+namespace myactuator_rmd {
+  namespace test {
+
+    /**\class OrderRecordingDriver
+     * \brief
+     *    Driver echoing every request and recording the commands in the order they reach the bus
+    */
+    class OrderRecordingDriver: public SimulatedDriver {
+      public:
+        std::vector<std::uint8_t> getCommands() const {
+          std::lock_guard<std::mutex> const lock {mutex_};
+          return commands_;
+        }
+
+      protected:
+        std::array<std::uint8_t,8> respond(std::array<std::uint8_t,8> const& request, std::uint32_t const /*actuator_id*/) override {
+          std::lock_guard<std::mutex> const lock {mutex_};
+          commands_.push_back(request[0]);
+          return request;
+        }
+
+        mutable std::mutex mutex_;
+        std::vector<std::uint8_t> commands_;
+    };
+
+    TEST(BusIoThreadTest, severalClientThreads) {
+      constexpr std::size_t num_requests {200};
+      std::vector<myactuator_rmd::RecordedFrame> frames {};
+      for (std::size_t i = 0; i < num_requests; ++i) {
+        frames.emplace_back(std::chrono::microseconds(0), can::Frame{0x241, {0x92, 0x00, 0x00, 0x00, 0xA0, 0x8C, 0x00, 0x00}});
+        frames.emplace_back(std::chrono::microseconds(0), can::Frame{0x242, {0x92, 0x00, 0x00, 0x00, 0x40, 0x19, 0x01, 0x00}});
+      }
+      myactuator_rmd::ReplayDriver driver {frames};
+      myactuator_rmd::BusIoThread io_thread {driver, std::chrono::microseconds(0)};
+      auto const client = [&io_thread](std::uint32_t const actuator_id, float const expected_angle) {
+        myactuator_rmd::ChannelDriver channel_driver {io_thread};
+        myactuator_rmd::ActuatorInterface actuator {channel_driver, actuator_id};
+        for (std::size_t i = 0; i < num_requests; ++i) {
+          EXPECT_NEAR(actuator.getMultiTurnAngle(), expected_angle, 0.1f);
+        }
+      };
+      std::thread client_1 {client, 1, 360.0f};
+      std::thread client_2 {client, 2, 720.0f};
+      client_1.join();
+      client_2.join();
+      EXPECT_EQ(driver.getRemaining(), 0);
+    }
+
+    TEST(BusIoThreadTest, sendsDoNotOvertakeEarlierRequests) {
+      OrderRecordingDriver driver {};
+      // The I/O thread sleeps long enough for both requests to be collected in the same cycle
+      myactuator_rmd::BusIoThread io_thread {driver, std::chrono::milliseconds(20)};
+      auto& channel {io_thread.openChannel()};
+      myactuator_rmd::Transfer const setpoint {1, SetVelocityRequest{100.0f}.getData()};
+      myactuator_rmd::Transfer const stop {1, StopMotorRequest{}.getData()};
+      ASSERT_TRUE(channel.trySubmit(IoRequest{setpoint, 0, true}));
+      ASSERT_TRUE(channel.trySubmit(IoRequest{stop, 1, false}));
+      IoCompletion completion {};
+      ASSERT_TRUE(channel.receive(completion));
+      EXPECT_EQ(completion.tag, 0);
+      ASSERT_TRUE(channel.receive(completion));
+      EXPECT_EQ(completion.tag, 1);
+      std::vector<std::uint8_t> const expected {static_cast<std::uint8_t>(CommandType::SPEED_CLOSED_LOOP_CONTROL),
+                                                static_cast<std::uint8_t>(CommandType::STOP_MOTOR)};
+      EXPECT_EQ(driver.getCommands(), expected);
+    }
+
+    TEST(BusIoThreadTest, errorsAreReturnedToTheClient) {
+      myactuator_rmd::ReplayDriver driver {{}};
+      myactuator_rmd::BusIoThread io_thread {driver};
+      myactuator_rmd::ChannelDriver channel_driver {io_thread};
+      myactuator_rmd::ActuatorInterface actuator {channel_driver, 1};
+      EXPECT_THROW(static_cast<void>(actuator.getMultiTurnAngle()), myactuator_rmd::Exception);
+    }
+
+  }
+}
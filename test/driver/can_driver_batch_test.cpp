@@ -0,0 +1,125 @@
+/**
+ * \file can_driver_batch_test.cpp
+ * \mainpage
+ *    Test retries, deadlines and the discarding of late replies of batches of requests against scripted actuators
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "myactuator_rmd/can/exceptions.hpp"
+#include "myactuator_rmd/driver/can_address_offset.hpp"
+#include "myactuator_rmd/driver/driver.hpp"
+#include "myactuator_rmd/driver/transfer.hpp"
+#include "myactuator_rmd/protocol/command_type.hpp"
+#include "myactuator_rmd/protocol/requests.hpp"
+#include "../mock/driver_scripted_actuators_test.hpp"
+
+
+namespace myactuator_rmd {
+  namespace test {
+
+    /**\fn getTransfers
+     * \brief
+     *    Create a batch with the same request to every actuator
+     * 
+     * \param[in] actuator_ids
+     *    The ids of the actuators
+     * \param[in] request
+     *    The request sent to every actuator
+     * \param[in] timeout
+     *    The deadline of every transfer
+     * \return
+     *    The transfers of the batch
+    */
+    std::vector<Transfer> getTransfers(std::vector<std::uint32_t> const& actuator_ids, std::array<std::uint8_t,8> const& request,
+                                       std::chrono::microseconds const& timeout) {
+      std::vector<Transfer> transfers {};
+      for (auto const& actuator_id: actuator_ids) {
+        transfers.emplace_back(actuator_id, request, CanAddressOffset::request, CanAddressOffset::response, timeout);
+      }
+      return transfers;
+    }
+
+    TEST_F(DriverScriptedActuatorsTest, absentActuatorTimesOut) {
+      // The second actuator never replies
+      startActuators({1, 2, 3}, [](std::uint32_t const actuator_id, std::array<std::uint8_t,8> const& request) {
+        return (actuator_id == 2) ? std::vector<std::array<std::uint8_t,8>>{} : std::vector<std::array<std::uint8_t,8>>{request};
+      });
+      myactuator_rmd::Driver& driver {driver_};
+      auto transfers {getTransfers({1, 2, 3}, GetMotorStatus2Request{}.getData(), std::chrono::milliseconds(20))};
+      // A shorter deadline of a single transfer does not cut the others short
+      transfers[2].timeout = std::chrono::milliseconds(5);
+      EXPECT_THROW(driver.sendRecv(transfers), myactuator_rmd::can::TimeoutException);
+      EXPECT_TRUE(transfers[0].is_received);
+      EXPECT_TRUE(transfers[1].is_timed_out);
+      EXPECT_FALSE(transfers[1].is_received);
+      EXPECT_TRUE(transfers[2].is_received);
+      EXPECT_EQ(driver_.getStatistics().num_timeouts, 1);
+    }
+
+    TEST_F(DriverScriptedActuatorsTest, idempotentReadIsRetried) {
+      std::size_t num_requests {0};
+      // The first request is lost
+      startActuators({1}, [&num_requests](std::uint32_t const /*actuator_id*/, std::array<std::uint8_t,8> const& request) {
+        return (num_requests++ == 0) ? std::vector<std::array<std::uint8_t,8>>{} : std::vector<std::array<std::uint8_t,8>>{request};
+      });
+      driver_.setMaxRetries(2);
+      myactuator_rmd::Driver& driver {driver_};
+      auto transfers {getTransfers({1}, GetMotorStatus2Request{}.getData(), std::chrono::milliseconds(60))};
+      EXPECT_NO_THROW(driver.sendRecv(transfers));
+      EXPECT_TRUE(transfers[0].is_received);
+      actuators_->stop();
+      EXPECT_EQ(actuators_->getRequests().size(), 2);
+      auto const statistics {driver_.getStatistics()};
+      EXPECT_EQ(statistics.num_retries, 1);
+      EXPECT_EQ(statistics.num_timeouts, 0);
+    }
+
+    TEST_F(DriverScriptedActuatorsTest, writeIsNeverRepeated) {
+      // No set-point is ever answered
+      startActuators({1}, [](std::uint32_t const /*actuator_id*/, std::array<std::uint8_t,8> const& /*request*/) {
+        return std::vector<std::array<std::uint8_t,8>>{};
+      });
+      driver_.setMaxRetries(2);
+      myactuator_rmd::Driver& driver {driver_};
+      auto transfers {getTransfers({1}, SetVelocityRequest{100.0f}.getData(), std::chrono::milliseconds(30))};
+      EXPECT_THROW(driver.sendRecv(transfers), myactuator_rmd::can::TimeoutException);
+      EXPECT_TRUE(transfers[0].is_timed_out);
+      actuators_->stop();
+      EXPECT_EQ(actuators_->getRequests().size(), 1);
+      EXPECT_EQ(driver_.getStatistics().num_retries, 0);
+    }
+
+    TEST_F(DriverScriptedActuatorsTest, lateReplyIsStale) {
+      // Every actuator first answers an earlier request before answering the current one
+      std::array<std::uint8_t,8> late_reply {};
+      late_reply[0] = static_cast<std::uint8_t>(CommandType::READ_MOTOR_STATUS_1_AND_ERROR_FLAG);
+      startActuators({1, 2}, [late_reply](std::uint32_t const /*actuator_id*/, std::array<std::uint8_t,8> const& request) {
+        auto reply {request};
+        reply[7] = 0x42;
+        return std::vector<std::array<std::uint8_t,8>>{late_reply, reply};
+      });
+      myactuator_rmd::Driver& driver {driver_};
+      auto transfers {getTransfers({1, 2}, GetMotorStatus2Request{}.getData(), std::chrono::milliseconds(20))};
+      EXPECT_NO_THROW(driver.sendRecv(transfers));
+      for (auto const& transfer: transfers) {
+        EXPECT_TRUE(transfer.is_received);
+        EXPECT_EQ(transfer.response[0], static_cast<std::uint8_t>(CommandType::READ_MOTOR_STATUS_2));
+        EXPECT_EQ(transfer.response[7], 0x42);
+      }
+      auto const statistics {driver_.getStatistics()};
+      EXPECT_EQ(statistics.num_stale_frames, 2);
+      // Both requests were written before any of the replies had to be waited for
+      EXPECT_LE(statistics.command_skew, std::chrono::milliseconds(20));
+      EXPECT_GE(statistics.max_command_skew, statistics.command_skew);
+    }
+
+  }
+}
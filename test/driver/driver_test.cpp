@@ -0,0 +1,101 @@
+/**
+ * \file driver_test.cpp
+ * \mainpage
+ *    Test the default exchange of several transfers by the driver base class
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <system_error>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "myactuator_rmd/can/exceptions.hpp"
+#include "myactuator_rmd/driver/driver.hpp"
+#include "myactuator_rmd/driver/replay_driver.hpp"
+#include "myactuator_rmd/driver/transfer.hpp"
+#include "myactuator_rmd/protocol/message.hpp"
+#include "myactuator_rmd/actuator_group.hpp"
+
+
+namespace myactuator_rmd {
+  namespace test {
+
+    /**\class MissingActuatorDriver
+     * \brief
+     *    Replay driver where a single actuator never replies
+    */
+    class MissingActuatorDriver: public myactuator_rmd::ReplayDriver {
+      public:
+        MissingActuatorDriver(std::vector<myactuator_rmd::RecordedFrame> const& frames, std::uint32_t const missing_id)
+        : ReplayDriver{frames}, missing_id_{missing_id}, timeouts_{} {
+          return;
+        }
+
+        std::array<std::uint8_t,8> sendRecv(Message const& request, std::uint32_t const actuator_id,
+                                            std::uint32_t const request_offset, std::uint32_t const response_offset) override {
+          if (actuator_id == missing_id_) {
+            throw myactuator_rmd::can::TimeoutException(ETIMEDOUT, std::generic_category(), "Missing actuator");
+          }
+          return ReplayDriver::sendRecv(request, actuator_id, request_offset, response_offset);
+        }
+
+        void sendRecv(std::vector<Transfer>& transfers) override {
+          timeouts_.clear();
+          for (auto const& transfer: transfers) {
+            timeouts_.push_back(transfer.timeout);
+          }
+          Driver::sendRecv(transfers);
+          return;
+        }
+
+        using ReplayDriver::sendRecv;
+
+        std::vector<std::chrono::microseconds> const& getTimeouts() const noexcept {
+          return timeouts_;
+        }
+
+      protected:
+        std::uint32_t missing_id_;
+        std::vector<std::chrono::microseconds> timeouts_;
+    };
+
+    TEST(DriverTest, timeoutLeavesOtherTransfersUnaffected) {
+      std::vector<myactuator_rmd::RecordedFrame> const frames {
+        {std::chrono::microseconds(0), can::Frame{0x241, {0x9C, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}},
+        {std::chrono::microseconds(0), can::Frame{0x243, {0x9C, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}}
+      };
+      MissingActuatorDriver driver {frames, 2};
+      std::vector<myactuator_rmd::Transfer> transfers {
+        myactuator_rmd::Transfer{1, {0x9C}}, myactuator_rmd::Transfer{2, {0x9C}}, myactuator_rmd::Transfer{3, {0x9C}}
+      };
+      EXPECT_THROW(driver.sendRecv(transfers), myactuator_rmd::can::TimeoutException);
+      EXPECT_TRUE(transfers[0].is_received);
+      EXPECT_FALSE(transfers[0].is_timed_out);
+      EXPECT_EQ(transfers[0].response[1], 0x01);
+      EXPECT_FALSE(transfers[1].is_received);
+      EXPECT_TRUE(transfers[1].is_timed_out);
+      EXPECT_TRUE(transfers[2].is_received);
+      EXPECT_EQ(transfers[2].response[1], 0x03);
+    }
+
+    TEST(DriverTest, groupTimeout) {
+      std::vector<myactuator_rmd::RecordedFrame> const frames {
+        {std::chrono::microseconds(0), can::Frame{0x501, {0x01, 0xFF, 0xFF, 0xFF, 0xF0, 0x00, 0x00, 0x00}}}
+      };
+      MissingActuatorDriver driver {frames, 2};
+      myactuator_rmd::ActuatorGroup group {driver, {1, 2}};
+      group.setTimeout(std::chrono::microseconds(300));
+      EXPECT_THROW(static_cast<void>(group.motionControl({0.0f, 0.0f}, {0.0f, 0.0f}, {0.0f, 0.0f}, {0.0f, 0.0f}, {0.0f, 0.0f})),
+                   myactuator_rmd::can::TimeoutException);
+      ASSERT_EQ(driver.getTimeouts().size(), 2);
+      EXPECT_EQ(driver.getTimeouts()[0], std::chrono::microseconds(300));
+      EXPECT_EQ(driver.getTimeouts()[1], std::chrono::microseconds(300));
+    }
+
+  }
+}
@@ -0,0 +1,113 @@
+/**
+ * \file heartbeat_driver_test.cpp
+ * \mainpage
+ *    Test keeping the communication with idle actuators alive
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "myactuator_rmd/driver/heartbeat_driver.hpp"
+#include "myactuator_rmd/protocol/command_type.hpp"
+#include "myactuator_rmd/protocol/message.hpp"
+#include "myactuator_rmd/protocol/requests.hpp"
+#include "myactuator_rmd/exceptions.hpp"
+#include "../mock/simulated_driver.hpp"
+
+
+namespace myactuator_rmd {
+  namespace test {
+
+    /**\class EchoDriver
+     * \brief
+     *    Driver that answers every request by echoing it and counts the requests per command
+    */
+    class EchoDriver: public SimulatedDriver {
+      public:
+        std::size_t getCount(CommandType const command) const {
+          std::lock_guard<std::mutex> const lock {mutex_};
+          auto const it {counts_.find(static_cast<std::uint8_t>(command))};
+          return (it != counts_.end()) ? it->second : 0;
+        }
+
+      protected:
+        std::array<std::uint8_t,8> respond(std::array<std::uint8_t,8> const& request, std::uint32_t const /*actuator_id*/) override {
+          std::lock_guard<std::mutex> const lock {mutex_};
+          ++counts_[request[0]];
+          return request;
+        }
+
+        mutable std::mutex mutex_;
+        std::map<std::uint8_t,std::size_t> counts_;
+    };
+
+    /**\class BrokenStatusDriver
+     * \brief
+     *    Driver that echoes every request but fails to decode the replies to status requests
+    */
+    class BrokenStatusDriver: public SimulatedDriver {
+      protected:
+        std::array<std::uint8_t,8> respond(std::array<std::uint8_t,8> const& request, std::uint32_t const /*actuator_id*/) override {
+          if (request[0] == CommandType::READ_MOTOR_STATUS_1_AND_ERROR_FLAG) {
+            throw myactuator_rmd::ProtocolException("Unexpected reply!");
+          }
+          return request;
+        }
+    };
+
+    TEST(HeartbeatDriverTest, idleActuatorsReceiveHeartbeats) {
+      EchoDriver driver {};
+      myactuator_rmd::HeartbeatDriver heartbeat_driver {driver, std::chrono::milliseconds(5)};
+      heartbeat_driver.addId(1);
+      heartbeat_driver.addId(2);
+      // Only bounded by a generous deadline so that a loaded machine does not fail the test
+      auto const deadline {std::chrono::steady_clock::now() + std::chrono::seconds(5)};
+      while ((heartbeat_driver.getNumHeartbeats() < 4) && (std::chrono::steady_clock::now() < deadline)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      EXPECT_GE(heartbeat_driver.getNumHeartbeats(), 4);
+      EXPECT_EQ(heartbeat_driver.getNumFailedHeartbeats(), 0);
+      EXPECT_EQ(driver.getCount(CommandType::READ_MOTOR_STATUS_1_AND_ERROR_FLAG), heartbeat_driver.getNumHeartbeats());
+    }
+
+    TEST(HeartbeatDriverTest, noHeartbeatsWhileCommanding) {
+      EchoDriver driver {};
+      myactuator_rmd::HeartbeatDriver heartbeat_driver {driver, std::chrono::milliseconds(100)};
+      heartbeat_driver.addId(1);
+      auto const end {std::chrono::steady_clock::now() + std::chrono::milliseconds(300)};
+      while (std::chrono::steady_clock::now() < end) {
+        static_cast<void>(heartbeat_driver.sendRecv(GetMotorStatus2Request{}, 1));
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+      }
+      EXPECT_EQ(heartbeat_driver.getNumHeartbeats(), 0);
+      EXPECT_GT(driver.getCount(CommandType::READ_MOTOR_STATUS_2), 0);
+    }
+
+    TEST(HeartbeatDriverTest, rethrowHeartbeatErrors) {
+      BrokenStatusDriver driver {};
+      myactuator_rmd::HeartbeatDriver heartbeat_driver {driver, std::chrono::milliseconds(5)};
+      heartbeat_driver.addId(1);
+      auto const deadline {std::chrono::steady_clock::now() + std::chrono::seconds(5)};
+      while ((heartbeat_driver.getNumHeartbeats() < 1) && (std::chrono::steady_clock::now() < deadline)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      ASSERT_GE(heartbeat_driver.getNumHeartbeats(), 1);
+      EXPECT_THROW(static_cast<void>(heartbeat_driver.sendRecv(GetMotorStatus2Request{}, 1)), myactuator_rmd::ProtocolException);
+    }
+
+    TEST(HeartbeatDriverTest, invalidPeriod) {
+      EchoDriver driver {};
+      EXPECT_THROW(myactuator_rmd::HeartbeatDriver(driver, std::chrono::microseconds(0)), myactuator_rmd::ValueRangeException);
+    }
+
+  }
+}
@@ -0,0 +1,107 @@
+/**
+ * \file multi_bus_driver_test.cpp
+ * \mainpage
+ *    Test sharding actuators across several buses
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "myactuator_rmd/driver/driver.hpp"
+#include "myactuator_rmd/driver/driver_statistics.hpp"
+#include "myactuator_rmd/driver/multi_bus_driver.hpp"
+#include "myactuator_rmd/driver/replay_driver.hpp"
+#include "myactuator_rmd/actuator_group.hpp"
+#include "myactuator_rmd/actuator_interface.hpp"
+#include "myactuator_rmd/exceptions.hpp"
+
+
+namespace myactuator_rmd {
+  namespace test {
+
+    TEST(MultiBusDriverTest, handles) {
+      EXPECT_EQ(myactuator_rmd::MultiBusDriver::getHandle(0, 1), 1);
+      EXPECT_EQ(myactuator_rmd::MultiBusDriver::getHandle(0, 32), 32);
+      EXPECT_EQ(myactuator_rmd::MultiBusDriver::getHandle(1, 1), 33);
+      EXPECT_EQ(myactuator_rmd::MultiBusDriver::getHandle(3, 7), 103);
+      myactuator_rmd::MultiBusDriver driver {std::vector<std::shared_ptr<myactuator_rmd::Driver>>{
+        std::make_shared<myactuator_rmd::ReplayDriver>(std::vector<myactuator_rmd::RecordedFrame>{}),
+        std::make_shared<myactuator_rmd::ReplayDriver>(std::vector<myactuator_rmd::RecordedFrame>{})
+      }};
+      EXPECT_EQ(driver.getNumBuses(), 2);
+      EXPECT_NO_THROW(driver.addId(64));
+      EXPECT_THROW(driver.addId(0), myactuator_rmd::Exception);
+      EXPECT_THROW(driver.addId(65), myactuator_rmd::Exception);
+    }
+
+    /**\class CountingDriver
+     * \brief
+     *    Replay driver reporting fixed frame counters
+    */
+    class CountingDriver: public myactuator_rmd::ReplayDriver {
+      public:
+        CountingDriver(myactuator_rmd::DriverStatistics const& statistics)
+        : ReplayDriver{std::vector<myactuator_rmd::RecordedFrame>{}}, statistics_{statistics} {
+          return;
+        }
+
+        myactuator_rmd::DriverStatistics getStatistics() const override {
+          return statistics_;
+        }
+
+      protected:
+        myactuator_rmd::DriverStatistics statistics_;
+    };
+
+    TEST(MultiBusDriverTest, statisticsAcrossBuses) {
+      myactuator_rmd::MultiBusDriver driver {std::vector<std::shared_ptr<myactuator_rmd::Driver>>{
+        std::make_shared<CountingDriver>(myactuator_rmd::DriverStatistics{10, 9, 1, 5, 0, 0, 0, std::chrono::microseconds(40),
+                                                                          std::chrono::microseconds(90)}),
+        std::make_shared<CountingDriver>(myactuator_rmd::DriverStatistics{20, 17, 3, 7, 0, 0, 0, std::chrono::microseconds(60),
+                                                                          std::chrono::microseconds(70)})
+      }};
+      auto const statistics {driver.getStatistics()};
+      EXPECT_EQ(statistics.num_sent_frames, 30);
+      EXPECT_EQ(statistics.num_received_frames, 26);
+      EXPECT_EQ(statistics.num_dropped_frames, 4);
+      EXPECT_EQ(statistics.num_syscalls, 12);
+      EXPECT_EQ(statistics.command_skew, std::chrono::microseconds(60));
+      EXPECT_EQ(statistics.max_command_skew, std::chrono::microseconds(90));
+      myactuator_rmd::ReplayDriver const replay_driver {std::vector<myactuator_rmd::RecordedFrame>{}};
+      EXPECT_EQ(replay_driver.getStatistics().num_dropped_frames, 0);
+    }
+
+    TEST(MultiBusDriverTest, groupAcrossBuses) {
+      std::vector<myactuator_rmd::RecordedFrame> const frames_0 {
+        {std::chrono::microseconds(0), can::Frame{0x501, {0x01, 0xFF, 0xFF, 0xFF, 0xF0, 0x00, 0x00, 0x00}}}
+      };
+      std::vector<myactuator_rmd::RecordedFrame> const frames_1 {
+        {std::chrono::microseconds(0), can::Frame{0x501, {0x01, 0x00, 0x00, 0x00, 0x0F, 0xFF, 0x00, 0x00}}},
+        {std::chrono::microseconds(0), can::Frame{0x241, {0x92, 0x00, 0x00, 0x00, 0xA0, 0x8C, 0x00, 0x00}}}
+      };
+      myactuator_rmd::MultiBusDriver driver {std::vector<std::shared_ptr<myactuator_rmd::Driver>>{
+        std::make_shared<myactuator_rmd::ReplayDriver>(frames_0),
+        std::make_shared<myactuator_rmd::ReplayDriver>(frames_1)
+      }};
+      auto const handle_0 {myactuator_rmd::MultiBusDriver::getHandle(0, 1)};
+      auto const handle_1 {myactuator_rmd::MultiBusDriver::getHandle(1, 1)};
+      myactuator_rmd::ActuatorGroup group {driver, {handle_0, handle_1}};
+      auto const status {group.motionControl({0.0f, 0.0f}, {0.0f, 0.0f}, {10.0f, 10.0f}, {1.0f, 1.0f}, {0.0f, 0.0f})};
+      ASSERT_EQ(status.size(), 2);
+      EXPECT_NEAR(status[0].shaft_angle, 12.5f, 1e-3f);
+      EXPECT_NEAR(status[1].shaft_angle, -12.5f, 1e-3f);
+      myactuator_rmd::ActuatorInterface actuator {driver, handle_1};
+      EXPECT_NEAR(actuator.getMultiTurnAngle(), 360.0f, 0.1f);
+      // The first bus has no further recorded responses
+      EXPECT_THROW(static_cast<void>(group.motionControl({0.0f, 0.0f}, {0.0f, 0.0f}, {0.0f, 0.0f}, {0.0f, 0.0f}, {0.0f, 0.0f})),
+                   myactuator_rmd::Exception);
+    }
+
+  }
+}
@@ -0,0 +1,80 @@
+/**
+ * \file replay_driver_test.cpp
+ * \mainpage
+ *    Tests for replaying recorded CAN traffic through the protocol stack
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#include <chrono>
+#include <cstdint>
+#include <sstream>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "myactuator_rmd/driver/replay_driver.hpp"
+#include "myactuator_rmd/actuator_interface.hpp"
+#include "myactuator_rmd/exceptions.hpp"
+
+
+namespace myactuator_rmd {
+  namespace test {
+
+    TEST(ReadCandumpLogTest, parsing) {
+      std::istringstream is {"(1700000000.000100) can0 141#B200000000000000\n"
+                             "(1700000000.000350) can0 241#B20000002E893401\n"
+                             "invalid line\n"
+                             "(1700000000.000400) can0 242#9C\n"};
+      auto const frames {myactuator_rmd::readCandumpLog(is)};
+      ASSERT_EQ(frames.size(), 3);
+      EXPECT_EQ(frames[0].timestamp.count(), 1700000000000100);
+      EXPECT_EQ(frames[1].frame.getId(), 0x241);
+      EXPECT_EQ(frames[1].frame.getData()[7], 0x01);
+      EXPECT_EQ(frames[2].frame.getData()[0], 0x9C);
+      EXPECT_EQ(frames[2].frame.getData()[1], 0x00);
+    }
+
+    TEST(BinaryLogTest, roundTrip) {
+      std::vector<myactuator_rmd::RecordedFrame> const frames {
+        {std::chrono::microseconds(1), can::Frame{0x241, {0xB2, 0x00, 0x00, 0x00, 0x2E, 0x89, 0x34, 0x01}}},
+        {std::chrono::microseconds(1700000000000400), can::Frame{0x501, {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08}}}
+      };
+      std::stringstream ss {};
+      myactuator_rmd::writeBinaryLog(ss, frames);
+      auto const read_frames {myactuator_rmd::readBinaryLog(ss)};
+      ASSERT_EQ(read_frames.size(), frames.size());
+      for (std::size_t i = 0; i < frames.size(); ++i) {
+        EXPECT_EQ(read_frames[i].timestamp, frames[i].timestamp);
+        EXPECT_EQ(read_frames[i].frame.getId(), frames[i].frame.getId());
+        EXPECT_EQ(read_frames[i].frame.getData(), frames[i].frame.getData());
+      }
+    }
+
+    TEST(ReplayDriverTest, servesResponsesPerActuator) {
+      std::istringstream is {"(1700000000.000000) can0 141#B200000000000000\n"
+                             "(1700000000.000100) can0 242#B2000000B6893401\n"
+                             "(1700000000.000200) can0 241#B20000002E893401\n"};
+      myactuator_rmd::ReplayDriver driver {myactuator_rmd::readCandumpLog(is)};
+      myactuator_rmd::ActuatorInterface actuator_1 {driver, 1};
+      myactuator_rmd::ActuatorInterface actuator_2 {driver, 2};
+      EXPECT_EQ(driver.getRemaining(), 2);
+      EXPECT_EQ(actuator_1.getVersionDate(), 20220206);
+      EXPECT_EQ(actuator_2.getVersionDate(), 20220342);
+      EXPECT_EQ(driver.getRemaining(), 0);
+      EXPECT_THROW(static_cast<void>(actuator_1.getVersionDate()), myactuator_rmd::Exception);
+    }
+
+    TEST(ReplayDriverTest, originalTiming) {
+      std::istringstream is {"(1700000000.000000) can0 241#B20000002E893401\n"
+                             "(1700000000.020000) can0 241#B20000002E893401\n"};
+      myactuator_rmd::ReplayDriver driver {myactuator_rmd::readCandumpLog(is), myactuator_rmd::ReplayMode::ORIGINAL_TIMING};
+      myactuator_rmd::ActuatorInterface actuator {driver, 1};
+      static_cast<void>(actuator.getVersionDate());
+      auto const start {std::chrono::steady_clock::now()};
+      static_cast<void>(actuator.getVersionDate());
+      EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(19));
+    }
+
+  }
+}
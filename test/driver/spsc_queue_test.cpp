@@ -0,0 +1,62 @@
+/**
+ * \file spsc_queue_test.cpp
+ * \mainpage
+ *    Test the wait-free single-producer single-consumer ring buffer
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#include <cstdint>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "myactuator_rmd/driver/spsc_queue.hpp"
+
+
+namespace myactuator_rmd {
+  namespace test {
+
+    TEST(SpscQueueTest, fullAndEmpty) {
+      myactuator_rmd::SpscQueue<int,4> queue {};
+      int value {0};
+      EXPECT_FALSE(queue.tryPop(value));
+      for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.tryPush(i));
+      }
+      EXPECT_FALSE(queue.tryPush(4));
+      EXPECT_EQ(queue.size(), 4);
+      for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(queue.tryPop(value));
+        EXPECT_EQ(value, i);
+      }
+      EXPECT_FALSE(queue.tryPop(value));
+      EXPECT_EQ(queue.size(), 0);
+    }
+
+    TEST(SpscQueueTest, concurrentProducerAndConsumer) {
+      constexpr std::uint64_t num_elements {10000};
+      myactuator_rmd::SpscQueue<std::uint64_t,16> queue {};
+      std::thread producer {[&queue]() {
+        for (std::uint64_t i = 0; i < num_elements; ++i) {
+          while (!queue.tryPush(i)) {
+            std::this_thread::yield();
+          }
+        }
+      }};
+      std::uint64_t expected {0};
+      std::uint64_t value {0};
+      while (expected < num_elements) {
+        if (queue.tryPop(value)) {
+          ASSERT_EQ(value, expected);
+          ++expected;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+      producer.join();
+      EXPECT_FALSE(queue.tryPop(value));
+    }
+
+  }
+}
@@ -0,0 +1,65 @@
+/**
+ * \file transfer_test.cpp
+ * \mainpage
+ *    Test matching replies to transfers and classifying the requests that may be repeated
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#include <gtest/gtest.h>
+
+#include "myactuator_rmd/actuator_state/gain_type.hpp"
+#include "myactuator_rmd/driver/can_address_offset.hpp"
+#include "myactuator_rmd/driver/transfer.hpp"
+#include "myactuator_rmd/protocol/motion_control_request.hpp"
+#include "myactuator_rmd/protocol/requests.hpp"
+#include "myactuator_rmd/protocol/single_gain_request.hpp"
+
+
+namespace myactuator_rmd {
+  namespace test {
+
+    TEST(TransferTest, readsAreIdempotent) {
+      EXPECT_TRUE(isIdempotent(Transfer{1, GetMotorStatus2Request{}.getData()}));
+      EXPECT_TRUE(isIdempotent(Transfer{1, GetMultiTurnAngleRequest{}.getData()}));
+      EXPECT_TRUE(isIdempotent(Transfer{1, GetCanIdRequest{}.getData()}));
+    }
+
+    TEST(TransferTest, writesAreNotIdempotent) {
+      EXPECT_FALSE(isIdempotent(Transfer{1, SetCanIdRequest{2}.getData()}));
+      EXPECT_FALSE(isIdempotent(Transfer{1, SetEncoderZeroRequest{0}.getData()}));
+      EXPECT_FALSE(isIdempotent(Transfer{1, SetCurrentPositionAsEncoderZeroRequest{}.getData()}));
+      EXPECT_FALSE(isIdempotent(Transfer{1, SetVelocityRequest{10.0f}.getData()}));
+      EXPECT_FALSE(isIdempotent(Transfer{1, MotionControlRequest{0.0f, 0.0f, 0.0f, 0.0f, 0.0f}.getData(),
+                                         CanAddressOffset::request_motion_control, CanAddressOffset::response_motion_control}));
+    }
+
+    TEST(TransferTest, staleRepliesAreRejected) {
+      Transfer const transfer {1, GetMotorStatus2Request{}.getData()};
+      EXPECT_TRUE(isReply(transfer, 0x241, {0x9C, 0x32}));
+      // Late reply to an earlier request of another command
+      EXPECT_FALSE(isReply(transfer, 0x241, {0x9A, 0x32}));
+      // Reply of another actuator
+      EXPECT_FALSE(isReply(transfer, 0x242, {0x9C, 0x32}));
+    }
+
+    TEST(TransferTest, singleGainRepliesEchoGainType) {
+      Transfer const transfer {1, GetSingleControllerGainRequest{GainType::SPEED_LOOP_KI}.getData()};
+      EXPECT_TRUE(isReply(transfer, 0x241, {0x30, 0x05}));
+      // Reply to reading another gain type that is pending at the same time
+      EXPECT_FALSE(isReply(transfer, 0x241, {0x30, 0x04}));
+      // Reading all gains at once leaves the gain type empty
+      Transfer const gains_transfer {1, GetControllerGainsRequest{}.getData()};
+      EXPECT_TRUE(isReply(gains_transfer, 0x241, {0x30, 0x00, 0x64}));
+    }
+
+    TEST(TransferTest, motionControlRepliesEchoActuatorId) {
+      Transfer const transfer {2, MotionControlRequest{0.0f, 0.0f, 0.0f, 0.0f, 0.0f}.getData(),
+                               CanAddressOffset::request_motion_control, CanAddressOffset::response_motion_control};
+      EXPECT_TRUE(isReply(transfer, 0x502, {0x02, 0xFF}));
+      EXPECT_FALSE(isReply(transfer, 0x502, {0x01, 0xFF}));
+      EXPECT_FALSE(isReply(transfer, 0x242, {0x02, 0xFF}));
+    }
+
+  }
+}
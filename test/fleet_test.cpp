@@ -0,0 +1,148 @@
+/**
+ * \file fleet_test.cpp
+ * \mainpage
+ *    Test discovering and configuring all actuators on a bus at once
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <system_error>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "myactuator_rmd/actuator_state/acceleration_type.hpp"
+#include "myactuator_rmd/actuator_state/gain_type.hpp"
+#include "myactuator_rmd/actuator_state/gains.hpp"
+#include "myactuator_rmd/can/exceptions.hpp"
+#include "myactuator_rmd/protocol/command_type.hpp"
+#include "myactuator_rmd/protocol/message.hpp"
+#include "myactuator_rmd/actuator_interface.hpp"
+#include "myactuator_rmd/fleet.hpp"
+#include "mock/simulated_driver.hpp"
+
+
+namespace myactuator_rmd {
+  namespace test {
+
+    /**\class FleetDriver
+     * \brief
+     *    Driver simulating a bus with a few actuators: Reads are answered with the actuator id as value,
+     *    writes are echoed and requests to absent actuators time out
+    */
+    class FleetDriver: public SimulatedDriver {
+      public:
+        FleetDriver(std::vector<std::uint32_t> const& actuator_ids)
+        : actuator_ids_{actuator_ids}, num_requests_{} {
+          return;
+        }
+
+        std::size_t getNumRequests(std::uint32_t const actuator_id) const {
+          auto const it {num_requests_.find(actuator_id)};
+          return (it != num_requests_.end()) ? it->second : 0;
+        }
+
+      protected:
+        std::array<std::uint8_t,8> respond(std::array<std::uint8_t,8> const& request, std::uint32_t const actuator_id) override {
+          ++num_requests_[actuator_id];
+          if (std::find(actuator_ids_.begin(), actuator_ids_.end(), actuator_id) == actuator_ids_.end()) {
+            throw can::TimeoutException(EAGAIN, std::generic_category(), "Actuator is absent");
+          }
+          auto response {request};
+          auto const id {static_cast<std::uint8_t>(actuator_id)};
+          switch (static_cast<CommandType>(response[0])) {
+            case CommandType::READ_SYSTEM_SOFTWARE_VERSION_DATE:
+            case CommandType::READ_ACCELERATION:
+              response[4] = id;
+              break;
+            case CommandType::READ_MOTOR_MODEL:
+              response = {response[0], 'X', '8', '-', '9', '0', ' ', ' '};
+              break;
+            case CommandType::READ_PID_PARAMETERS:
+              if (response[1] != 0) {
+                // Single gains are answered with the actuator id plus the gain type
+                float const value {static_cast<float>(id) + static_cast<float>(response[1])/10.0f};
+                std::memcpy(&response[4], &value, sizeof(float));
+              } else {
+                response[2] = id;
+              }
+              break;
+            default:
+              break;
+          }
+          return response;
+        }
+
+        std::vector<std::uint32_t> actuator_ids_;
+        std::map<std::uint32_t,std::size_t> num_requests_;
+    };
+
+    TEST(FleetTest, discoverActuators) {
+      FleetDriver driver {{5, 2}};
+      auto const inventory {myactuator_rmd::discoverActuators(driver)};
+      ASSERT_EQ(inventory.size(), 2);
+      EXPECT_EQ(inventory[0].actuator_id, 2);
+      EXPECT_EQ(inventory[0].version_date, 2);
+      EXPECT_EQ(inventory[0].motor_model, "X8-90  ");
+      EXPECT_EQ(inventory[0].gains.current.kp, 2);
+      EXPECT_EQ(inventory[0].acceleration, 2);
+      EXPECT_EQ(inventory[1].actuator_id, 5);
+      EXPECT_EQ(inventory[1].acceleration, 5);
+      // Absent actuators are probed only once
+      EXPECT_EQ(driver.getNumRequests(1), 1);
+      EXPECT_EQ(driver.getNumRequests(32), 1);
+      EXPECT_EQ(driver.getNumRequests(2), 4);
+    }
+
+    TEST(FleetTest, configureActuators) {
+      FleetDriver driver {{1, 2}};
+      myactuator_rmd::FleetConfiguration configuration {};
+      for (std::uint32_t id = 1; id <= 2; ++id) {
+        configuration.setControllerGains(id, Gains{}).setAcceleration(id, 1000, AccelerationType::POSITION_PLANNING_ACCELERATION)
+                     .setTimeout(id, std::chrono::milliseconds(100));
+      }
+      EXPECT_EQ(configuration.size(), 6);
+      EXPECT_NO_THROW(configuration.apply(driver));
+      EXPECT_EQ(driver.getNumRequests(1), 3);
+      configuration.setTimeout(3, std::chrono::milliseconds(100));
+      EXPECT_THROW(configuration.apply(driver), can::TimeoutException);
+    }
+
+    TEST(FleetTest, getAllGains) {
+      FleetDriver driver {{1, 2}};
+      myactuator_rmd::ActuatorInterface actuator {driver, 2};
+      auto const gains {actuator.getAllGains()};
+      ASSERT_EQ(gains.size(), gain_types.size());
+      EXPECT_FLOAT_EQ(gains.at(GainType::CURRENT_LOOP_KP), 2.1f);
+      EXPECT_FLOAT_EQ(gains.at(GainType::POSITION_LOOP_KD), 2.9f);
+      EXPECT_EQ(driver.getNumRequests(2), gain_types.size());
+      auto const fleet_gains {myactuator_rmd::getAllGains(driver, {1, 2})};
+      ASSERT_EQ(fleet_gains.size(), 2);
+      EXPECT_FLOAT_EQ(fleet_gains.at(1).at(GainType::SPEED_LOOP_KI), 1.5f);
+      EXPECT_FLOAT_EQ(fleet_gains.at(2).at(GainType::SPEED_LOOP_KI), 2.5f);
+      EXPECT_THROW(static_cast<void>(myactuator_rmd::getAllGains(driver, {3})), can::TimeoutException);
+    }
+
+    TEST(FleetTest, setAllGains) {
+      FleetDriver driver {{1, 2}};
+      std::map<GainType,float> const gains {{GainType::SPEED_LOOP_KP, 0.5f}, {GainType::SPEED_LOOP_KI, 0.01f}};
+      myactuator_rmd::ActuatorInterface actuator {driver, 1};
+      auto const echoed_gains {actuator.setAllGains(gains)};
+      EXPECT_EQ(echoed_gains, gains);
+      EXPECT_EQ(actuator.setAllGains(gains, true), gains);
+      myactuator_rmd::FleetConfiguration configuration {};
+      configuration.setAllGains(1, gains).setAllGains(2, gains, true);
+      EXPECT_EQ(configuration.size(), 4);
+      EXPECT_NO_THROW(configuration.apply(driver));
+      EXPECT_EQ(driver.getNumRequests(2), 2);
+    }
+
+  }
+}
@@ -0,0 +1,39 @@
+#include "driver_scripted_actuators_test.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "myactuator_rmd/driver/can_driver.hpp"
+#include "myactuator_rmd/driver/driver.hpp"
+#include "scripted_actuators.hpp"
+
+
+namespace myactuator_rmd {
+  namespace test {
+
+    DriverScriptedActuatorsTest::DriverScriptedActuatorsTest(std::string const& ifname)
+    : ifname_{ifname}, driver_{ifname}, actuators_{} {
+      return;
+    }
+
+    void DriverScriptedActuatorsTest::TearDown() {
+      if (actuators_) {
+        actuators_->stop();
+      }
+      return;
+    }
+
+    void DriverScriptedActuatorsTest::startActuators(std::vector<std::uint32_t> const& actuator_ids,
+                                                     ScriptedActuators::Script const& script) {
+      myactuator_rmd::Driver& driver {driver_};
+      for (auto const& actuator_id: actuator_ids) {
+        driver.addId(actuator_id);
+      }
+      actuators_ = std::make_unique<ScriptedActuators>(ifname_, actuator_ids, script);
+      return;
+    }
+
+  }
+}
@@ -0,0 +1,73 @@
+/**
+ * \file driver_scripted_actuators_test.hpp
+ * \mainpage
+ *    Contains a test fixture for testing batches of requests of the driver against scripted actuators
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#ifndef MYACTUATOR_RMD__TEST__DRIVER_SCRIPTED_ACTUATORS_TEST
+#define MYACTUATOR_RMD__TEST__DRIVER_SCRIPTED_ACTUATORS_TEST
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "myactuator_rmd/driver/can_driver.hpp"
+#include "scripted_actuators.hpp"
+
+
+namespace myactuator_rmd {
+  namespace test {
+
+    /**\class DriverScriptedActuatorsTest
+     * \brief
+     *    Test fixture for testing the driver against several scripted actuators through a (virtual) CAN
+     *    loopback interface
+    */
+    class DriverScriptedActuatorsTest: public ::testing::Test {
+      public:
+        /**\fn DriverScriptedActuatorsTest
+         * \brief
+         *    Class constructor
+         * 
+         * \param[in] ifname
+         *    The name of the (virtual) CAN network interface that should be used as a loopback device
+        */
+        DriverScriptedActuatorsTest(std::string const& ifname = "vcan_test");
+        DriverScriptedActuatorsTest(DriverScriptedActuatorsTest const&) = delete;
+        DriverScriptedActuatorsTest& operator = (DriverScriptedActuatorsTest const&) = delete;
+        DriverScriptedActuatorsTest(DriverScriptedActuatorsTest&&) = delete;
+        DriverScriptedActuatorsTest& operator = (DriverScriptedActuatorsTest&&) = delete;
+
+        /**\fn TearDown
+         * \brief
+         *    Stops the actuators started by the test
+        */
+        void TearDown() override;
+
+      protected:
+        /**\fn startActuators
+         * \brief
+         *    Start the scripted actuators and register them with the driver
+         * 
+         * \param[in] actuator_ids
+         *    The ids of the actuators
+         * \param[in] script
+         *    The script giving the replies of the actuators
+        */
+        void startActuators(std::vector<std::uint32_t> const& actuator_ids, ScriptedActuators::Script const& script);
+
+        std::string ifname_;
+        myactuator_rmd::CanDriver driver_;
+        std::unique_ptr<ScriptedActuators> actuators_;
+    };
+
+  }
+}
+
+#endif // MYACTUATOR_RMD__TEST__DRIVER_SCRIPTED_ACTUATORS_TEST
@@ -0,0 +1,69 @@
+#include "scripted_actuators.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "myactuator_rmd/can/exceptions.hpp"
+#include "myactuator_rmd/can/frame.hpp"
+#include "myactuator_rmd/driver/can_address_offset.hpp"
+
+
+namespace myactuator_rmd {
+  namespace test {
+
+    ScriptedActuators::ScriptedActuators(std::string const& ifname, std::vector<std::uint32_t> const& actuator_ids,
+                                         Script const& script)
+    : CanNode{ifname}, script_{script}, mutex_{}, requests_{}, is_running_{true}, thread_{} {
+      for (auto const& actuator_id: actuator_ids) {
+        this->addId(actuator_id);
+      }
+      // Checks regularly whether the actuators were stopped
+      setRecvTimeout(std::chrono::milliseconds(1));
+      thread_ = std::thread(&ScriptedActuators::run, this);
+      return;
+    }
+
+    ScriptedActuators::~ScriptedActuators() {
+      stop();
+      return;
+    }
+
+    void ScriptedActuators::stop() {
+      is_running_.store(false);
+      if (thread_.joinable()) {
+        thread_.join();
+      }
+      return;
+    }
+
+    std::vector<can::Frame> ScriptedActuators::getRequests() const {
+      std::lock_guard<std::mutex> const lock {mutex_};
+      return requests_;
+    }
+
+    void ScriptedActuators::run() {
+      while (is_running_.load()) {
+        try {
+          can::Frame const frame {read()};
+          {
+            std::lock_guard<std::mutex> const lock {mutex_};
+            requests_.push_back(frame);
+          }
+          std::uint32_t const actuator_id {frame.getId() - CanAddressOffset::request};
+          for (auto const& reply: script_(actuator_id, frame.getData())) {
+            write(CanAddressOffset::response + actuator_id, reply);
+          }
+        } catch (can::TimeoutException const&) {
+          continue;
+        }
+      }
+      return;
+    }
+
+  }
+}
@@ -0,0 +1,97 @@
+/**
+ * \file scripted_actuators.hpp
+ * \mainpage
+ *    Contains actuators that reply to requests over a (virtual) CAN network interface according to a script
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#ifndef MYACTUATOR_RMD__TEST__MOCK__SCRIPTED_ACTUATORS
+#define MYACTUATOR_RMD__TEST__MOCK__SCRIPTED_ACTUATORS
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "myactuator_rmd/can/frame.hpp"
+#include "myactuator_rmd/driver/can_address_offset.hpp"
+#include "myactuator_rmd/driver/can_node.hpp"
+
+
+namespace myactuator_rmd {
+  namespace test {
+
+    /**\class ScriptedActuators
+     * \brief
+     *    Counter-part to several actuators on a (virtual) CAN network interface that handles every request in a
+     *    thread of its own. The replies are given by a script, so that lost, late or unrelated replies can be
+     *    simulated. All requests are recorded in the order they arrived.
+    */
+    class ScriptedActuators: protected myactuator_rmd::CanNode<CanAddressOffset::response,CanAddressOffset::request> {
+      public:
+        /**\fn Script
+         * \brief
+         *    Replies to a request of the given actuator, no reply drops the request
+        */
+        using Script = std::function<std::vector<std::array<std::uint8_t,8>>(std::uint32_t const actuator_id,
+                                                                             std::array<std::uint8_t,8> const& request)>;
+
+        /**\fn ScriptedActuators
+         * \brief
+         *    Class constructor, starts handling requests
+         * 
+         * \param[in] ifname
+         *    The name of the (virtual) CAN network interface that should be used as a loopback device
+         * \param[in] actuator_ids
+         *    The ids of the simulated actuators
+         * \param[in] script
+         *    The script giving the replies to every request, only called by the thread of the actuators
+        */
+        ScriptedActuators(std::string const& ifname, std::vector<std::uint32_t> const& actuator_ids, Script const& script);
+        ScriptedActuators() = delete;
+        ScriptedActuators(ScriptedActuators const&) = delete;
+        ScriptedActuators& operator = (ScriptedActuators const&) = delete;
+        ScriptedActuators(ScriptedActuators&&) = delete;
+        ScriptedActuators& operator = (ScriptedActuators&&) = delete;
+        ~ScriptedActuators();
+
+        /**\fn stop
+         * \brief
+         *    Stop handling requests and join the thread of the actuators
+        */
+        void stop();
+
+        /**\fn getRequests
+         * \brief
+         *    Get all requests received so far
+         *
+         * \return
+         *    The received requests in the order they arrived
+        */
+        [[nodiscard]]
+        std::vector<can::Frame> getRequests() const;
+
+      protected:
+        /**\fn run
+         * \brief
+         *    Handle requests until the actuators are stopped
+        */
+        void run();
+
+        Script script_;
+        mutable std::mutex mutex_;
+        std::vector<can::Frame> requests_;
+        std::atomic<bool> is_running_;
+        std::thread thread_;
+    };
+
+  }
+}
+
+#endif // MYACTUATOR_RMD__TEST__MOCK__SCRIPTED_ACTUATORS
@@ -0,0 +1,80 @@
+/**
+ * \file simulated_driver.hpp
+ * \mainpage
+ *    Contains a base class for drivers that simulate actuators in memory instead of talking to a bus
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#ifndef MYACTUATOR_RMD__TEST__MOCK__SIMULATED_DRIVER
+#define MYACTUATOR_RMD__TEST__MOCK__SIMULATED_DRIVER
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "myactuator_rmd/driver/driver.hpp"
+#include "myactuator_rmd/protocol/message.hpp"
+
+
+namespace myactuator_rmd {
+  namespace test {
+
+    /**\class SimulatedDriver
+     * \brief
+     *    Driver that hands every request to a single hook instead of a bus, so that a test only has to implement
+     *    the behaviour of the simulated actuators. Requests that are only sent are handed to the hook as well and
+     *    their response is dropped, like a real actuator that replies to a frame nobody waits for.
+    */
+    class SimulatedDriver: public myactuator_rmd::Driver {
+      public:
+        SimulatedDriver() = default;
+        SimulatedDriver(SimulatedDriver const&) = default;
+        SimulatedDriver& operator = (SimulatedDriver const&) = default;
+        SimulatedDriver(SimulatedDriver&&) = default;
+        SimulatedDriver& operator = (SimulatedDriver&&) = default;
+
+        void addId(std::uint32_t const /*actuator_id*/) override {
+          return;
+        }
+
+        void send(Message const& msg, std::uint32_t const actuator_id) override {
+          static_cast<void>(respond(msg.getData(), actuator_id));
+          return;
+        }
+
+        void send(Message const& msg, std::uint32_t const actuator_id, std::uint32_t const /*base_offset*/) override {
+          static_cast<void>(respond(msg.getData(), actuator_id));
+          return;
+        }
+
+        std::array<std::uint8_t,8> sendRecv(Message const& request, std::uint32_t const actuator_id) override {
+          return respond(request.getData(), actuator_id);
+        }
+
+        std::array<std::uint8_t,8> sendRecv(Message const& request, std::uint32_t const actuator_id,
+                                            std::uint32_t const /*request_offset*/, std::uint32_t const /*response_offset*/) override {
+          return respond(request.getData(), actuator_id);
+        }
+
+        using Driver::sendRecv;
+
+      protected:
+        /**\fn respond
+         * \brief
+         *    Simulate the reaction of an actuator to a request
+         *
+         * \param[in] request
+         *    The data of the request
+         * \param[in] actuator_id
+         *    The id of the actuator the request is addressed to
+         * \return
+         *    The data of the response
+        */
+        virtual std::array<std::uint8_t,8> respond(std::array<std::uint8_t,8> const& request, std::uint32_t const actuator_id) = 0;
+    };
+
+  }
+}
+
+#endif // MYACTUATOR_RMD__TEST__MOCK__SIMULATED_DRIVER
@@ -0,0 +1,53 @@
+/**
+ * \file thread_affinity_test.cpp
+ * \mainpage
+ *    Tests for pinning threads to a core
+ * \author
+ *    Tobit Flatscher (github.com/2b-t)
+*/
+
+#include <thread>
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <gtest/gtest.h>
+
+#include "myactuator_rmd/thread_affinity.hpp"
+#include "myactuator_rmd/exceptions.hpp"
+
+
+namespace myactuator_rmd {
+  namespace test {
+
+    TEST(ThreadAffinityTest, pinToCore) {
+      // Runs in a separate thread so that the affinity of the test runner is left untouched
+      std::thread thread {[]() {
+        int const core {::sched_getcpu()};
+        ASSERT_GE(core, 0);
+        EXPECT_NO_THROW(myactuator_rmd::setThreadAffinity(static_cast<std::size_t>(core)));
+        ::cpu_set_t cpu_set {};
+        ASSERT_EQ(::pthread_getaffinity_np(::pthread_self(), sizeof(::cpu_set_t), &cpu_set), 0);
+        EXPECT_EQ(CPU_COUNT(&cpu_set), 1);
+        EXPECT_TRUE(CPU_ISSET(core, &cpu_set));
+      }};
+      thread.join();
+    }
+
+    TEST(ThreadAffinityTest, invalidCore) {
+      std::thread thread {[]() {
+        EXPECT_THROW(myactuator_rmd::setThreadAffinity(CPU_SETSIZE), myactuator_rmd::ValueRangeException);
+      }};
+      thread.join();
+    }
+
+    TEST(ThreadAffinityTest, invalidPriority) {
+      std::thread thread {[]() {
+        EXPECT_THROW(myactuator_rmd::setThreadPriority(0), myactuator_rmd::ValueRangeException);
+        EXPECT_THROW(myactuator_rmd::setThreadPriority(100), myactuator_rmd::ValueRangeException);
+      }};
+      thread.join();
+    }
+
+  }
+}